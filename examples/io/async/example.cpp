@@ -0,0 +1,86 @@
+/*!
+ * \file example.cpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Coroutine IO example (echo over serial ports, one thread)
+ *
+ * \author s3mat3
+ */
+
+#include <iostream>
+
+#include "io/async.hpp"
+#include "io/serial/port.hpp"
+
+ //  for test on linux by socat command
+ //  > socat -d -d pty,raw,echo=0,link=/tmp/vtty0 pty,raw,echo=0,link=/tmp/vtty1
+ //  /tmp/vtty0 for writer
+ //  /tmp/vtty1 for echo back
+
+namespace io = Sml::IO;
+namespace serial = io::Serial;
+
+static const Sml::count_type LOOP_MAX = 10;
+
+static io::IoTask receive(io::ChannelBase& ch, std::string& buf, Sml::size_type length)
+{
+    buf.clear();
+    std::string tmp(length, 0);
+    while (buf.size() < length) {
+        auto ret = co_await ch.async_read(tmp, 1000);
+        if (ret < 0) co_return ret;
+        buf.append(tmp.data(), static_cast<Sml::size_type>(ret));
+        tmp.resize(length - buf.size());
+    }
+    co_return static_cast<Sml::return_code>(buf.size());
+}
+
+static io::IoTask writer(io::ChannelBase& ch)
+{
+    std::string data("HELLO COROUTINE");
+    std::string back;
+    for (Sml::count_type lc = 0; lc < LOOP_MAX; ++lc) {
+        auto ret = co_await ch.async_write(data, 1000);
+        if (ret < 0) co_return ret;
+        ret = co_await receive(ch, back, data.size());
+        if (ret < 0) co_return ret;
+        std::cout << "writer received echo " << back << std::endl;
+    }
+    co_return io::IO_OK;
+}
+
+static io::IoTask echo(io::ChannelBase& ch, Sml::size_type length)
+{
+    std::string buf;
+    for (Sml::count_type lc = 0; lc < LOOP_MAX; ++lc) {
+        auto ret = co_await receive(ch, buf, length);
+        if (ret < 0) co_return ret;
+        ret = co_await ch.async_write(buf, 1000);
+        if (ret < 0) co_return ret;
+    }
+    co_return io::IO_OK;
+}
+
+int main()
+{
+    serial::Port w("/tmp/vtty0");
+    serial::Port r("/tmp/vtty1");
+    if (w.connect() != Sml::OK || r.connect() != Sml::OK) {
+        std::cerr << "can not open /tmp/vtty0 or /tmp/vtty1 (start socat)" << std::endl;
+        return 1;
+    }
+    io::IoScheduler sched;
+    w.scheduler(&sched);
+    r.scheduler(&sched);
+
+    auto e = echo(r, 15);
+    auto t = writer(w);
+    sched.run(); // both coroutines run on this thread, until all awaiters finished
+
+    std::cout << "writer " << t.result() << " echo " << e.result() << std::endl;
+    w.disconnect();
+    r.disconnect();
+    return 0;
+}
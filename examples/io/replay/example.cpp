@@ -0,0 +1,74 @@
+/*!
+ * \file example.cpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Capture replay tool (feeds capture file through ReplayChannel)
+ *
+ *  usage: replay-example [capture file [speed [channel]]]
+ *  - speed 1.0 is original timing, 10 is ten times faster, 0 is no wait (default 1.0)
+ *  - without capture file, writes demo capture into /tmp/replay-demo.cap and replays it
+ *
+ * \author s3mat3
+ */
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "io/replay.hpp"
+
+namespace io = Sml::IO;
+
+static auto demo(const std::string& path) -> Sml::return_code
+{
+    io::CaptureWriter w;
+    if (w.open(path) != io::IO_OK) return io::IO_FAILURE;
+    auto t = io::capture_clock();
+    for (int i = 0; i < 10; ++i, t += 50000000) { // every 50[ms]
+        w.append(0, io::direction::out, "\x02REQ" + std::to_string(i) + "\x03", t);
+        w.append(0, io::direction::in, "\x02RSP" + std::to_string(i) + "\x03", t + 5000000);
+    }
+    return io::IO_OK;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string path = (argc > 1) ? argv[1] : "/tmp/replay-demo.cap";
+    double speed = (argc > 2) ? std::stod(argv[2]) : 1.0;
+    int ch = (argc > 3) ? std::stoi(argv[3]) : io::ReplayChannel::all_channels;
+    if (argc <= 1 && demo(path) != io::IO_OK) {
+        std::cerr << "can not write " << path << std::endl;
+        return 1;
+    }
+    io::CaptureReader cap;
+    if (cap.open(path) != io::IO_OK) {
+        std::cerr << "can not open capture " << path << std::endl;
+        return 1;
+    }
+    std::cout << path << " : " << cap.records() << " records, speed " << speed << std::endl;
+
+    io::ReplayChannel port;
+    std::atomic<bool> finished {false};
+    std::jthread feeder([&](std::stop_token st) {
+        port.replay(cap, speed, st, ch);
+        finished = true;
+    });
+    // application side, same as reading serial port
+    io::ChannelBase::byte_buffer buff(256, '\0');
+    auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        auto ret = port.isReady(io::direction::in, feeder.get_stop_token(), 100);
+        if (ret == io::IO_TIMEOUT && finished) break;
+        if (ret != io::IO_OK) continue;
+        auto n = port.read(buff);
+        if (n <= 0) continue;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        auto b = Sml::from_string(std::string(buff.data(), static_cast<Sml::size_type>(n)));
+        std::cout << std::setw(6) << ms << "[ms] " << Sml::toReadableCtrlCode(b) << std::endl;
+    }
+    std::cout << "replay finished, " << port.fed() << " records fed" << std::endl;
+    return 0;
+}
@@ -14,6 +14,10 @@
 #ifndef BUFFER_Hpp
 # define  BUFFER_Hpp
 // # define SML_TRACE 1
+# include <algorithm>
+# include <cstring>
+# include <span>
+# include <type_traits>
 # include "result.hpp"
 # include "storage.hpp"
 
@@ -229,6 +233,77 @@ namespace Sml {
             m_read = newPos;
             return OK;
         }
+        /*! Number of contents not read yet .
+         */
+        auto unread() const noexcept -> size_type {return this->size() - m_read;}
+        /*! Contents not read yet [position(), size()) .
+         */
+        auto readable() const noexcept -> std::span<const value_type> {return {this->m_head + m_read, unread()};}
+        /*! Consume n contents from read position (stream parsing) .
+         *
+         * When all contents are consumed the buffer is rewound to head (no copy), otherwise
+         * compacted by compact_if_wasted().
+         *  \param[in] n number of consumed contents
+         *  \retval OK consumed
+         *  \retval OUT_OF_RANGE n is over unread()
+         */
+        auto consume(size_type n) noexcept -> return_code
+        {
+            if (n > unread()) return OUT_OF_RANGE;
+            m_read += n;
+            if (m_read == this->size()) {
+                clear();
+            } else {
+                compact_if_wasted();
+            }
+            return OK;
+        }
+        /*! Move unread contents to head now (discard already read prefix) .
+         *
+         * \note position() becomes 0, indexes held by caller are shifted by returned value.
+         *  \retval number of discarded contents
+         */
+        auto discard_read() noexcept -> size_type
+        {
+            auto wasted = m_read;
+            if (wasted == ZERO) return ZERO;
+            auto n = unread();
+            for (size_type i = ZERO; i < n; ++i) this->m_head[i] = std::move(this->m_head[wasted + i]);
+            this->m_tail = this->m_head + n;
+            m_read = ZERO;
+            return wasted;
+        }
+        /*! Compact when read prefix is wasted (amortized O(1) per content) .
+         *
+         * Unread contents are moved only when the prefix is over compact_threshold() and larger than
+         * the unread contents, so each content is moved at most once on average.
+         *  \retval true compacted
+         */
+        auto compact_if_wasted() noexcept -> bool
+        {
+            if (m_read < m_compact || m_read < unread()) return false;
+            discard_read();
+            return true;
+        }
+        auto compact_threshold() const noexcept -> size_type {return m_compact;}
+        auto compact_threshold(size_type n) noexcept -> void {m_compact = n;}
+        /*! Writable rooms after tail (e.g. for ::read(fd, span.data(), span.size())) .
+         *
+         * Read prefix is discarded or storage is grown to get at least min rooms,
+         * after writing call update_tail() with the written number.
+         *\code
+         * auto room = buffer.writable_tail(4096);
+         * auto ret = ::read(fd, room.data(), room.size());
+         * if (ret > 0) buffer.update_tail(ret);
+         *\endcode
+         *  \param[in] min requested rooms
+         */
+        auto writable_tail(size_type min = 1) noexcept -> std::span<value_type>
+        {
+            if (this->overflow(min) && m_read > ZERO) discard_read();
+            if (this->overflow(min)) this->resize(std::max(min, this->capacity()));
+            return {this->m_tail, static_cast<size_type>(this->m_end - this->m_tail)};
+        }
         /*! Update tail.
          */
         auto update_tail(size_type newPos)
@@ -264,8 +339,26 @@ namespace Sml {
             return dest;
         }
     private:
-        size_type m_read = ZERO; //!< index for read storage
+        size_type m_read    = ZERO;                        //!< index for read storage
+        size_type m_compact = request_volume(rooms::V4K);  //!< minimum wasted prefix for compaction
     }; //<-- class BufferBase ends here.
+    /*! Compare contents (memcmp when equal values have equal bytes) .
+     *
+     * \note Only [0, size()) is compared, read position and capacity are not.
+     * \note Types with padding or with several representations of one value (float, double) use operator== of T.
+     */
+    template <typename T>
+    inline auto operator==(const BufferBase<T>& lhs, const BufferBase<T>& rhs) noexcept -> bool
+    {
+        if (lhs.size() != rhs.size()) return false;
+        if (lhs.size() == ZERO) return true;
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            if (lhs.const_ptr() == rhs.const_ptr()) return true;
+            return std::memcmp(lhs.const_ptr(), rhs.const_ptr(), lhs.size() * sizeof(T)) == 0;
+        } else {
+            return std::equal(lhs.const_begin(), lhs.const_end(), rhs.const_begin());
+        }
+    }
     // template<>
     // class BufferBase<char>
     // {
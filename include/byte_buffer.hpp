@@ -15,6 +15,9 @@
 #ifndef SML_BUFFER_Hpp
 # define  SML_BUFFER_Hpp
 
+# include <cstring>
+# include <string_view>
+
 # include "buffer.hpp"
 
 namespace Sml {
@@ -25,27 +28,26 @@ namespace Sml {
     //using ByteBuffer = BufferBase<char>;
     /*! ByteBuffer to std::string .
      */
-    std::string to_string(const ByteBuffer& b)
+    inline std::string to_string(const ByteBuffer& b)
     {
         return std::string(b.const_ptr(), b.size());
     }
     /*! std::string to ByteBuffer .
      */
-    ByteBuffer from_string(const std::string& s)
+    inline ByteBuffer from_string(const std::string& s)
     {
         auto b = ByteBuffer(s.size());
         b.copy_from(s.data(), s.size());
         return b;
     }
 
-    inline auto operator==(const ByteBuffer& lhs, const std::string rhs) -> bool
-    {
-        return (to_string(lhs) == rhs);
-    }
-    inline auto operator==(const std::string& lhs, const ByteBuffer& rhs) -> bool
+    /*! Compare contents with string (no temporary string) .
+     */
+    inline auto operator==(const ByteBuffer& lhs, std::string_view rhs) noexcept -> bool
     {
-        return (to_string(rhs) == lhs);
+        return lhs.size() == rhs.size() && (rhs.empty() || std::memcmp(lhs.const_ptr(), rhs.data(), rhs.size()) == 0);
     }
+    inline auto operator==(std::string_view lhs, const ByteBuffer& rhs) noexcept -> bool {return rhs == lhs;}
     /*! ByteBuffer to string in hex dump  .
      */
     inline std::string hexDump(ByteBuffer& t)
@@ -0,0 +1,315 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file chain_buffer.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Chained (rope) buffer of shared ByteBuffer segments
+ *
+ * Frame is assembled from segments without copy of payload, each segment refers [offset, offset + length)
+ * of shared (reference counted) ByteBuffer block. Prepend / append of segment is O(1), split and trim only
+ * adjust offset and length of segments, so same block may be shared by many chains (e.g. fragmentation of
+ * one payload into many frames). Chunks are handed to ::writev by iovecs().
+ *
+ *\code
+ * Sml::ChainBuffer frame(std::move(payload)); // ByteBuffer moved, no copy
+ * frame.prepend(header);                      // small header copied into own segment
+ * frame.append(crc);
+ * channel.writev(frame);
+ * auto first = frame.split(mtu);              // first mtu bytes, frame keeps rest (shares blocks)
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_CHAIN_BUFFER_Hpp
+# define  SML_CHAIN_BUFFER_Hpp
+
+# include <algorithm>
+# include <deque>
+# include <memory>
+# include <span>
+# include <stdexcept>
+# include <string_view>
+# include <vector>
+# include <sys/uio.h>
+
+# include "byte_buffer.hpp"
+
+namespace Sml {
+    /*! Chained buffer (rope) .
+     */
+    class ChainBuffer
+    {
+    public:
+        using block_type = std::shared_ptr<const ByteBuffer>;
+        using chunk_type = std::string_view;
+        /*! Segment, part of shared block .
+         */
+        struct Segment
+        {
+            block_type m_block  {};  //!< shared block
+            size_type  m_offset {0}; //!< first byte in block
+            size_type  m_length {0}; //!< bytes in this segment
+
+            auto chunk() const noexcept -> chunk_type {return chunk_type(m_block->const_ptr() + m_offset, m_length);}
+        }; //<-- struct Segment ends here.
+        using segments_type = std::deque<Segment>;
+        /*! Iterator over contiguous chunks (std::string_view) .
+         */
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = chunk_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = chunk_type;
+
+            const_iterator() = default;
+            explicit const_iterator(segments_type::const_iterator it) : m_it(it) {}
+            auto operator*() const noexcept -> chunk_type {return m_it->chunk();}
+            auto operator++() noexcept -> const_iterator& {++m_it; return *this;}
+            auto operator++(int) noexcept -> const_iterator {auto t = *this; ++m_it; return t;}
+            auto operator==(const const_iterator& rhs) const noexcept -> bool {return m_it == rhs.m_it;}
+        private:
+            segments_type::const_iterator m_it {};
+        }; //<-- class const_iterator ends here.
+
+        ChainBuffer() = default;
+        /*! Construct by block (moved, no copy of contents) .
+         */
+        explicit ChainBuffer(ByteBuffer&& b) {append(std::move(b));}
+        explicit ChainBuffer(block_type b) {append(std::move(b));}
+
+        /*! Append whole block (moved, no copy) .
+         */
+        auto append(ByteBuffer&& b) -> ChainBuffer& {return append(make_block(std::move(b)));}
+        /*! Append whole shared block .
+         */
+        auto append(block_type b) -> ChainBuffer&
+        {
+            auto n = (b) ? b->size() : 0;
+            return append(std::move(b), 0, n);
+        }
+        /*! Append [offset, offset + length) of shared block .
+         */
+        auto append(block_type b, size_type offset, size_type length) -> ChainBuffer&
+        {
+            if (! b || length == 0) return *this;
+            m_size += length;
+            m_segments.push_back(Segment{std::move(b), offset, length});
+            return *this;
+        }
+        /*! Append segments of other chain (blocks are shared) .
+         */
+        auto append(const ChainBuffer& other) -> ChainBuffer&
+        {
+            m_segments.insert(m_segments.end(), other.m_segments.begin(), other.m_segments.end());
+            m_size += other.m_size;
+            return *this;
+        }
+        auto append(ChainBuffer&& other) -> ChainBuffer&
+        {
+            for (auto& s : other.m_segments) m_segments.push_back(std::move(s));
+            m_size += other.m_size;
+            other.clear();
+            return *this;
+        }
+        /*! Append copy of bytes as new segment (for small header, trailer) .
+         */
+        auto append(const char* p, size_type n) -> ChainBuffer& {return append(copy_block(p, n));}
+        auto append(std::string_view s) -> ChainBuffer& {return append(s.data(), s.size());}
+
+        /*! Prepend whole block (moved, no copy) .
+         */
+        auto prepend(ByteBuffer&& b) -> ChainBuffer& {return prepend(make_block(std::move(b)));}
+        auto prepend(block_type b) -> ChainBuffer&
+        {
+            auto n = (b) ? b->size() : 0;
+            return prepend(std::move(b), 0, n);
+        }
+        /*! Prepend [offset, offset + length) of shared block .
+         */
+        auto prepend(block_type b, size_type offset, size_type length) -> ChainBuffer&
+        {
+            if (! b || length == 0) return *this;
+            m_size += length;
+            m_segments.push_front(Segment{std::move(b), offset, length});
+            return *this;
+        }
+        auto prepend(const ChainBuffer& other) -> ChainBuffer&
+        {
+            m_segments.insert(m_segments.begin(), other.m_segments.begin(), other.m_segments.end());
+            m_size += other.m_size;
+            return *this;
+        }
+        /*! Prepend copy of bytes as new segment .
+         */
+        auto prepend(const char* p, size_type n) -> ChainBuffer& {return prepend(copy_block(p, n));}
+        auto prepend(std::string_view s) -> ChainBuffer& {return prepend(s.data(), s.size());}
+
+        /*! Remove n bytes from head (no copy) .
+         *  \retval removed bytes (less than n when chain is shorter)
+         */
+        auto trim_front(size_type n) noexcept -> size_type
+        {
+            size_type removed = 0;
+            while (n > 0 && ! m_segments.empty()) {
+                auto& s = m_segments.front();
+                if (s.m_length <= n) {
+                    n -= s.m_length;
+                    removed += s.m_length;
+                    m_segments.pop_front();
+                } else {
+                    s.m_offset += n;
+                    s.m_length -= n;
+                    removed += n;
+                    n = 0;
+                }
+            }
+            m_size -= removed;
+            return removed;
+        }
+        /*! Remove n bytes from tail (no copy) .
+         *  \retval removed bytes (less than n when chain is shorter)
+         */
+        auto trim_back(size_type n) noexcept -> size_type
+        {
+            size_type removed = 0;
+            while (n > 0 && ! m_segments.empty()) {
+                auto& s = m_segments.back();
+                if (s.m_length <= n) {
+                    n -= s.m_length;
+                    removed += s.m_length;
+                    m_segments.pop_back();
+                } else {
+                    s.m_length -= n;
+                    removed += n;
+                    n = 0;
+                }
+            }
+            m_size -= removed;
+            return removed;
+        }
+        /*! Split off first n bytes (no copy) .
+         *
+         * Segment across the boundary is shared by both chains.
+         *  \retval chain of first n bytes (whole chain when n >= size()), this keeps the rest
+         */
+        auto split(size_type n) -> ChainBuffer
+        {
+            ChainBuffer head;
+            while (n > 0 && ! m_segments.empty()) {
+                auto& s = m_segments.front();
+                if (s.m_length <= n) {
+                    n -= s.m_length;
+                    head.append(std::move(s.m_block), s.m_offset, s.m_length);
+                    m_size -= s.m_length;
+                    m_segments.pop_front();
+                } else {
+                    head.append(s.m_block, s.m_offset, n);
+                    s.m_offset += n;
+                    s.m_length -= n;
+                    m_size -= n;
+                    n = 0;
+                }
+            }
+            return head;
+        }
+        /*! Export chunks for ::writev .
+         *
+         *  \param[out] out iovec array
+         *  \retval number of filled iovec (less than segments() when out is shorter)
+         */
+        auto fill_iovec(std::span<::iovec> out) const noexcept -> size_type
+        {
+            size_type i = 0;
+            for (auto it = m_segments.begin(); it != m_segments.end() && i < out.size(); ++it, ++i) {
+                out[i].iov_base = const_cast<char*>(it->m_block->const_ptr() + it->m_offset);
+                out[i].iov_len  = it->m_length;
+            }
+            return i;
+        }
+        auto iovecs() const -> std::vector<::iovec>
+        {
+            std::vector<::iovec> v(m_segments.size());
+            fill_iovec(v);
+            return v;
+        }
+        /*! Copy bytes [first, first + n) into dest .
+         *  \retval copied bytes
+         */
+        auto copy_to(char* dest, size_type first, size_type n) const noexcept -> size_type
+        {
+            size_type copied = 0;
+            for (auto c : *this) {
+                if (n == 0) break;
+                if (first >= c.size()) {
+                    first -= c.size();
+                    continue;
+                }
+                auto k = std::min(c.size() - first, n);
+                std::copy_n(c.data() + first, k, dest + copied);
+                copied += k;
+                n -= k;
+                first = 0;
+            }
+            return copied;
+        }
+        /*! Flatten into one contiguous buffer (copy) .
+         */
+        auto coalesce() const -> ByteBuffer
+        {
+            ByteBuffer b(std::max<size_type>(m_size, 1));
+            for (auto c : *this) b.append(c.data(), c.size());
+            return b;
+        }
+        /*! Byte at position (walks segments) .
+         */
+        auto at(size_type pos) const -> char
+        {
+            for (const auto& s : m_segments) {
+                if (pos < s.m_length) return s.m_block->const_ptr()[s.m_offset + pos];
+                pos -= s.m_length;
+            }
+            throw std::out_of_range("Index position is over size");
+        }
+        auto clear() noexcept -> void
+        {
+            m_segments.clear();
+            m_size = 0;
+        }
+        auto size() const noexcept -> size_type {return m_size;}
+        auto empty() const noexcept -> bool {return m_size == 0;}
+        /*! Number of segments (chunks) .
+         */
+        auto segments() const noexcept -> size_type {return m_segments.size();}
+        auto segment(size_type i) const noexcept -> const Segment& {return m_segments[i];}
+        auto begin() const noexcept -> const_iterator {return const_iterator(m_segments.begin());}
+        auto end() const noexcept -> const_iterator {return const_iterator(m_segments.end());}
+
+        /*! Make shared block from buffer (moved) .
+         */
+        static auto make_block(ByteBuffer&& b) -> block_type {return std::make_shared<const ByteBuffer>(std::move(b));}
+        /*! Make shared block by copy of bytes .
+         */
+        static auto copy_block(const char* p, size_type n) -> block_type
+        {
+            ByteBuffer b(std::max<size_type>(n, 1));
+            b.append(p, n);
+            return make_block(std::move(b));
+        }
+    private:
+        segments_type m_segments {};  //!< chunks in order
+        size_type     m_size     {0}; //!< total bytes
+    }; //<-- class ChainBuffer ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_CHAIN_BUFFER_Hpp ends here.
+/** @} */
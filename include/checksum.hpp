@@ -0,0 +1,406 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file checksum.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Checksum of frames (CRC-16 Modbus / CCITT, CRC-32, CRC-32C, LRC, XOR sum)
+ *
+ * CRC is computed by slicing-by-8 tables (generated at compile time), and on x86 selected at
+ * run time (once) by cpu feature,
+ * - CRC-32 by PCLMULQDQ folding (64 bytes per iteration) for long data
+ * - CRC-32C by SSE4.2 crc32 instruction
+ *
+ * All of them are incremental, update() can be called for each piece of streaming frame
+ * and value() returns the checksum of all pieces so far.
+ *
+ *\code
+ * Sml::Crc16Modbus crc;
+ * crc.update(head).update(body);
+ * if (crc.value() != received) return Sml::IO::IO_SUM_ERROR;
+ * auto c = Sml::Crc32::compute(buffer); // ByteBuffer, std::string, std::span ...
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_CHECKSUM_Hpp
+# define  SML_CHECKSUM_Hpp
+
+# include <array>
+# include <cstdint>
+# include <cstring>
+# include <iterator>
+# include <span>
+# include <string_view>
+
+# include "buffer.hpp"
+# include "sml.hpp"
+
+# if defined(__x86_64__) && ! defined(SML_CHECKSUM_PORTABLE)
+#  define SML_CHECKSUM_X86 1
+#  include <immintrin.h>
+# endif
+
+namespace Sml {
+    namespace Checksum {
+        /*! Hardware acceleration usable for CRC parameter .
+         */
+        enum class Accel : std::uint8_t {
+            none,         //!< slicing-by-8 only
+            crc32_pclmul, //!< CRC-32 (0x04C11DB7 reflected) by carry less multiply folding
+            crc32c_sse42, //!< CRC-32C (0x1EDC6F41 reflected) by crc32 instruction
+        };
+
+        /*! CRC parameter (Rocksoft model) .
+         *
+         *  \tparam T register type
+         *  \tparam Width bits of CRC (16 or 32)
+         *  \tparam Poly polynomial in normal (not reflected) form
+         *  \tparam Init initial register
+         *  \tparam Reflect reflected input and output (LSB first)
+         *  \tparam XorOut final xor
+         *  \tparam A hardware path
+         */
+        template <typename T, unsigned Width, T Poly, T Init, bool Reflect, T XorOut, Accel A = Accel::none>
+        struct CrcSpec
+        {
+            using value_type = T;
+            static constexpr unsigned   width   = Width;
+            static constexpr value_type poly    = Poly;
+            static constexpr value_type init    = Init;
+            static constexpr bool       reflect = Reflect;
+            static constexpr value_type xorout  = XorOut;
+            static constexpr Accel      accel   = A;
+        }; //<-- struct CrcSpec ends here.
+
+        using Crc16ModbusSpec = CrcSpec<std::uint16_t, 16, 0x8005, 0xffff, true, 0x0000>;
+        using Crc16CcittSpec  = CrcSpec<std::uint16_t, 16, 0x1021, 0xffff, false, 0x0000>; //!< CCITT-FALSE
+        using Crc32Spec       = CrcSpec<std::uint32_t, 32, 0x04c11db7, 0xffffffff, true, 0xffffffff, Accel::crc32_pclmul>;
+        using Crc32cSpec      = CrcSpec<std::uint32_t, 32, 0x1edc6f41, 0xffffffff, true, 0xffffffff, Accel::crc32c_sse42>;
+
+        /*! Slicing-by-8 tables of CRC parameter .
+         *
+         * table[k][x] is CRC register of byte x followed by k zero bytes.
+         */
+        template <typename Spec>
+        struct Tables
+        {
+            using value_type = typename Spec::value_type;
+            using table_type = std::array<std::array<value_type, 256>, 8>;
+            static constexpr value_type mask = static_cast<value_type>(~value_type{0} >> (sizeof(value_type) * 8 - Spec::width));
+
+            static constexpr auto reflect_bits(value_type v) noexcept -> value_type
+            {
+                value_type r = 0;
+                for (unsigned i = 0; i < Spec::width; ++i) {
+                    if (v & (value_type{1} << i)) r |= value_type{1} << (Spec::width - 1 - i);
+                }
+                return r;
+            }
+            static constexpr auto make() noexcept -> table_type
+            {
+                table_type t {};
+                for (unsigned x = 0; x < 256; ++x) {
+                    value_type c = 0;
+                    if constexpr (Spec::reflect) {
+                        c = static_cast<value_type>(x);
+                        for (int b = 0; b < 8; ++b) c = (c & 1) ? static_cast<value_type>((c >> 1) ^ reflect_bits(Spec::poly)) : static_cast<value_type>(c >> 1);
+                    } else {
+                        constexpr value_type top = value_type{1} << (Spec::width - 1);
+                        c = static_cast<value_type>(x << (Spec::width - 8));
+                        for (int b = 0; b < 8; ++b) c = static_cast<value_type>(((c & top) ? (c << 1) ^ Spec::poly : c << 1) & mask);
+                    }
+                    t[0][x] = c;
+                }
+                for (unsigned k = 1; k < 8; ++k) {
+                    for (unsigned x = 0; x < 256; ++x) {
+                        auto p = t[k - 1][x];
+                        if constexpr (Spec::reflect) t[k][x] = static_cast<value_type>((p >> 8) ^ t[0][p & 0xff]);
+                        else t[k][x] = static_cast<value_type>(((p << 8) & mask) ^ t[0][(p >> (Spec::width - 8)) & 0xff]);
+                    }
+                }
+                return t;
+            }
+            static constexpr table_type table = make();
+        }; //<-- struct Tables ends here.
+
+        /*! Update CRC register by slicing-by-8 (portable) .
+         */
+        template <typename Spec>
+        auto update_table(typename Spec::value_type crc, const std::uint8_t* p, size_type n) noexcept -> typename Spec::value_type
+        {
+            using value_type = typename Spec::value_type;
+            constexpr auto& t = Tables<Spec>::table;
+            constexpr unsigned bytes = Spec::width / 8;
+            for (; n >= 8; p += 8, n -= 8) {
+                std::uint8_t b[8];
+                std::memcpy(b, p, 8);
+                for (unsigned i = 0; i < bytes; ++i) {
+                    if constexpr (Spec::reflect) b[i] ^= static_cast<std::uint8_t>(crc >> (8 * i));
+                    else b[i] ^= static_cast<std::uint8_t>(crc >> (Spec::width - 8 * (i + 1)));
+                }
+                crc = static_cast<value_type>(t[7][b[0]] ^ t[6][b[1]] ^ t[5][b[2]] ^ t[4][b[3]]
+                                            ^ t[3][b[4]] ^ t[2][b[5]] ^ t[1][b[6]] ^ t[0][b[7]]);
+            }
+            for (; n; ++p, --n) {
+                if constexpr (Spec::reflect) crc = static_cast<value_type>((crc >> 8) ^ t[0][(crc ^ *p) & 0xff]);
+                else crc = static_cast<value_type>(((crc << 8) & Tables<Spec>::mask) ^ t[0][((crc >> (Spec::width - 8)) ^ *p) & 0xff]);
+            }
+            return crc;
+        }
+        /*! Update CRC register byte by byte (bit loop, reference for test and bench) .
+         */
+        template <typename Spec>
+        constexpr auto update_bitwise(typename Spec::value_type crc, const std::uint8_t* p, size_type n) noexcept -> typename Spec::value_type
+        {
+            using value_type = typename Spec::value_type;
+            for (; n; ++p, --n) {
+                if constexpr (Spec::reflect) {
+                    crc = static_cast<value_type>(crc ^ *p);
+                    for (int b = 0; b < 8; ++b) crc = (crc & 1) ? static_cast<value_type>((crc >> 1) ^ Tables<Spec>::reflect_bits(Spec::poly)) : static_cast<value_type>(crc >> 1);
+                } else {
+                    constexpr value_type top = value_type{1} << (Spec::width - 1);
+                    crc = static_cast<value_type>(crc ^ (value_type{*p} << (Spec::width - 8)));
+                    for (int b = 0; b < 8; ++b) crc = static_cast<value_type>(((crc & top) ? (crc << 1) ^ Spec::poly : crc << 1) & Tables<Spec>::mask);
+                }
+            }
+            return crc;
+        }
+
+# if defined(SML_CHECKSUM_X86)
+        /*! CRC-32C by SSE4.2 crc32 instruction .
+         */
+        __attribute__((target("sse4.2")))
+        inline auto update_crc32c_sse42(std::uint32_t crc, const std::uint8_t* p, size_type n) noexcept -> std::uint32_t
+        {
+            std::uint64_t c = crc;
+            for (; n >= 8; p += 8, n -= 8) {
+                std::uint64_t v;
+                std::memcpy(&v, p, 8);
+                c = _mm_crc32_u64(c, v);
+            }
+            auto r = static_cast<std::uint32_t>(c);
+            for (; n; ++p, --n) r = _mm_crc32_u8(r, *p);
+            return r;
+        }
+        /// x * (k.hi, k.lo) folded into next
+        __attribute__((target("sse4.1,pclmul")))
+        inline auto fold_lane(__m128i x, __m128i k, __m128i next) noexcept -> __m128i
+        {
+            return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+        }
+        /*! CRC-32 by PCLMULQDQ folding (n >= 64, multiple of 16, rest by caller) .
+         *
+         * Folds four 128 bits lanes by x^512 then into one lane, Barrett reduction to 32 bits
+         * (Intel "Fast CRC Computation Using PCLMULQDQ Instruction", same constants as zlib).
+         */
+        __attribute__((target("sse4.1,pclmul")))
+        inline auto fold_crc32_pclmul(std::uint32_t crc, const std::uint8_t* p, size_type n) noexcept -> std::uint32_t
+        {
+            alignas(16) static constexpr std::uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+            alignas(16) static constexpr std::uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+            alignas(16) static constexpr std::uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+            alignas(16) static constexpr std::uint64_t poly[] = {0x01db710641, 0x01f7011641};
+            auto load = [](const std::uint8_t* q) {return _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));};
+            auto x1 = _mm_xor_si128(load(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+            auto x2 = load(p + 16);
+            auto x3 = load(p + 32);
+            auto x4 = load(p + 48);
+            p += 64;
+            n -= 64;
+            auto k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+            for (; n >= 64; p += 64, n -= 64) {
+                x1 = fold_lane(x1, k, load(p));
+                x2 = fold_lane(x2, k, load(p + 16));
+                x3 = fold_lane(x3, k, load(p + 32));
+                x4 = fold_lane(x4, k, load(p + 48));
+            }
+            k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+            x1 = fold_lane(x1, k, x2);
+            x1 = fold_lane(x1, k, x3);
+            x1 = fold_lane(x1, k, x4);
+            for (; n >= 16; p += 16, n -= 16) x1 = fold_lane(x1, k, load(p));
+            // 128 bits to 64 bits
+            auto mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+            x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+            x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+            k  = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+            x2 = _mm_srli_si128(x1, 4);
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00), x2);
+            // Barrett reduction to 32 bits
+            k  = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+            x2 = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10), mask32);
+            x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+            x1 = _mm_xor_si128(x1, x2);
+            return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+        }
+        inline auto update_crc32_pclmul(std::uint32_t crc, const std::uint8_t* p, size_type n) noexcept -> std::uint32_t
+        {
+            if (n >= 64) {
+                auto folded = n & ~size_type{15};
+                crc = fold_crc32_pclmul(crc, p, folded);
+                p += folded;
+                n -= folded;
+            }
+            return update_table<Crc32Spec>(crc, p, n);
+        }
+# endif
+        /*! Implementation selected at run time .
+         */
+        template <typename Spec>
+        struct Dispatch
+        {
+            using value_type = typename Spec::value_type;
+            using function   = value_type (*)(value_type, const std::uint8_t*, size_type) noexcept;
+
+            static auto select() noexcept -> function
+            {
+# if defined(SML_CHECKSUM_X86)
+                if constexpr (Spec::accel == Accel::crc32_pclmul) {
+                    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) return &update_crc32_pclmul;
+                } else if constexpr (Spec::accel == Accel::crc32c_sse42) {
+                    if (__builtin_cpu_supports("sse4.2")) return &update_crc32c_sse42;
+                }
+# endif
+                return &update_table<Spec>;
+            }
+            /*! Selected implementation .
+             *
+             *  Function local static, usable from static initializers of other translation units .
+             */
+            static auto fn() noexcept -> function
+            {
+# if defined(SML_CHECKSUM_X86)
+                static const function f = (__builtin_cpu_init(), select());
+# else
+                static const function f = select();
+# endif
+                return f;
+            }
+            static auto accelerated() noexcept -> bool {return fn() != &update_table<Spec>;}
+        }; //<-- struct Dispatch ends here.
+    } //<-- namespace Checksum ends here.
+
+    /*! Contiguous bytes (std::string, std::string_view, std::span, std::vector ...) .
+     */
+    template <typename R>
+    concept byte_range = requires(const R& r) {
+        std::data(r);
+        std::size(r);
+    } && sizeof(*std::data(std::declval<const R&>())) == 1;
+
+    /*! Incremental CRC .
+     *
+     *  \tparam Spec Checksum::CrcSpec
+     */
+    template <typename Spec>
+    class Crc
+    {
+    public:
+        using spec_type  = Spec;
+        using value_type = typename Spec::value_type;
+
+        constexpr Crc() noexcept = default;
+        /*! Add bytes .
+         */
+        auto update(const void* p, size_type n) noexcept -> Crc&
+        {
+            m_register = Checksum::Dispatch<Spec>::fn()(m_register, static_cast<const std::uint8_t*>(p), n);
+            return *this;
+        }
+        template <byte_range R>
+        auto update(const R& r) noexcept -> Crc& {return update(std::data(r), std::size(r));}
+        auto update(const BufferBase<char>& b) noexcept -> Crc& {return update(b.const_ptr(), b.size());}
+        /*! Checksum of all bytes added .
+         */
+        constexpr auto value() const noexcept -> value_type {return static_cast<value_type>(m_register ^ Spec::xorout);}
+        constexpr auto reset() noexcept -> void {m_register = Spec::init;}
+        /*! One shot .
+         */
+        static auto compute(const void* p, size_type n) noexcept -> value_type {return Crc().update(p, n).value();}
+        template <typename R>
+        static auto compute(const R& r) noexcept -> value_type {return Crc().update(r).value();}
+        /*! Hardware path is used on this cpu .
+         */
+        static auto accelerated() noexcept -> bool {return Checksum::Dispatch<Spec>::accelerated();}
+    private:
+        value_type m_register {Spec::init}; //!< CRC register (before final xor)
+    }; //<-- class Crc ends here.
+
+    using Crc16Modbus = Crc<Checksum::Crc16ModbusSpec>; //!< Modbus RTU (low byte first on wire)
+    using Crc16Ccitt  = Crc<Checksum::Crc16CcittSpec>;  //!< CRC-16/CCITT-FALSE
+    using Crc32       = Crc<Checksum::Crc32Spec>;       //!< CRC-32 (ISO-HDLC, zlib, Ethernet)
+    using Crc32c      = Crc<Checksum::Crc32cSpec>;      //!< CRC-32C (Castagnoli, iSCSI)
+
+    /*! Incremental LRC (two's complement of byte sum, e.g. Modbus ASCII) .
+     */
+    class Lrc
+    {
+    public:
+        using value_type = std::uint8_t;
+
+        auto update(const void* vp, size_type n) noexcept -> Lrc&
+        {
+            auto p = static_cast<const std::uint8_t*>(vp);
+            std::uint8_t s = m_sum;
+            for (size_type i = 0; i < n; ++i) s = static_cast<std::uint8_t>(s + p[i]); // vectorized by compiler
+            m_sum = s;
+            return *this;
+        }
+        template <byte_range R>
+        auto update(const R& r) noexcept -> Lrc& {return update(std::data(r), std::size(r));}
+        auto update(const BufferBase<char>& b) noexcept -> Lrc& {return update(b.const_ptr(), b.size());}
+        constexpr auto value() const noexcept -> value_type {return static_cast<value_type>(-m_sum);}
+        constexpr auto reset() noexcept -> void {m_sum = 0;}
+        static auto compute(const void* p, size_type n) noexcept -> value_type {return Lrc().update(p, n).value();}
+        template <typename R>
+        static auto compute(const R& r) noexcept -> value_type {return Lrc().update(r).value();}
+    private:
+        std::uint8_t m_sum {0}; //!< byte sum
+    }; //<-- class Lrc ends here.
+
+    /*! Incremental XOR sum (BCC) .
+     */
+    class XorSum
+    {
+    public:
+        using value_type = std::uint8_t;
+
+        auto update(const void* vp, size_type n) noexcept -> XorSum&
+        {
+            auto p = static_cast<const std::uint8_t*>(vp);
+            std::uint64_t w = 0;
+            for (; n >= 8; p += 8, n -= 8) {
+                std::uint64_t v;
+                std::memcpy(&v, p, 8);
+                w ^= v;
+            }
+            w ^= w >> 32;
+            w ^= w >> 16;
+            w ^= w >> 8;
+            auto x = static_cast<std::uint8_t>(m_sum ^ w);
+            for (; n; ++p, --n) x ^= *p;
+            m_sum = x;
+            return *this;
+        }
+        template <byte_range R>
+        auto update(const R& r) noexcept -> XorSum& {return update(std::data(r), std::size(r));}
+        auto update(const BufferBase<char>& b) noexcept -> XorSum& {return update(b.const_ptr(), b.size());}
+        constexpr auto value() const noexcept -> value_type {return m_sum;}
+        constexpr auto reset() noexcept -> void {m_sum = 0;}
+        static auto compute(const void* p, size_type n) noexcept -> value_type {return XorSum().update(p, n).value();}
+        template <typename R>
+        static auto compute(const R& r) noexcept -> value_type {return XorSum().update(r).value();}
+    private:
+        std::uint8_t m_sum {0}; //!< xor of bytes
+    }; //<-- class XorSum ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_CHECKSUM_Hpp ends here.
+/** @} */
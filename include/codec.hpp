@@ -0,0 +1,357 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file codec.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Endian aware binary codec over ByteBuffer (fixed width integers, floats, LEB128 varint)
+ *
+ * Writer stores directly into the tail rooms of BufferBase<char>, Reader loads from the unread
+ * contents. Both have checked (write / read) and unchecked (put / get) operations, reserve()
+ * or require() once per message then use the unchecked ones.
+ *
+ *\code
+ * Sml::ByteBuffer frame(256);
+ * {
+ *     Sml::Writer w(frame);
+ *     w.reserve(7).put<std::endian::big>(std::uint8_t{0x10}).put(std::uint16_t{id}).put(std::uint32_t{seq});
+ *     w.write_varint(length);
+ * } // committed into frame
+ * Sml::Reader r(frame);
+ * if (! r.require(7)) return Sml::OUT_OF_RANGE;
+ * auto kind = r.get<std::uint8_t>();
+ * using Header = Sml::Schema<std::endian::little, std::uint8_t, std::uint16_t, std::uint32_t>;
+ * static_assert(Header::size == 7 && Header::offset<2>() == 3);
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_CODEC_Hpp
+# define  SML_CODEC_Hpp
+
+# include <bit>
+# include <concepts>
+# include <cstdint>
+# include <cstring>
+# include <span>
+# include <string_view>
+# include <tuple>
+# include <type_traits>
+
+# include "buffer.hpp"
+# include "debug.hpp"
+
+namespace Sml {
+    /*! Reverse byte order (std::byteswap of C++23) .
+     */
+    template <std::unsigned_integral T>
+    constexpr auto byteswap(T v) noexcept -> T
+    {
+        if constexpr (sizeof(T) == 1) {
+            return v;
+        } else if constexpr (sizeof(T) == 2) {
+            return __builtin_bswap16(v);
+        } else if constexpr (sizeof(T) == 4) {
+            return __builtin_bswap32(v);
+        } else {
+            static_assert(sizeof(T) == 8, "unsupported width");
+            return __builtin_bswap64(v);
+        }
+    }
+    /*! Value type for codec (integer, floating point, enum, bool) .
+     */
+    template <typename T>
+    concept codec_value = (std::is_arithmetic_v<T> || std::is_enum_v<T>) && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    namespace Codec {
+        template <size_type N> struct bits;
+        template <> struct bits<1> {using type = std::uint8_t;};
+        template <> struct bits<2> {using type = std::uint16_t;};
+        template <> struct bits<4> {using type = std::uint32_t;};
+        template <> struct bits<8> {using type = std::uint64_t;};
+        template <typename T>
+        using bits_t = typename bits<sizeof(T)>::type;
+
+        static constexpr size_type max_varint = 10; //!< LEB128 bytes of 64 bits
+
+        template <std::endian E, codec_value T>
+        inline auto store(char* p, T v) noexcept -> void
+        {
+            auto u = std::bit_cast<bits_t<T>>(v);
+            if constexpr (E != std::endian::native) u = byteswap(u);
+            std::memcpy(p, &u, sizeof(u));
+        }
+        template <std::endian E, codec_value T>
+        inline auto load(const char* p) noexcept -> T
+        {
+            bits_t<T> u;
+            std::memcpy(&u, p, sizeof(u));
+            if constexpr (E != std::endian::native) u = byteswap(u);
+            return std::bit_cast<T>(u);
+        }
+        /// bytes of LEB128
+        constexpr auto varint_size(std::uint64_t v) noexcept -> size_type
+        {
+            return (static_cast<size_type>(std::bit_width(v | 1)) + 6) / 7;
+        }
+        constexpr auto zigzag(std::int64_t v) noexcept -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+        }
+        constexpr auto unzigzag(std::uint64_t v) noexcept -> std::int64_t
+        {
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+    } //<-- namespace Codec ends here.
+
+    /*! Binary writer into tail of buffer .
+     *
+     * Written bytes are committed into the buffer (tail is moved) by commit() or destructor.
+     */
+    class Writer
+    {
+    public:
+        explicit Writer(BufferBase<char>& b, size_type hint = 0) noexcept : m_buffer(b)
+        {
+            grow(hint);
+        }
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+        ~Writer() {commit();}
+        /*! Make rooms for n bytes (the one bounds check for following put) .
+         */
+        auto reserve(size_type n) noexcept -> Writer&
+        {
+            if (room() < n) grow(n);
+            return *this;
+        }
+        /*! Store value without bounds check (after reserve()) .
+         */
+        template <std::endian E = std::endian::big, codec_value T>
+        auto put(T v) noexcept -> Writer&
+        {
+            SML_ASSERT(room() >= sizeof(T), "Writer::put over reserved rooms", true);
+            Codec::store<E>(m_pos, v);
+            m_pos += sizeof(T);
+            return *this;
+        }
+        /*! Store value with bounds check (grows buffer) .
+         */
+        template <std::endian E = std::endian::big, codec_value T>
+        auto write(T v) noexcept -> Writer& {return reserve(sizeof(T)).put<E>(v);}
+        auto put_bytes(const void* p, size_type n) noexcept -> Writer&
+        {
+            SML_ASSERT(room() >= n, "Writer::put_bytes over reserved rooms", true);
+            std::memcpy(m_pos, p, n);
+            m_pos += n;
+            return *this;
+        }
+        auto write_bytes(const void* p, size_type n) noexcept -> Writer& {return reserve(n).put_bytes(p, n);}
+        auto write_bytes(std::string_view s) noexcept -> Writer& {return write_bytes(s.data(), s.size());}
+        /*! Store unsigned LEB128 without bounds check (1 to 10 bytes) .
+         */
+        auto put_varint(std::uint64_t v) noexcept -> Writer&
+        {
+            SML_ASSERT(room() >= Codec::varint_size(v), "Writer::put_varint over reserved rooms", true);
+            while (v >= 0x80) {
+                *m_pos++ = static_cast<char>(v | 0x80);
+                v >>= 7;
+            }
+            *m_pos++ = static_cast<char>(v);
+            return *this;
+        }
+        auto write_varint(std::uint64_t v) noexcept -> Writer& {return reserve(Codec::varint_size(v)).put_varint(v);}
+        /*! Store signed LEB128 (zigzag) .
+         */
+        auto put_zigzag(std::int64_t v) noexcept -> Writer& {return put_varint(Codec::zigzag(v));}
+        auto write_zigzag(std::int64_t v) noexcept -> Writer& {return write_varint(Codec::zigzag(v));}
+        /*! Move tail of buffer to written position .
+         */
+        auto commit() noexcept -> void
+        {
+            auto n = static_cast<size_type>(m_pos - m_base);
+            m_buffer.update_tail(n);
+            m_written += n;
+            m_base = m_pos;
+        }
+        /*! Number of bytes written by this writer .
+         */
+        auto written() const noexcept -> size_type {return m_written + static_cast<size_type>(m_pos - m_base);}
+        /*! Reserved rooms left .
+         */
+        auto room() const noexcept -> size_type {return static_cast<size_type>(m_end - m_pos);}
+    private:
+        auto grow(size_type n) noexcept -> void
+        {
+            commit();
+            auto r = m_buffer.writable_tail(std::max<size_type>(n, 1));
+            m_base = m_pos = r.data();
+            m_end  = r.data() + r.size();
+        }
+        BufferBase<char>& m_buffer;            //!< target
+        char*             m_base    {nullptr}; //!< tail of buffer (not committed from here)
+        char*             m_pos     {nullptr}; //!< write position
+        char*             m_end     {nullptr}; //!< end of rooms
+        size_type         m_written {0};       //!< committed bytes
+    }; //<-- class Writer ends here.
+
+    /*! Binary reader of bytes .
+     *
+     * Reader does not move read position of buffer, call buffer.consume(reader.consumed()) after decode.
+     */
+    class Reader
+    {
+    public:
+        explicit Reader(std::span<const char> s) noexcept : m_pos(s.data()), m_begin(s.data()), m_end(s.data() + s.size()) {}
+        explicit Reader(std::string_view s) noexcept : Reader(std::span<const char>(s.data(), s.size())) {}
+        /*! Reader of unread contents [position(), size()) .
+         */
+        explicit Reader(const BufferBase<char>& b) noexcept : Reader(b.readable()) {}
+
+        /*! Check n bytes are left (the one bounds check for following get) .
+         */
+        auto require(size_type n) const noexcept -> bool {return remaining() >= n;}
+        /*! Load value without bounds check (after require()) .
+         */
+        template <codec_value T, std::endian E = std::endian::big>
+        auto get() noexcept -> T
+        {
+            SML_ASSERT(require(sizeof(T)), "Reader::get over contents", true);
+            auto v = Codec::load<E, T>(m_pos);
+            m_pos += sizeof(T);
+            return v;
+        }
+        /*! Load value with bounds check .
+         *  \retval OK loaded
+         *  \retval OUT_OF_RANGE not enough bytes (v is not changed)
+         */
+        template <std::endian E = std::endian::big, codec_value T>
+        auto read(T& v) noexcept -> return_code
+        {
+            if (! require(sizeof(T))) return OUT_OF_RANGE;
+            v = get<T, E>();
+            return OK;
+        }
+        /*! Bytes without copy (after require()) .
+         */
+        auto get_bytes(size_type n) noexcept -> std::string_view
+        {
+            SML_ASSERT(require(n), "Reader::get_bytes over contents", true);
+            std::string_view s(m_pos, n);
+            m_pos += n;
+            return s;
+        }
+        auto read_bytes(size_type n, std::string_view& s) noexcept -> return_code
+        {
+            if (! require(n)) return OUT_OF_RANGE;
+            s = get_bytes(n);
+            return OK;
+        }
+        /*! Load unsigned LEB128 .
+         *  \retval OK loaded
+         *  \retval OUT_OF_RANGE truncated
+         *  \retval FAILURE over 64 bits
+         */
+        auto read_varint(std::uint64_t& v) noexcept -> return_code
+        {
+            std::uint64_t r = 0;
+            auto p = m_pos;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (p == m_end) return OUT_OF_RANGE;
+                auto b = static_cast<std::uint8_t>(*p++);
+                if (shift == 63 && (b & 0x7e) != 0) return FAILURE; // 10th byte carries bit 63 only
+                r |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0) {
+                    m_pos = p;
+                    v = r;
+                    return OK;
+                }
+            }
+            return FAILURE;
+        }
+        auto read_zigzag(std::int64_t& v) noexcept -> return_code
+        {
+            std::uint64_t u = 0;
+            auto ret = read_varint(u);
+            if (ret == OK) v = Codec::unzigzag(u);
+            return ret;
+        }
+        auto skip(size_type n) noexcept -> return_code
+        {
+            if (! require(n)) return OUT_OF_RANGE;
+            m_pos += n;
+            return OK;
+        }
+        auto remaining() const noexcept -> size_type {return static_cast<size_type>(m_end - m_pos);}
+        auto consumed() const noexcept -> size_type {return static_cast<size_type>(m_pos - m_begin);}
+    private:
+        const char* m_pos   {nullptr}; //!< read position
+        const char* m_begin {nullptr}; //!< first byte
+        const char* m_end   {nullptr}; //!< end of bytes
+    }; //<-- class Reader ends here.
+
+    /*! Fixed layout of fields (compile time size and offsets) .
+     *
+     * encode() / decode() do one bounds check for whole message.
+     *  \tparam E byte order of all fields
+     *  \tparam Fields field types in wire order
+     */
+    template <std::endian E, codec_value... Fields>
+    struct Schema
+    {
+        using tuple_type = std::tuple<Fields...>;
+        static constexpr size_type size = (size_type{0} + ... + sizeof(Fields));
+        static constexpr size_type fields = sizeof...(Fields);
+
+        /*! Offset of I th field .
+         */
+        template <size_type I>
+        static constexpr auto offset() noexcept -> size_type
+        {
+            static_assert(I < fields, "field index is over");
+            constexpr size_type sizes[] = {sizeof(Fields)...};
+            size_type o = 0;
+            for (size_type i = 0; i < I; ++i) o += sizes[i];
+            return o;
+        }
+        static auto encode(Writer& w, const Fields&... f) noexcept -> void
+        {
+            w.reserve(size);
+            (w.template put<E>(f), ...);
+        }
+        static auto encode(Writer& w, const tuple_type& t) noexcept -> void
+        {
+            std::apply([&w](const Fields&... f) {encode(w, f...);}, t);
+        }
+        /*!
+         *  \retval OK decoded
+         *  \retval OUT_OF_RANGE not enough bytes (fields are not changed)
+         */
+        static auto decode(Reader& r, Fields&... f) noexcept -> return_code
+        {
+            if (! r.require(size)) return OUT_OF_RANGE;
+            ((f = r.template get<Fields, E>()), ...);
+            return OK;
+        }
+        static auto decode(Reader& r, tuple_type& t) noexcept -> return_code
+        {
+            return std::apply([&r](Fields&... f) {return decode(r, f...);}, t);
+        }
+        /*! Load I th field at fixed offset of bytes (no reader, size checked by caller) .
+         */
+        template <size_type I>
+        static auto field(const char* p) noexcept -> std::tuple_element_t<I, tuple_type>
+        {
+            return Codec::load<E, std::tuple_element_t<I, tuple_type>>(p + offset<I>());
+        }
+    }; //<-- struct Schema ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_CODEC_Hpp ends here.
+/** @} */
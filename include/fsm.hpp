@@ -40,11 +40,17 @@
 
 #ifndef FSM_Hpp
 # define  FSM_Hpp
-# include <unordered_map>
+# include <algorithm>
+# include <bit>
 # include <memory>
+# include <ostream>
+# include <string>
+# include <unordered_map>
+# include <vector>
 
 # include "base.hpp"
 # include "debug.hpp"
+# include "profiler.hpp"
 
 namespace Sml {
     using event_id = std::int64_t;
@@ -135,11 +141,168 @@ namespace Sml {
          *  \retval void
          */
         auto addNextState(event_id id, state_wp p) noexcept -> void {m_states[id] = p;}
+        /*! Next states by event id .
+         */
+        auto nexts() const noexcept -> const states& {return m_states;}
+        /*! Statistics slot of this state in FsmTrace of dispatching Fsm (cache, checked by FsmTrace::owns) .
+         */
+        auto trace_slot() const noexcept -> size_type {return m_trace_slot;}
+        auto trace_slot(size_type s) noexcept -> void {m_trace_slot = s;}
 
     protected:
         context_ptr m_context {nullptr};
         states      m_states  {};
+    private:
+        size_type   m_trace_slot {static_cast<size_type>(-1)}; //!< see trace_slot()
     };
+    /*! One dispatch recorded by FsmTrace .
+     */
+    struct FsmTraceRecord
+    {
+        TscClock::tick_type m_tick  {0}; //!< time stamp (start of doActivity of new state)
+        Base::id_type       m_from  {0}; //!< id of state before dispatch
+        event_id            m_event {0}; //!< dispatched event
+        Base::id_type       m_to    {0}; //!< id of state after dispatch (same as from when not assigned)
+        TscClock::tick_type m_do    {0}; //!< ticks of doActivity (0 unless FsmTrace::timing())
+    }; //<-- struct FsmTraceRecord ends here.
+    /*! Per state statistics of FsmTrace .
+     */
+    struct FsmStateStats
+    {
+        Base::id_type       m_id        {0};       //!< state id (key of statistics)
+        std::string         m_name      {};        //!< state name
+        count_type          m_entries   {0};       //!< entered by event (except stay)
+        count_type          m_stays     {0};       //!< stay dispatches (doActivity only)
+        count_type          m_visits    {0};       //!< completed visits (left by event)
+        TscClock::tick_type m_dwell     {0};       //!< ticks of completed visits in total
+        TscClock::tick_type m_dwell_max {0};       //!< longest completed visit
+        TscClock::tick_type m_do        {0};       //!< ticks of doActivity after entry in total (FsmTrace::timing())
+        TscClock::tick_type m_entered   {0};       //!< time stamp of current visit
+    }; //<-- struct FsmStateStats ends here.
+    /*! Transition recorder of Fsm .
+     *
+     * Fixed ring of last dispatches (except stay) and per state statistics, updated by
+     * plain stores from dispatching thread (no lock, no allocation except the first visit
+     * of each state, the ring is allocated by the first dispatch). Read records() / stats() /
+     * dump() from the same thread, or after dispatching stopped. capacity(0) disables recording.
+     * States are identified by id(). A transition takes one TSC read, timing(true) adds a second
+     * one to measure doActivity.
+     */
+    class FsmTrace
+    {
+    public:
+        static constexpr size_type default_capacity = 32;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        explicit FsmTrace(size_type n = default_capacity) {capacity(n);}
+        /*! Ring size (rounded up to power of 2, 0 : disable). Clears records and statistics .
+         */
+        auto capacity(size_type n) noexcept -> void
+        {
+            m_capacity = (n == 0) ? 0 : std::bit_ceil(n);
+            std::vector<FsmTraceRecord>().swap(m_ring); // allocated by next slot()
+            m_mask = 0;
+            clear();
+        }
+        auto capacity() const noexcept -> size_type {return m_capacity;}
+        auto enabled() const noexcept -> bool {return m_capacity != 0;}
+        /*! Measure doActivity after entry (FsmTraceRecord::m_do, FsmStateStats::m_do), default off .
+         */
+        auto timing(bool on) noexcept -> void {m_timing = on;}
+        auto timing() const noexcept -> bool {return m_timing;}
+        /*! Ring is allocated (by the first dispatch after construction or capacity()) .
+         */
+        auto allocated() const noexcept -> bool {return ! m_ring.empty();}
+        auto clear() noexcept -> void
+        {
+            m_count = 0;
+            m_stats.clear();
+        }
+        /*! Number of recorded dispatches (ring keeps last capacity() of them) .
+         */
+        auto recorded() const noexcept -> count_type {return m_count;}
+        /*! Kept records, oldest first .
+         */
+        auto records() const -> std::vector<FsmTraceRecord>
+        {
+            std::vector<FsmTraceRecord> out;
+            auto n = std::min<count_type>(m_count, m_ring.size());
+            out.reserve(n);
+            for (auto i = m_count - n; i < m_count; ++i) out.push_back(m_ring[i & m_mask]);
+            return out;
+        }
+        auto stats() const noexcept -> const std::vector<FsmStateStats>& {return m_stats;}
+        /*! Statistics slot of state (added on first visit) .
+         *  \retval npos disabled or no memory
+         */
+        auto slot(const Base& state) noexcept -> size_type
+        {
+            if (! enabled()) return npos;
+            for (size_type i = 0; i < m_stats.size(); ++i) {
+                if (m_stats[i].m_id == state.id()) return i;
+            }
+            try {
+                if (m_ring.empty()) {
+                    m_ring.assign(m_capacity, FsmTraceRecord{});
+                    m_mask = m_capacity - 1;
+                }
+                m_stats.push_back(FsmStateStats{state.id(), state.name()});
+            } catch (...) {
+                return npos;
+            }
+            return m_stats.size() - 1;
+        }
+        /// slot s is of state (false after capacity() / clear())
+        auto owns(size_type s, const Base& state) const noexcept -> bool
+        {
+            return s < m_stats.size() && m_stats[s].m_id == state.id();
+        }
+        /// stay dispatch in state of slot
+        auto stay(size_type s) noexcept -> void {++m_stats[s].m_stays;}
+        /// dispatch left state of slot from and entered state of slot to
+        auto transition(size_type from, size_type to, const FsmTraceRecord& r) noexcept -> void
+        {
+            m_ring[m_count & m_mask] = r;
+            ++m_count;
+            auto& f = m_stats[from];
+            if (f.m_entered != 0) {
+                auto dwell = r.m_tick - f.m_entered;
+                ++f.m_visits;
+                f.m_dwell += dwell;
+                f.m_dwell_max = std::max(f.m_dwell_max, dwell);
+            }
+            auto& t = m_stats[to];
+            ++t.m_entries;
+            t.m_do += r.m_do;
+            t.m_entered = r.m_tick;
+        }
+        /*! Write records and statistics as text (times in ns by Profiler calibration) .
+         */
+        auto dump(std::ostream& os) const -> void
+        {
+            auto k = Profiler::calibrated_ns_per_tick();
+            auto ns = [k](TscClock::tick_type t) {return static_cast<std::int64_t>(static_cast<double>(t) * k);};
+            auto rs = records();
+            os << "# fsm trace " << rs.size() << " of " << m_count << " dispatches (time [ns] from oldest)\n";
+            for (auto& r : rs) {
+                os << ns(r.m_tick - rs.front().m_tick) << ' ' << r.m_from << " -(" << r.m_event << ")-> " << r.m_to
+                   << " do=" << ns(r.m_do) << '\n';
+            }
+            os << "# state id name entries stays dwell_avg dwell_max do_avg\n";
+            for (auto& s : m_stats) {
+                os << s.m_id << ' ' << s.m_name << ' ' << s.m_entries << ' ' << s.m_stays << ' '
+                   << ((s.m_visits == 0) ? 0 : ns(s.m_dwell / s.m_visits)) << ' ' << ns(s.m_dwell_max) << ' '
+                   << ((s.m_entries == 0) ? 0 : ns(s.m_do / s.m_entries)) << '\n';
+            }
+        }
+    private:
+        std::vector<FsmTraceRecord> m_ring     {};  //!< last dispatches (empty until first slot())
+        size_type                   m_capacity {0};  //!< ring size (0 : disabled)
+        size_type                   m_mask     {0};  //!< ring size - 1
+        bool                        m_timing   {false}; //!< measure doActivity
+        count_type                  m_count    {0};  //!< recorded dispatches
+        std::vector<FsmStateStats>  m_stats    {};  //!< per state statistics
+    }; //<-- class FsmTrace ends here.
     /*! Finite state machine .
      *
      * \example fsm/example.cpp
@@ -167,6 +330,9 @@ namespace Sml {
         auto context() const noexcept -> context_ptr {return m_context;}
         auto context(context_ptr context) noexcept -> void {m_context = context;}
         auto initial(state_ptr i) noexcept {m_current = i;}
+        /*! Current state .
+         */
+        auto current() const noexcept -> state_ptr {return m_current;}
         auto addTransition(state_ptr from, event_id e, state_ptr to) const noexcept
         {
             from->addNextState(e, to);
@@ -179,10 +345,15 @@ namespace Sml {
          */
         virtual auto dispatch(event_id e) noexcept ->void
         {
+            SML_PROFILE_ZONE("Fsm::dispatch");
             if (!m_current || e < 0) return; // yield
+            auto slot = trace_slot(*m_current);
             if (/*(m_current == m_prev) && */e == 0) { // special transition (internal self transition)
                 m_current->doActivity();
+                if (slot != FsmTrace::npos) m_trace.stay(slot);
             } else {
+                const Base* from = m_current.get(); // compared only, may be released by transition
+                auto from_id = m_current->id();
                 m_current->exit();
                 auto next = m_current->next(e);
                 if (next) {
@@ -193,13 +364,38 @@ namespace Sml {
                     m_current = std::move(next);
                 }
                 m_current->entry();
+                if (slot == FsmTrace::npos) {
+                    m_current->doActivity();
+                    return;
+                }
+                auto to = (m_current.get() != from) ? trace_slot(*m_current) : slot;
+                auto begin = TscClock::now();
                 m_current->doActivity();
+                auto spent = m_trace.timing() ? TscClock::now() - begin : TscClock::tick_type {0};
+                if (to == FsmTrace::npos) return;
+                m_trace.transition(slot, to, FsmTraceRecord{begin, from_id, e, m_current->id(), spent});
             }
         }
+        /*! Transition recorder (capacity(0) disables) .
+         */
+        auto trace() noexcept -> FsmTrace& {return m_trace;}
+        auto trace() const noexcept -> const FsmTrace& {return m_trace;}
     protected:
         context_ptr m_context {nullptr};
         state_ptr   m_current {nullptr};
         // state_ptr   m_prev    {nullptr};
+        FsmTrace    m_trace   {};               //!< transition recorder
+    private:
+        /// statistics slot of state, cached in the state
+        auto trace_slot(state& s) noexcept -> size_type
+        {
+            auto i = s.trace_slot();
+            if (! m_trace.owns(i, s)) [[unlikely]] {
+                i = m_trace.slot(s);
+                s.trace_slot(i);
+            }
+            return i;
+        }
     };
 
     /*!
@@ -0,0 +1,296 @@
+/*!
+ * \file fsm_pool.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Pool of many instances of one state machine definition (structure of arrays)
+ *
+ * Fsm<C> is a graph of State objects per instance, FsmPool<C> keeps one definition
+ * (state actions and dense transition table) and per instance parallel arrays
+ * - current state index
+ * - pending event (dispatched by next step())
+ * - timer deadline (timeout event is dispatched by step() when expired)
+ * - context C
+ *
+ * step() dispatches pending events of all instances in one loop, or partitioned
+ * across worker threads (each worker owns a contiguous range of instances).
+ * Dispatch is same as Fsm::dispatch, stay (0) is doActivity only, other event is
+ * exit, transition (if assigned), entry and doActivity, negative event is ignored.
+ *
+ *\code
+ * struct Device {int m_retry {0};};
+ * Sml::FsmPool<Device> pool(5000);
+ * auto idle = pool.add_state("idle", nullptr, nullptr, nullptr);
+ * auto poll = pool.add_state("poll", [](auto& p, auto id) noexcept {p.arm(id, 100);}, nullptr, nullptr);
+ * pool.add_transition(idle, Ev::start, poll);
+ * pool.add_transition(poll, Ev::timeout, poll);
+ * pool.timeout_event(Ev::timeout);
+ * pool.workers(3);                 // step() on caller and 3 workers
+ * for (;;) pool.step();
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef FSM_POOL_Hpp
+# define  FSM_POOL_Hpp
+
+# include <algorithm>
+# include <atomic>
+# include <barrier>
+# include <chrono>
+# include <limits>
+# include <memory>
+# include <string>
+# include <thread>
+# include <utility>
+# include <vector>
+
+# include "fsm.hpp"
+
+namespace Sml {
+    /*! Pool of state machine instances .
+     *
+     *  \tparam C context of one instance (default constructible)
+     */
+    template <class C>
+    class FsmPool
+    {
+    public:
+        using context_type = C;
+        using state_index  = std::uint16_t;
+        using instance_id  = std::uint32_t;
+        using tick_type    = std::int64_t;  //!< [ns] of steady clock
+        using action_type  = void (*)(FsmPool& pool, instance_id id) noexcept;
+
+        static constexpr state_index no_state = std::numeric_limits<state_index>::max();
+        static constexpr tick_type   disarmed = std::numeric_limits<tick_type>::max();
+        static constexpr size_type   chunk    = 64; //!< partition granularity (instances)
+        /*! Definition of one state .
+         */
+        struct StateSpec
+        {
+            std::string m_name       {};        //!< state name
+            action_type m_entry      {nullptr}; //!< entry action (nullptr : none)
+            action_type m_doActivity {nullptr}; //!< do activity (nullptr : none)
+            action_type m_exit       {nullptr}; //!< exit action (nullptr : none)
+        }; //<-- struct StateSpec ends here.
+
+        explicit FsmPool(size_type instances = 0) {resize(instances);}
+        FsmPool(const FsmPool&) = delete;
+        FsmPool& operator=(const FsmPool&) = delete;
+        ~FsmPool() {workers(0);}
+
+        /*! Add state .
+         *  \retval state index (first added state is initial state)
+         *  \retval no_state too many states (state_index is full)
+         */
+        auto add_state(const std::string& name, action_type entry, action_type doActivity, action_type exit) -> state_index
+        {
+            if (m_specs.size() >= no_state) return no_state;
+            m_specs.push_back(StateSpec{name, entry, doActivity, exit});
+            m_table.resize(m_specs.size() * m_events, no_state);
+            return static_cast<state_index>(m_specs.size() - 1);
+        }
+        /*! Add transition .
+         *  \retval OK added
+         *  \retval OUT_OF_RANGE unknown state or negative event
+         */
+        auto add_transition(state_index from, event_id e, state_index to) -> return_code
+        {
+            if (from >= m_specs.size() || to >= m_specs.size() || e < 0) return OUT_OF_RANGE;
+            auto events = static_cast<size_type>(e) + 1;
+            if (events > m_events) {
+                std::vector<state_index> table(m_specs.size() * events, no_state);
+                for (size_type s = 0; s < m_specs.size(); ++s) {
+                    std::copy_n(m_table.begin() + static_cast<std::ptrdiff_t>(s * m_events), m_events, table.begin() + static_cast<std::ptrdiff_t>(s * events));
+                }
+                m_table.swap(table);
+                m_events = events;
+            }
+            m_table[from * m_events + static_cast<size_type>(e)] = to;
+            return OK;
+        }
+        /*! Next state by event .
+         *  \retval no_state not assigned
+         */
+        auto next(state_index from, event_id e) const noexcept -> state_index
+        {
+            if (e < 0 || static_cast<size_type>(e) >= m_events) return no_state;
+            return m_table[from * m_events + static_cast<size_type>(e)];
+        }
+        /*! Initial state of instances created after this call .
+         */
+        auto initial(state_index s) noexcept -> void {m_initial = s;}
+        /*! Event dispatched by step() when timer of instance expires .
+         */
+        auto timeout_event(event_id e) noexcept -> void {m_timeout = e;}
+        /*! Event pending after each dispatch .
+         *
+         * stay (default) : doActivity is called every step (same as Fsm driven by dispatch(stay) loop)
+         * void_event : instance without posted event or timer costs nothing in step()
+         */
+        auto idle_event(event_id e) noexcept -> void {m_idle = e;}
+        /*! Number of instances (new instances are in initial state, entry is not called same as Fsm) .
+         */
+        auto resize(size_type n) -> void
+        {
+            m_state.resize(n, m_initial);
+            m_pending.resize(n, m_idle);
+            m_deadline.resize(n, disarmed);
+            m_contexts.resize(n);
+        }
+        auto size() const noexcept -> size_type {return m_state.size();}
+        auto states() const noexcept -> size_type {return m_specs.size();}
+        auto spec(state_index s) const noexcept -> const StateSpec& {return m_specs[s];}
+        auto context(instance_id id) noexcept -> context_type& {return m_contexts[id];}
+        auto context(instance_id id) const noexcept -> const context_type& {return m_contexts[id];}
+        auto state(instance_id id) const noexcept -> state_index {return m_state[id];}
+        auto state_name(instance_id id) const -> const std::string& {return m_specs[m_state[id]].m_name;}
+        /*! Post event dispatched by next step() (overwrites pending event) .
+         *
+         * \note From action of other instance, only instances of same partition (or no workers).
+         */
+        auto post(instance_id id, event_id e) noexcept -> void {m_pending[id] = e;}
+        auto pending(instance_id id) const noexcept -> event_id {return m_pending[id];}
+        /*! Start timer of instance from time of current step .
+         */
+        auto arm(instance_id id, millisec_interval ms) noexcept -> void
+        {
+            m_deadline[id] = m_now.load(std::memory_order_relaxed) + static_cast<tick_type>(ms) * 1000000;
+        }
+        auto disarm(instance_id id) noexcept -> void {m_deadline[id] = disarmed;}
+        auto deadline(instance_id id) const noexcept -> tick_type {return m_deadline[id];}
+        /*! Time of current (or last) step .
+         */
+        auto now() const noexcept -> tick_type {return m_now.load(std::memory_order_relaxed);}
+        static auto clock() noexcept -> tick_type
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+        /*! Dispatch event to instance now (same as Fsm::dispatch) .
+         */
+        auto dispatch(instance_id id, event_id e) noexcept -> void
+        {
+            if (e < 0) return;
+            auto s = m_state[id];
+            if (e == 0) {
+                call(m_specs[s].m_doActivity, id);
+                return;
+            }
+            call(m_specs[s].m_exit, id);
+            if (auto n = next(s, e); n != no_state) {
+                m_state[id] = s = n;
+            }
+            call(m_specs[s].m_entry, id);
+            call(m_specs[s].m_doActivity, id);
+        }
+        /*! Dispatch pending (or timeout) event of all instances .
+         *
+         *  \param[in] now time of this step
+         *  \retval number of dispatched events
+         */
+        auto step(tick_type now = clock()) noexcept -> count_type
+        {
+            m_now.store(now, std::memory_order_relaxed);
+            if (m_threads.empty()) return step_range(0, size());
+            m_start->arrive_and_wait();
+            auto [first, last] = partition(0);
+            auto n = step_range(first, last);
+            m_done->arrive_and_wait();
+            for (size_type k = 1; k < m_counts.size(); ++k) n += m_counts[k];
+            return n;
+        }
+        /*! Workers for step() .
+         *
+         * step() is partitioned into k + 1 ranges, the caller of step() takes the first one.
+         *  \param[in] k number of worker threads (0 : step() on caller only)
+         */
+        auto workers(size_type k) -> void
+        {
+            if (! m_threads.empty()) {
+                m_quit.store(true, std::memory_order_relaxed);
+                m_start->arrive_and_wait();
+                m_threads.clear(); // join
+                m_quit.store(false, std::memory_order_relaxed);
+            }
+            if (k == 0) return;
+            m_start  = std::make_unique<std::barrier<>>(static_cast<std::ptrdiff_t>(k + 1));
+            m_done   = std::make_unique<std::barrier<>>(static_cast<std::ptrdiff_t>(k + 1));
+            m_counts.assign(k + 1, 0);
+            for (size_type w = 1; w <= k; ++w) {
+                m_threads.emplace_back([this, w] {
+                    for (;;) {
+                        m_start->arrive_and_wait();
+                        if (m_quit.load(std::memory_order_relaxed)) return;
+                        auto [first, last] = partition(w);
+                        m_counts[w] = step_range(first, last);
+                        m_done->arrive_and_wait();
+                    }
+                });
+            }
+        }
+        auto workers() const noexcept -> size_type {return m_threads.size();}
+    private:
+        /// call action (nullptr : none)
+        auto call(action_type a, instance_id id) noexcept -> void
+        {
+            if (a) a(*this, id);
+        }
+        auto step_range(size_type first, size_type last) noexcept -> count_type
+        {
+            count_type n = 0;
+            auto now = m_now.load(std::memory_order_relaxed);
+            for (auto i = first; i < last; ++i) {
+                auto e = m_pending[i];
+                if (m_deadline[i] <= now) {
+                    m_deadline[i] = disarmed;
+                    if (e <= 0) {
+                        e = m_timeout;
+                        m_pending[i] = m_idle;
+                    } else {
+                        m_pending[i] = m_timeout; // posted event first, timeout by next step
+                    }
+                } else {
+                    if (e < 0) continue;
+                    m_pending[i] = m_idle;
+                }
+                if (e < 0) continue;
+                dispatch(static_cast<instance_id>(i), e);
+                ++n;
+            }
+            return n;
+        }
+        /// range of partition w of (workers + 1), aligned to chunk
+        auto partition(size_type w) const noexcept -> std::pair<size_type, size_type>
+        {
+            auto parts  = m_threads.size() + 1;
+            auto chunks = (size() + chunk - 1) / chunk;
+            auto first  = std::min(chunks * w / parts * chunk, size());
+            auto last   = std::min(chunks * (w + 1) / parts * chunk, size());
+            return {first, last};
+        }
+
+        std::vector<StateSpec>   m_specs    {};          //!< states
+        std::vector<state_index> m_table    {};          //!< transition [state * m_events + event]
+        size_type                m_events   {1};         //!< width of table (max event id + 1)
+        state_index              m_initial  {0};         //!< initial state of new instance
+        event_id                 m_timeout  {FsmEvent::void_event}; //!< event of expired timer
+        event_id                 m_idle     {FsmEvent::stay};       //!< pending event after dispatch
+        std::vector<state_index> m_state    {};          //!< current state of instance
+        std::vector<event_id>    m_pending  {};          //!< pending event of instance
+        std::vector<tick_type>   m_deadline {};          //!< timer deadline of instance
+        std::vector<context_type> m_contexts {};         //!< context of instance
+        std::atomic<tick_type>   m_now      {0};         //!< time of step
+        std::vector<std::jthread> m_threads {};          //!< workers
+        std::unique_ptr<std::barrier<>> m_start {};      //!< step start
+        std::unique_ptr<std::barrier<>> m_done  {};      //!< step end
+        std::vector<count_type>  m_counts   {};          //!< dispatched by worker
+        std::atomic<bool>        m_quit     {false};     //!< stop workers
+    }; //<-- class FsmPool ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  FSM_POOL_Hpp ends here.
@@ -0,0 +1,384 @@
+/*!
+ * \file fsm_runtime.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Sharded multi-core runtime of state machines (event routing by instance id)
+ *
+ * FsmRuntime<M> owns N shards, each shard is one worker thread, the machines of the shard
+ * and a bounded lock-free MPSC inbox of {machine, event}. post(id, e) from any thread
+ * routes the event to the inbox of the owning shard (id % N), only the worker of the shard
+ * calls M::dispatch, so state and context of a machine are mutated by one thread without lock.
+ * Events for one machine are dispatched in posted order (per producer thread).
+ *
+ * Idle worker parks on Signal (hybrid wait policy), producers wake it only when parked.
+ *
+ *\code
+ * Sml::FsmRuntime<SignalFSM> rt(4);              // 4 shards
+ * for (auto& t : towers) rt.add(std::make_unique<SignalFSM>(&t));
+ * rt.start(true);                                // pinned to allowed cpus in order
+ * rt.post(id, SignalEvent::green);               // from any thread
+ * rt.drain();                                    // all posted events dispatched
+ * for (size_type s = 0; s < rt.shards(); ++s) SML_INFO(std::to_string(rt.stats(s).m_depth));
+ * rt.stop();
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef FSM_RUNTIME_Hpp
+# define  FSM_RUNTIME_Hpp
+
+# include <algorithm>
+# include <atomic>
+# include <bit>
+# include <cstdint>
+# include <memory>
+# include <string>
+# include <thread>
+# include <vector>
+# include <sched.h>
+
+# include "fsm.hpp"
+# include "signal.hpp"
+# include "thread.hpp"
+
+namespace Sml {
+    /*! Bounded lock-free MPSC queue of events (one inbox of shard) .
+     *
+     * Slot sequence scheme (D. Vyukov), producers reserve by CAS, one consumer.
+     */
+    class FsmInbox
+    {
+    public:
+        /*! One routed event .
+         */
+        struct Item
+        {
+            std::uint32_t m_local {0}; //!< machine index in shard
+            event_id      m_event {0}; //!< event
+        }; //<-- struct Item ends here.
+
+        /*!
+         *  \param[in] capacity number of events (rounded up to power of 2)
+         */
+        explicit FsmInbox(size_type capacity)
+            : m_slots {std::make_unique<Slot[]>(std::bit_ceil(std::max<size_type>(capacity, 2)))}
+            , m_mask {std::bit_ceil(std::max<size_type>(capacity, 2)) - 1}
+        {
+            for (size_type i = 0; i <= m_mask; ++i) m_slots[i].m_seq.store(i, std::memory_order_relaxed);
+        }
+        FsmInbox(const FsmInbox&) = delete;
+        FsmInbox& operator=(const FsmInbox&) = delete;
+        /*! Push (any thread) .
+         *  \retval false full
+         */
+        auto push(const Item& item) noexcept -> bool
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            for (;;) {
+                auto& s = m_slots[pos & m_mask];
+                auto seq = s.m_seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos);
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        s.m_item = item;
+                        s.m_seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        /*! Pop (owner worker only) .
+         *  \retval false empty
+         */
+        auto pop(Item& item) noexcept -> bool
+        {
+            auto& s = m_slots[m_head & m_mask];
+            if (s.m_seq.load(std::memory_order_acquire) != m_head + 1) return false;
+            item = s.m_item;
+            s.m_seq.store(m_head + m_mask + 1, std::memory_order_release);
+            ++m_head;
+            m_read.store(m_head, std::memory_order_release);
+            return true;
+        }
+        /*! Number of queued events (approximate while producers run) .
+         */
+        auto depth() const noexcept -> size_type
+        {
+            auto tail = m_tail.load(std::memory_order_acquire);
+            auto head = m_read.load(std::memory_order_acquire);
+            return (tail > head) ? tail - head : 0;
+        }
+        auto empty() const noexcept -> bool {return depth() == 0;}
+        auto capacity() const noexcept -> size_type {return m_mask + 1;}
+    private:
+        struct Slot
+        {
+            std::atomic<size_type> m_seq  {0};  //!< pos : free for pos, pos + 1 : filled for pos
+            Item                   m_item {};   //!< event
+        };
+        std::unique_ptr<Slot[]>            m_slots {};  //!< ring
+        size_type                          m_mask  {0}; //!< capacity - 1
+        alignas(64) std::atomic<size_type> m_tail  {0}; //!< next push position (producers)
+        alignas(64) size_type              m_head  {0}; //!< next pop position (consumer)
+        std::atomic<size_type>             m_read  {0}; //!< m_head published for depth()
+    }; //<-- class FsmInbox ends here.
+
+    /*! Metrics of one shard .
+     */
+    struct FsmShardStats
+    {
+        size_type  m_machines   {0}; //!< machines of shard
+        size_type  m_depth      {0}; //!< queued events now
+        size_type  m_max_depth  {0}; //!< highest depth seen by worker
+        count_type m_dispatched {0}; //!< dispatched events
+        count_type m_rejected   {0}; //!< events rejected by full inbox
+        count_type m_parks      {0}; //!< worker parked (inbox was empty)
+    }; //<-- struct FsmShardStats ends here.
+
+    /*! Sharded runtime of machines .
+     *
+     *  \tparam M machine type with dispatch(event_id) (e.g. derived from Fsm<C>)
+     */
+    template <class M>
+    class FsmRuntime
+    {
+    public:
+        using machine_type = M;
+        using machine_ptr  = std::unique_ptr<machine_type>;
+        using instance_id  = std::uint32_t;
+        static constexpr size_type default_inbox = 4096;
+        static constexpr count_type batch = 256; //!< events dispatched between metric updates
+        static constexpr millisec_interval park_timeout = 100;
+
+        /*!
+         *  \param[in] shards number of shards (worker threads, 0 : hardware concurrency)
+         *  \param[in] inbox capacity of inbox of each shard
+         */
+        explicit FsmRuntime(size_type shards = 0, size_type inbox = default_inbox)
+        {
+            if (shards == 0) shards = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+            m_shards.reserve(shards);
+            for (size_type i = 0; i < shards; ++i) m_shards.push_back(std::make_unique<Shard>(inbox));
+        }
+        FsmRuntime(const FsmRuntime&) = delete;
+        FsmRuntime& operator=(const FsmRuntime&) = delete;
+        ~FsmRuntime() {stop();}
+
+        /*! Add machine (before start()) .
+         *  \retval instance id (shard is id % shards())
+         */
+        auto add(machine_ptr m) -> instance_id
+        {
+            auto id = static_cast<instance_id>(m_count++);
+            m_shards[id % m_shards.size()]->m_machines.push_back(std::move(m));
+            return id;
+        }
+        auto size() const noexcept -> size_type {return m_count;}
+        auto shards() const noexcept -> size_type {return m_shards.size();}
+        auto shard_of(instance_id id) const noexcept -> size_type {return id % m_shards.size();}
+        /*! Machine of id (only while stopped, or from dispatch of same shard) .
+         */
+        auto machine(instance_id id) noexcept -> machine_type& {return *m_shards[shard_of(id)]->m_machines[id / m_shards.size()];}
+        /*! Post event to machine (any thread, lock-free) .
+         *  \retval OK queued
+         *  \retval OUT_OF_RANGE unknown id
+         *  \retval NO_RESOURCE inbox full
+         */
+        auto post(instance_id id, event_id e) noexcept -> return_code
+        {
+            if (id >= m_count) return OUT_OF_RANGE;
+            auto& s = *m_shards[shard_of(id)];
+            if (! s.m_inbox.push(FsmInbox::Item{static_cast<std::uint32_t>(id / m_shards.size()), e})) {
+                s.m_rejected.fetch_add(1, std::memory_order_relaxed);
+                return NO_RESOURCE;
+            }
+            std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with fence in park()
+            if (s.m_parked.load(std::memory_order_relaxed) && s.m_parked.exchange(false, std::memory_order_acq_rel)) {
+                s.m_wakeup.update(1);
+            }
+            return OK;
+        }
+        /*! Start workers .
+         *  \param[in] pin pin worker of shard i to i-th cpu allowed for this process (round robin)
+         *  \retval OK started
+         *  \retval FAILURE already running
+         *  \retval FAIL_LUNCH worker not started (e.g. pinning failed), no worker is running
+         */
+        auto start(bool pin = false) -> return_code
+        {
+            ThreadAttributes::cpu_list cpus;
+            if (pin) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (::sched_getaffinity(0, sizeof(set), &set) != 0) {
+                    SML_ERROR("=====> sched_getaffinity error code > "s + std::to_string(errno));
+                    return FAIL_LUNCH;
+                }
+                for (int c = 0; c < CPU_SETSIZE; ++c) if (CPU_ISSET(c, &set)) cpus.push_back(c);
+            }
+            return start(cpus);
+        }
+        /*! Start workers pinned to cpus .
+         *  \param[in] cpus worker of shard i runs on cpus[i % size] (empty : not pinned)
+         *  \retval OK started
+         *  \retval FAILURE already running
+         *  \retval FAIL_LUNCH worker not started (e.g. invalid cpu), no worker is running
+         */
+        auto start(const ThreadAttributes::cpu_list& cpus) -> return_code
+        {
+            if (m_running) return FAILURE;
+            m_quit.store(false, std::memory_order_relaxed);
+            for (size_type i = 0; i < m_shards.size(); ++i) {
+                auto& s = *m_shards[i];
+                ThreadAttributes a;
+                a.m_name = "fsm-shard-" + std::to_string(i);
+                if (! cpus.empty()) a.m_cpus = {cpus[i % cpus.size()]};
+                s.m_thread.attributes(a);
+                s.m_thread.runnable(std::make_shared<Worker>(*this, s));
+                if (auto ret = s.m_thread.start(nullptr); ret != OK) {
+                    join(i);
+                    return ret;
+                }
+            }
+            m_running = true;
+            return OK;
+        }
+        /*! Stop workers (queued events are dispatched before stop) .
+         */
+        auto stop() noexcept -> void
+        {
+            if (! m_running) return;
+            join(m_shards.size());
+            m_running = false;
+        }
+        auto running() const noexcept -> bool {return m_running;}
+        /*! Wait until all events posted before this call are dispatched (workers must be running) .
+         */
+        auto drain() const noexcept -> void
+        {
+            for (auto& s : m_shards) {
+                while (! s->m_inbox.empty() || s->m_busy.load(std::memory_order_acquire)) std::this_thread::yield();
+            }
+        }
+        /*! Metrics of shard .
+         */
+        auto stats(size_type shard) const noexcept -> FsmShardStats
+        {
+            auto& s = *m_shards[shard];
+            return FsmShardStats {
+                s.m_machines.size(),
+                s.m_inbox.depth(),
+                s.m_max_depth.load(std::memory_order_relaxed),
+                s.m_dispatched.load(std::memory_order_relaxed),
+                s.m_rejected.load(std::memory_order_relaxed),
+                s.m_parks.load(std::memory_order_relaxed)
+            };
+        }
+        /*! Sum of metrics of shards (m_depth, m_max_depth are max of shards) .
+         */
+        auto stats() const noexcept -> FsmShardStats
+        {
+            FsmShardStats total;
+            for (size_type i = 0; i < m_shards.size(); ++i) {
+                auto s = stats(i);
+                total.m_machines   += s.m_machines;
+                total.m_depth       = std::max(total.m_depth, s.m_depth);
+                total.m_max_depth   = std::max(total.m_max_depth, s.m_max_depth);
+                total.m_dispatched += s.m_dispatched;
+                total.m_rejected   += s.m_rejected;
+                total.m_parks      += s.m_parks;
+            }
+            return total;
+        }
+    private:
+        /*! Shard (own cache lines) .
+         */
+        struct alignas(64) Shard
+        {
+            explicit Shard(size_type inbox)
+                : m_inbox {inbox}
+                , m_wakeup {WaitPolicy{WaitStrategy::hybrid}}
+            {}
+            FsmInbox                 m_inbox;             //!< routed events
+            std::vector<machine_ptr> m_machines   {};     //!< machines (id / shards)
+            Signal                   m_wakeup;            //!< wake up parked worker
+            std::atomic<bool>        m_parked     {false}; //!< worker is (about to be) parked
+            std::atomic<bool>        m_busy       {false}; //!< worker is dispatching
+            std::atomic<count_type>  m_dispatched {0};    //!< written by worker only
+            std::atomic<count_type>  m_parks      {0};    //!< written by worker only
+            std::atomic<size_type>   m_max_depth  {0};    //!< written by worker only
+            std::atomic<count_type>  m_rejected   {0};    //!< producers
+            Thread                   m_thread     {};     //!< worker
+        }; //<-- struct Shard ends here.
+        /*! Worker of shard (Runnable of Shard::m_thread) .
+         */
+        class Worker final : public Runnable
+        {
+        public:
+            Worker(FsmRuntime& runtime, Shard& shard) noexcept : m_runtime {runtime}, m_shard {shard} {}
+            using Runnable::run;
+            void run(void*) noexcept override {m_runtime.run(m_shard);}
+            return_code stop() noexcept override {return OK;} // by m_quit of runtime
+        private:
+            FsmRuntime& m_runtime; //!< owner
+            Shard&      m_shard;   //!< dispatched shard
+        }; //<-- class Worker ends here.
+        /// stop and join workers of shards [0, n)
+        auto join(size_type n) noexcept -> void
+        {
+            m_quit.store(true, std::memory_order_seq_cst);
+            for (size_type i = 0; i < n; ++i) m_shards[i]->m_wakeup.update(1);
+            for (size_type i = 0; i < n; ++i) m_shards[i]->m_thread.join();
+        }
+        auto run(Shard& s) noexcept -> void
+        {
+            FsmInbox::Item item;
+            for (;;) {
+                s.m_busy.store(true, std::memory_order_release);
+                auto depth = s.m_inbox.depth();
+                if (depth > s.m_max_depth.load(std::memory_order_relaxed)) s.m_max_depth.store(depth, std::memory_order_relaxed);
+                count_type n = 0;
+                while (n < batch && s.m_inbox.pop(item)) {
+                    s.m_machines[item.m_local]->dispatch(item.m_event);
+                    ++n;
+                }
+                s.m_dispatched.store(s.m_dispatched.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+                s.m_busy.store(false, std::memory_order_release);
+                if (n != 0) continue;
+                if (m_quit.load(std::memory_order_acquire)) return; // inbox is empty
+                park(s);
+            }
+        }
+        auto park(Shard& s) noexcept -> void
+        {
+            s.m_parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with fence in post()
+            if (! s.m_inbox.empty() || m_quit.load(std::memory_order_relaxed)) {
+                s.m_parked.store(false, std::memory_order_relaxed);
+                return;
+            }
+            s.m_parks.store(s.m_parks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            try {
+                s.m_wakeup.wait_for(park_timeout);
+            } catch (...) {
+            }
+            s.m_parked.store(false, std::memory_order_relaxed);
+        }
+
+        std::vector<std::unique_ptr<Shard>> m_shards  {};      //!< shards
+        size_type                           m_count   {0};     //!< added machines
+        bool                                m_running {false}; //!< workers started
+        std::atomic<bool>                   m_quit    {false}; //!< stop workers
+    }; //<-- class FsmRuntime ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  FSM_RUNTIME_Hpp ends here.
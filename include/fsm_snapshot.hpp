@@ -0,0 +1,337 @@
+/*!
+ * \file fsm_snapshot.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Snapshot and restore of Fsm (warm restart without replaying events)
+ *
+ * Snapshot of one machine is a compact binary record
+ * | current state id (varint) | context bytes (written by C::snapshot, optional) |
+ *
+ * Restore finds the state of the id among states reachable from current (initial) state
+ * and makes it current without entry(), then C::restore reads the context bytes. So the
+ * context hook restores what entry() would have set up (e.g. timers).
+ *
+ * FsmSnapshotFile keeps records of many machines in one file, read by mmap (zero copy),
+ * | header (64 bytes) | offset table (count + 1, 8 bytes each) | records |
+ * save() writes a temporary file and renames it, so the previous snapshot survives a crash
+ * (durable save also fsyncs the directory, so the rename itself survives power loss).
+ *
+ *\code
+ * struct Tower {
+ *     auto snapshot(Sml::Writer& w) const -> void {w.write_varint(m_count);}
+ *     auto restore(Sml::Reader& r) -> Sml::return_code {return r.read_varint(m_count);}
+ * };
+ * Sml::FsmSnapshotFile::save("towers.snap", machines); // on shutdown
+ * // after restart, machines are constructed (in initial state)
+ * Sml::FsmSnapshotFile f;
+ * if (f.open("towers.snap") == Sml::OK) f.restore(machines);
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef FSM_SNAPSHOT_Hpp
+# define  FSM_SNAPSHOT_Hpp
+
+# include <algorithm>
+# include <cerrno>
+# include <concepts>
+# include <cstdint>
+# include <cstring>
+# include <iterator>
+# include <span>
+# include <string>
+# include <type_traits>
+# include <utility>
+# include <vector>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "fsm.hpp"
+# include "byte_buffer.hpp"
+# include "codec.hpp"
+
+namespace Sml {
+    /*! Context with snapshot hook .
+     */
+    template <class C>
+    concept snapshot_context = requires(const C& c, C& m, Writer& w, Reader& r) {
+        c.snapshot(w);
+        {m.restore(r)} -> std::convertible_to<return_code>;
+    };
+
+    /*! State of id reachable from current state of machine .
+     *  \retval nullptr not found
+     */
+    template <class C>
+    auto fsm_find_state(const Fsm<C>& fsm, Base::id_type id) -> typename Fsm<C>::state_ptr
+    {
+        using state_ptr = typename Fsm<C>::state_ptr;
+        std::vector<state_ptr> found;
+        if (auto s = fsm.current()) found.push_back(std::move(s));
+        for (size_type i = 0; i < found.size(); ++i) {
+            if (found[i]->id() == id) return found[i];
+            for (auto& [e, wp] : found[i]->nexts()) {
+                auto n = wp.lock();
+                if (n && std::find(found.begin(), found.end(), n) == found.end()) found.push_back(std::move(n));
+            }
+        }
+        return nullptr;
+    }
+    /*! Append snapshot record of machine .
+     *  \retval OK appended
+     *  \retval NO_DATA machine has no current state
+     */
+    template <class C>
+    auto fsm_snapshot(const Fsm<C>& fsm, BufferBase<char>& out) noexcept -> return_code
+    {
+        auto s = fsm.current();
+        if (! s) return NO_DATA;
+        Writer w(out);
+        w.write_varint(s->id());
+        if constexpr (snapshot_context<C>) {
+            if (fsm.context()) fsm.context()->snapshot(w);
+        }
+        return OK;
+    }
+    /*! Restore machine from snapshot record (entry() is not called) .
+     *
+     * On failure the current state is unchanged. A copyable context is restored into a copy
+     * and assigned on success, so it is unchanged too; otherwise C::restore may have
+     * modified the context before it failed.
+     *  \retval OK restored
+     *  \retval OUT_OF_RANGE truncated record (Reader)
+     *  \retval NO_DATA state of the id is not reachable from current state
+     *  \retval other return code of C::restore
+     */
+    template <class C>
+    auto fsm_restore(Fsm<C>& fsm, Reader& in) -> return_code
+    {
+        std::uint64_t id = 0;
+        if (auto ret = in.read_varint(id); ret != OK) return ret;
+        auto s = fsm_find_state(fsm, static_cast<Base::id_type>(id));
+        if (! s) return NO_DATA;
+        if constexpr (snapshot_context<C>) {
+            if (auto* c = fsm.context()) {
+                if constexpr (std::is_copy_constructible_v<C> && std::is_move_assignable_v<C>) {
+                    C tmp(*c);
+                    if (auto ret = static_cast<return_code>(tmp.restore(in)); ret != OK) return ret;
+                    *c = std::move(tmp);
+                } else {
+                    if (auto ret = static_cast<return_code>(c->restore(in)); ret != OK) return ret;
+                }
+            }
+        }
+        fsm.initial(std::move(s));
+        return OK;
+    }
+    template <class C>
+    auto fsm_restore(Fsm<C>& fsm, std::span<const char> record) -> return_code
+    {
+        Reader r(record);
+        return fsm_restore(fsm, r);
+    }
+
+    /*! File header of snapshot file .
+     */
+    struct FsmSnapshotHeader
+    {
+        static constexpr char          magic[8] = {'S', 'M', 'L', 'F', 'S', 'M', '\0', '\0'};
+        static constexpr std::uint32_t version  = 1;
+
+        char          m_magic[8]    {};
+        std::uint32_t m_version     {0};
+        std::uint32_t m_header_size {0}; //!< offset of offset table
+        std::uint64_t m_count       {0}; //!< number of records
+        std::uint64_t m_data_size   {0}; //!< bytes of records
+        std::uint8_t  m_spare[32]   {};
+    }; //<-- struct FsmSnapshotHeader ends here.
+    static_assert(sizeof(FsmSnapshotHeader) == 64, "snapshot file layout");
+
+    /*! Bulk snapshot of machines in memory mapped file .
+     */
+    class FsmSnapshotFile
+    {
+    public:
+        FsmSnapshotFile() = default;
+        FsmSnapshotFile(const FsmSnapshotFile&) = delete;
+        FsmSnapshotFile& operator=(const FsmSnapshotFile&) = delete;
+        ~FsmSnapshotFile() {close();}
+
+        /*! Write snapshot of machines (range of Fsm, or of pointers to Fsm) .
+         *
+         *  \param[in] path file name (written as path + ".tmp", then renamed)
+         *  \param[in] machines machines in restore order
+         *  \param[in] durable msync and fsync before rename, fsync of directory after rename
+         *  \retval OK saved
+         *  \retval NO_DATA a machine has no current state
+         *  \retval FAILURE system call failed (temporary file is removed)
+         */
+        template <class Range>
+        static auto save(const std::string& path, const Range& machines, bool durable = false) -> return_code
+        {
+            ByteBuffer data(request_volume(rooms::V4K));
+            std::vector<std::uint64_t> offsets {0};
+            for (auto& m : machines) {
+                if (auto ret = fsm_snapshot(deref(m), data); ret != OK) return ret;
+                offsets.push_back(data.size());
+            }
+            auto table  = offsets.size() * sizeof(std::uint64_t);
+            auto length = sizeof(FsmSnapshotHeader) + table + data.size();
+            auto tmp = path + ".tmp";
+            auto fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) return fail("open");
+            auto discard = [&tmp](const char* what, int f) {
+                auto ret = fail(what); // before close() and unlink() overwrite errno
+                if (f >= 0) ::close(f);
+                ::unlink(tmp.c_str());
+                return ret;
+            };
+            if (::ftruncate(fd, static_cast<off_t>(length)) < 0) return discard("ftruncate", fd);
+            auto* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) return discard("mmap", fd);
+            auto* base = static_cast<char*>(p);
+            FsmSnapshotHeader h {};
+            std::memcpy(h.m_magic, FsmSnapshotHeader::magic, sizeof(FsmSnapshotHeader::magic));
+            h.m_version     = FsmSnapshotHeader::version;
+            h.m_header_size = sizeof(FsmSnapshotHeader);
+            h.m_count       = offsets.size() - 1;
+            h.m_data_size   = data.size();
+            std::memcpy(base, &h, sizeof(h));
+            std::memcpy(base + sizeof(h), offsets.data(), table);
+            if (! data.empty()) std::memcpy(base + sizeof(h) + table, data.const_ptr(), data.size());
+            auto ok = ! durable || (::msync(p, length, MS_SYNC) == 0 && ::fsync(fd) == 0);
+            ::munmap(p, length);
+            if (! ok) return discard("msync", fd);
+            ::close(fd);
+            if (::rename(tmp.c_str(), path.c_str()) < 0) return discard("rename", -1);
+            return (durable) ? sync_directory(path) : OK;
+        }
+        /*! Map snapshot file (read only) .
+         *  \retval OK opened
+         *  \retval FAILURE not a snapshot file or system call failed
+         */
+        auto open(const std::string& path) noexcept -> return_code
+        {
+            if (m_base) return FAILURE;
+            auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return FAILURE;
+            struct stat st {};
+            if (::fstat(fd, &st) < 0 || static_cast<size_type>(st.st_size) < sizeof(FsmSnapshotHeader)) {
+                ::close(fd);
+                return FAILURE;
+            }
+            auto length = static_cast<size_type>(st.st_size);
+            auto* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED) return FAILURE;
+            m_base   = static_cast<const char*>(p);
+            m_mapped = length;
+            FsmSnapshotHeader h;
+            std::memcpy(&h, m_base, sizeof(h));
+            if (std::memcmp(h.m_magic, FsmSnapshotHeader::magic, sizeof(FsmSnapshotHeader::magic)) != 0
+                || h.m_version != FsmSnapshotHeader::version || h.m_header_size != sizeof(FsmSnapshotHeader)
+                || h.m_count > (length - sizeof(h)) / sizeof(std::uint64_t)
+                || sizeof(h) + (h.m_count + 1) * sizeof(std::uint64_t) + h.m_data_size != length) {
+                SML_ERROR("=====> not a snapshot file " + path);
+                close();
+                return FAILURE;
+            }
+            m_count = h.m_count;
+            m_data  = m_base + sizeof(h) + (m_count + 1) * sizeof(std::uint64_t);
+            return OK;
+        }
+        auto close() noexcept -> void
+        {
+            if (m_base) ::munmap(const_cast<char*>(m_base), m_mapped);
+            m_base   = nullptr;
+            m_data   = nullptr;
+            m_mapped = 0;
+            m_count  = 0;
+        }
+        auto is_open() const noexcept -> bool {return m_base != nullptr;}
+        /*! Number of records .
+         */
+        auto size() const noexcept -> size_type {return m_count;}
+        /*! Record i (view into the mapping, empty when broken) .
+         */
+        auto record(size_type i) const noexcept -> std::span<const char>
+        {
+            if (i >= m_count) return {};
+            auto first = offset(i), last = offset(i + 1);
+            auto data_size = m_mapped - static_cast<size_type>(m_data - m_base);
+            if (first > last || last > data_size) return {};
+            return {m_data + first, last - first};
+        }
+        /*! Restore machine from record i .
+         */
+        template <class C>
+        auto restore(size_type i, Fsm<C>& fsm) const -> return_code
+        {
+            if (i >= m_count) return OUT_OF_RANGE;
+            return fsm_restore(fsm, record(i));
+        }
+        /*! Restore machines in saved order .
+         *  \retval OK all restored
+         *  \retval OUT_OF_RANGE number of machines differs from records
+         *  \retval other first failure (following machines are restored anyway)
+         */
+        template <class Range>
+        auto restore(Range& machines) const -> return_code
+        {
+            if (static_cast<size_type>(std::distance(std::begin(machines), std::end(machines))) != m_count) return OUT_OF_RANGE;
+            return_code ret = OK;
+            size_type i = 0;
+            for (auto& m : machines) {
+                auto r = restore(i++, deref(m));
+                if (ret == OK) ret = r;
+            }
+            return ret;
+        }
+    private:
+        template <class T>
+        static auto deref(T& m) noexcept -> auto&
+        {
+            if constexpr (requires {*m;}) return *m;
+            else return m;
+        }
+        auto offset(size_type i) const noexcept -> size_type
+        {
+            std::uint64_t v;
+            std::memcpy(&v, m_base + sizeof(FsmSnapshotHeader) + i * sizeof(v), sizeof(v));
+            return static_cast<size_type>(v);
+        }
+        /// fsync directory of path (makes rename durable)
+        static auto sync_directory(const std::string& path) -> return_code
+        {
+            auto slash = path.rfind('/');
+            auto dir = (slash == std::string::npos) ? "."s : ((slash == 0) ? "/"s : path.substr(0, slash));
+            auto fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0) return fail("open directory");
+            if (::fsync(fd) < 0) {
+                auto ret = fail("fsync directory");
+                ::close(fd);
+                return ret;
+            }
+            ::close(fd);
+            return OK;
+        }
+        static auto fail(const char* what) noexcept -> return_code
+        {
+            SML_ERROR("=====> "s + what + " error code > "s + std::to_string(errno));
+            return FAILURE;
+        }
+        const char* m_base   {nullptr}; //!< read only mapping
+        const char* m_data   {nullptr}; //!< first record
+        size_type   m_mapped {0};       //!< mapped bytes
+        size_type   m_count  {0};       //!< number of records
+    }; //<-- class FsmSnapshotFile ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  FSM_SNAPSHOT_Hpp ends here.
@@ -0,0 +1,152 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file hash.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Fast 64 bits hash of bytes (wyhash) and hasher for ByteBuffer
+ *
+ * hash_bytes() is wyhash (final version 4, public domain by Wang Yi), 48 bytes per iteration
+ * by three independent 64x64->128 multiply lanes. Not cryptographic, don't use for data
+ * from attacker without random seed.
+ *
+ *\code
+ * std::unordered_set<Sml::ByteBuffer, Sml::BufferHash, Sml::BufferEqual> frames;
+ * auto h = Sml::hash_bytes(frame.const_ptr(), frame.size());
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_HASH_Hpp
+# define  SML_HASH_Hpp
+
+# include <cstdint>
+# include <cstring>
+# include <functional>
+# include <string_view>
+
+# include "byte_buffer.hpp"
+
+namespace Sml {
+    namespace Hash {
+        static constexpr std::uint64_t secret[4] = {
+            0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+        };
+        inline auto mum(std::uint64_t& a, std::uint64_t& b) noexcept -> void
+        {
+            auto r = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(r);
+            b = static_cast<std::uint64_t>(r >> 64);
+        }
+        inline auto mix(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t
+        {
+            mum(a, b);
+            return a ^ b;
+        }
+        inline auto r8(const std::uint8_t* p) noexcept -> std::uint64_t
+        {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+        inline auto r4(const std::uint8_t* p) noexcept -> std::uint64_t
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+        inline auto r3(const std::uint8_t* p, size_type k) noexcept -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+        }
+    } //<-- namespace Hash ends here.
+
+    /*! 64 bits hash of bytes .
+     *
+     *  \param[in] vp head of bytes
+     *  \param[in] len number of bytes
+     *  \param[in] seed seed
+     */
+    inline auto hash_bytes(const void* vp, size_type len, std::uint64_t seed = 0) noexcept -> std::uint64_t
+    {
+        using namespace Hash;
+        auto p = static_cast<const std::uint8_t*>(vp);
+        seed ^= mix(seed ^ secret[0], secret[1]);
+        std::uint64_t a = 0, b = 0;
+        if (len <= 16) [[likely]] {
+            if (len >= 4) [[likely]] {
+                a = (r4(p) << 32) | r4(p + ((len >> 3) << 2));
+                b = (r4(p + len - 4) << 32) | r4(p + len - 4 - ((len >> 3) << 2));
+            } else if (len > 0) {
+                a = r3(p, len);
+            }
+        } else {
+            auto i = len;
+            if (i > 48) [[unlikely]] {
+                auto see1 = seed, see2 = seed;
+                do {
+                    seed = mix(r8(p) ^ secret[1], r8(p + 8) ^ seed);
+                    see1 = mix(r8(p + 16) ^ secret[2], r8(p + 24) ^ see1);
+                    see2 = mix(r8(p + 32) ^ secret[3], r8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mix(r8(p) ^ secret[1], r8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = r8(p + i - 16);
+            b = r8(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        mum(a, b);
+        return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+    inline auto hash_bytes(std::string_view s, std::uint64_t seed = 0) noexcept -> std::uint64_t
+    {
+        return hash_bytes(s.data(), s.size(), seed);
+    }
+    inline auto hash_bytes(const BufferBase<char>& b, std::uint64_t seed = 0) noexcept -> std::uint64_t
+    {
+        return hash_bytes(b.const_ptr(), b.size(), seed);
+    }
+
+    /*! Hasher of contents (transparent, ByteBuffer and string_view give same hash) .
+     */
+    struct BufferHash
+    {
+        using is_transparent = void;
+        auto operator()(const BufferBase<char>& b) const noexcept -> std::size_t {return hash_bytes(b);}
+        auto operator()(std::string_view s) const noexcept -> std::size_t {return hash_bytes(s);}
+    }; //<-- struct BufferHash ends here.
+    /*! Equality of contents (transparent) .
+     */
+    struct BufferEqual
+    {
+        using is_transparent = void;
+        auto operator()(const BufferBase<char>& l, const BufferBase<char>& r) const noexcept -> bool {return l == r;}
+        auto operator()(const BufferBase<char>& l, std::string_view r) const noexcept -> bool {return l == r;}
+        auto operator()(std::string_view l, const BufferBase<char>& r) const noexcept -> bool {return r == l;}
+    }; //<-- struct BufferEqual ends here.
+} //<-- namespace Sml ends here.
+
+/*! std::hash of ByteBuffer (contents) .
+ */
+template <>
+struct std::hash<Sml::BufferBase<char>>
+{
+    auto operator()(const Sml::BufferBase<char>& b) const noexcept -> std::size_t {return Sml::hash_bytes(b);}
+};
+
+#endif //<-- macro  SML_HASH_Hpp ends here.
+/** @} */
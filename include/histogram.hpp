@@ -0,0 +1,315 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file histogram.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Log linear (HDR style) histogram for latency values
+ *
+ * Values are grouped by power of two, and each power of two range is split into
+ * 2^SubBits linear sub buckets, so the relative error of one bucket is at most 1/2^SubBits.
+ * Values below 2^SubBits are recorded exactly, values over 2^MaxBits - 1 are saturated.
+ *
+ * - Histogram is plain counters (single writer, or snapshot), mergeable and serializable
+ * - AtomicHistogram records by relaxed atomic add (many writers), read by snapshot()
+ * - ScopedRecorder records elapsed time of scope measured by MeasureTime in [ns]
+ *
+ *\code
+ * Sml::Histogram<> h;
+ * {
+ *     Sml::ScopedRecorder r(h);
+ *     work();
+ * }
+ * SML_LOG("p99 = " + std::to_string(h.p99()) + "[ns]");
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_HISTOGRAM_Hpp
+# define  SML_HISTOGRAM_Hpp
+
+# include <array>
+# include <atomic>
+# include <bit>
+# include <cmath>
+# include <cstdint>
+# include <string>
+# include <string_view>
+
+# include "measure_time.hpp"
+# include "sml.hpp"
+
+namespace Sml {
+    /*! Bucket index calculation of log linear histogram .
+     *
+     *  \tparam SubBits number of bits of linear sub bucket (precision)
+     *  \tparam MaxBits number of bits of maximum trackable value
+     */
+    template <unsigned SubBits = 4, unsigned MaxBits = 40>
+    struct LogLinearScale
+    {
+        static_assert(SubBits >= 1 && SubBits < MaxBits && MaxBits <= 63, "Invalid histogram scale");
+        using value_type = std::uint64_t;
+
+        static constexpr value_type sub_count    = value_type{1} << SubBits;                     //!< sub buckets per power of two
+        static constexpr value_type max_value    = (value_type{1} << MaxBits) - 1;               //!< greatest trackable value
+        static constexpr size_type  bucket_count = static_cast<size_type>((MaxBits - SubBits + 1) * sub_count);
+        /*! Bucket index of value .
+         */
+        static constexpr auto index(value_type v) noexcept -> size_type
+        {
+            if (v > max_value) v = max_value;
+            if (v < sub_count) return static_cast<size_type>(v);
+            auto shift = static_cast<unsigned>(std::bit_width(v)) - 1 - SubBits;
+            return static_cast<size_type>((shift + 1) * sub_count + ((v >> shift) - sub_count));
+        }
+        /*! Lowest value of bucket .
+         */
+        static constexpr auto lower(size_type i) noexcept -> value_type
+        {
+            if (i < sub_count) return static_cast<value_type>(i);
+            auto block = static_cast<unsigned>(i >> SubBits);
+            return (sub_count + (i & (sub_count - 1))) << (block - 1);
+        }
+        /*! Highest value of bucket .
+         */
+        static constexpr auto upper(size_type i) noexcept -> value_type
+        {
+            if (i < sub_count) return static_cast<value_type>(i);
+            return lower(i) + ((value_type{1} << ((i >> SubBits) - 1)) - 1);
+        }
+    }; //<-- struct LogLinearScale ends here.
+
+    /*! Histogram (plain counters) .
+     *
+     *  \tparam Scale bucket index calculation (LogLinearScale)
+     */
+    template <typename Scale = LogLinearScale<>>
+    class Histogram
+    {
+    public:
+        using scale_type  = Scale;
+        using value_type  = typename scale_type::value_type;
+        using counts_type = std::array<count_type, scale_type::bucket_count>;
+        using byte_buffer = std::string;
+
+        static constexpr std::uint8_t serial_magic   = 'H'; //!< first byte of serialized data
+        static constexpr std::uint8_t serial_version = 1;
+
+        /*! Record one value .
+         */
+        auto record(value_type v) noexcept -> void
+        {
+            ++m_counts[scale_type::index(v)];
+            ++m_total;
+            if (v > m_max) m_max = v;
+        }
+        /*! Value at quantile .
+         *
+         * Returns highest value of the bucket which includes the nearest rank ceil(q * count())
+         * (clamped by max()).
+         *  \param[in] q quantile 0.0 ... 1.0
+         *  \retval 0 no value recorded
+         */
+        auto percentile(double q) const noexcept -> value_type
+        {
+            if (m_total == 0) return 0;
+            if (q <= 0.0) q = 0.0;
+            if (q >= 1.0) return m_max;
+            auto rank = static_cast<count_type>(std::ceil(q * static_cast<double>(m_total)));
+            if (rank == 0) rank = 1;
+            count_type seen = 0;
+            for (size_type i = 0; i < m_counts.size(); ++i) {
+                seen += m_counts[i];
+                if (seen >= rank) {
+                    auto v = scale_type::upper(i);
+                    return (v < m_max) ? v : m_max;
+                }
+            }
+            return m_max;
+        }
+        auto p50() const noexcept -> value_type {return percentile(0.5);}
+        auto p99() const noexcept -> value_type {return percentile(0.99);}
+        auto p999() const noexcept -> value_type {return percentile(0.999);}
+        /*! Add counts of other histogram (e.g. per thread histograms into one) .
+         */
+        auto merge(const Histogram& rhs) noexcept -> Histogram&
+        {
+            for (size_type i = 0; i < m_counts.size(); ++i) m_counts[i] += rhs.m_counts[i];
+            m_total += rhs.m_total;
+            if (rhs.m_max > m_max) m_max = rhs.m_max;
+            return *this;
+        }
+        auto operator+=(const Histogram& rhs) noexcept -> Histogram& {return merge(rhs);}
+        /*! Serialize to compact binary .
+         *
+         * magic, version, SubBits, MaxBits, then LEB128 of (number of non empty buckets, max,
+         * and index delta and count of each non empty bucket).
+         */
+        auto serialize() const -> byte_buffer
+        {
+            byte_buffer out;
+            out.push_back(static_cast<char>(serial_magic));
+            out.push_back(static_cast<char>(serial_version));
+            out.push_back(static_cast<char>(std::countr_zero(scale_type::sub_count)));
+            out.push_back(static_cast<char>(std::bit_width(scale_type::max_value)));
+            size_type used = 0;
+            for (auto c : m_counts) used += (c != 0);
+            put(out, used);
+            put(out, m_max);
+            size_type prev = 0;
+            for (size_type i = 0; i < m_counts.size(); ++i) {
+                if (m_counts[i] == 0) continue;
+                put(out, i - prev);
+                put(out, m_counts[i]);
+                prev = i;
+            }
+            return out;
+        }
+        /*! Restore from serialize() output .
+         *
+         *  \retval OK restored
+         *  \retval FAILURE broken data or different scale (this is not changed)
+         */
+        auto deserialize(std::string_view in) noexcept -> return_code
+        {
+            if (in.size() < 4
+                || static_cast<std::uint8_t>(in[0]) != serial_magic
+                || static_cast<std::uint8_t>(in[1]) != serial_version
+                || static_cast<std::uint8_t>(in[2]) != std::countr_zero(scale_type::sub_count)
+                || static_cast<std::uint8_t>(in[3]) != std::bit_width(scale_type::max_value)) return FAILURE;
+            size_type pos = 4;
+            std::uint64_t used = 0;
+            Histogram h;
+            if (! get(in, pos, used) || ! get(in, pos, h.m_max)) return FAILURE;
+            size_type index = 0;
+            for (std::uint64_t n = 0; n < used; ++n) {
+                std::uint64_t delta = 0, c = 0;
+                if (! get(in, pos, delta) || ! get(in, pos, c)) return FAILURE;
+                index += static_cast<size_type>(delta);
+                if (index >= h.m_counts.size()) return FAILURE;
+                h.m_counts[index] = static_cast<count_type>(c);
+                h.m_total += static_cast<count_type>(c);
+            }
+            *this = h;
+            return OK;
+        }
+        auto count() const noexcept -> count_type {return m_total;}
+        auto max() const noexcept -> value_type {return m_max;}
+        auto counts() const noexcept -> const counts_type& {return m_counts;}
+        auto reset() noexcept -> void {*this = Histogram{};}
+    private:
+        static auto put(byte_buffer& out, std::uint64_t v) -> void
+        {
+            do {
+                auto b = static_cast<std::uint8_t>(v & 0x7f);
+                v >>= 7;
+                out.push_back(static_cast<char>(v ? (b | 0x80) : b));
+            } while (v);
+        }
+        static auto get(std::string_view in, size_type& pos, std::uint64_t& v) noexcept -> bool
+        {
+            v = 0;
+            for (unsigned shift = 0; pos < in.size() && shift < 64; shift += 7) {
+                auto b = static_cast<std::uint8_t>(in[pos++]);
+                v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0) return true;
+            }
+            return false;
+        }
+        template <typename S> friend class AtomicHistogram;
+        counts_type m_counts {}; //!< number of values in each bucket
+        count_type  m_total  {0}; //!< number of recorded values
+        value_type  m_max    {0}; //!< greatest recorded value
+    }; //<-- class Histogram ends here.
+
+    /*! Histogram recorded by many threads .
+     *
+     * record() is wait free except max update (relaxed CAS only when new max found),
+     * record_exclusive() is cheaper version for single writer.
+     * snapshot() is not atomic as a whole, counters recorded during snapshot may be partially included.
+     */
+    template <typename Scale = LogLinearScale<>>
+    class AtomicHistogram
+    {
+    public:
+        using scale_type    = Scale;
+        using value_type    = typename scale_type::value_type;
+        using snapshot_type = Histogram<scale_type>;
+
+        AtomicHistogram() = default;
+        AtomicHistogram(const AtomicHistogram&) = delete;
+        AtomicHistogram& operator=(const AtomicHistogram&) = delete;
+        ~AtomicHistogram() = default;
+        /*! Record one value .
+         */
+        auto record(value_type v) noexcept -> void
+        {
+            m_counts[scale_type::index(v)].fetch_add(1, std::memory_order_relaxed);
+            auto current = m_max.load(std::memory_order_relaxed);
+            while (v > current && ! m_max.compare_exchange_weak(current, v, std::memory_order_relaxed)) {}
+        }
+        /*! Record one value by the only writer thread .
+         *
+         * Relaxed load and store (no lock prefixed instruction), readers still see consistent counters by snapshot().
+         * \warning Counts are lost when two threads call this concurrently, use record() for many writers.
+         */
+        auto record_exclusive(value_type v) noexcept -> void
+        {
+            auto& c = m_counts[scale_type::index(v)];
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (v > m_max.load(std::memory_order_relaxed)) m_max.store(v, std::memory_order_relaxed);
+        }
+        /*! Copy current counters .
+         */
+        auto snapshot() const noexcept -> snapshot_type
+        {
+            snapshot_type s;
+            for (size_type i = 0; i < s.m_counts.size(); ++i) {
+                s.m_counts[i] = m_counts[i].load(std::memory_order_relaxed);
+                s.m_total += s.m_counts[i];
+            }
+            s.m_max = m_max.load(std::memory_order_relaxed);
+            return s;
+        }
+        auto reset() noexcept -> void
+        {
+            for (auto& c : m_counts) c.store(0, std::memory_order_relaxed);
+            m_max.store(0, std::memory_order_relaxed);
+        }
+    private:
+        std::array<std::atomic<count_type>, scale_type::bucket_count> m_counts {}; //!< number of values in each bucket
+        std::atomic<value_type>                                       m_max    {0}; //!< greatest recorded value
+    }; //<-- class AtomicHistogram ends here.
+
+    /*! Record elapsed time of scope into histogram .
+     *
+     * Time is measured by MeasureTime in nanoseconds, recorded at destruction.
+     *  \tparam H Histogram or AtomicHistogram (anything has record(uint64_t))
+     */
+    template <typename H>
+    class ScopedRecorder
+    {
+    public:
+        explicit ScopedRecorder(H& h) noexcept : m_histogram {h}, m_timer {true} {}
+        ScopedRecorder(const ScopedRecorder&) = delete;
+        ScopedRecorder& operator=(const ScopedRecorder&) = delete;
+        ~ScopedRecorder()
+        {
+            auto ns = m_timer.acquire_ns();
+            m_histogram.record((ns > 0) ? static_cast<std::uint64_t>(ns) : 0);
+        }
+    private:
+        H&          m_histogram; //!< record target
+        MeasureTime m_timer;     //!< started at construction
+    }; //<-- class ScopedRecorder ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_HISTOGRAM_Hpp ends here.
+/** @} */
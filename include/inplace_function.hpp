@@ -0,0 +1,199 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file inplace_function.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Allocation free callable holders (InplaceFunction / FunctionRef)
+ *
+ * - InplaceFunction owns the callable in fixed inline storage, never allocates.
+ *   When the callable (capture) does not fit, it is a compile time error.
+ * - FunctionRef does not own the callable, only refers (pointer + thunk).
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_INPLACE_FUNCTION_Hpp
+# define  SML_INPLACE_FUNCTION_Hpp
+
+# include <cstddef>
+# include <functional>
+# include <new>
+# include <type_traits>
+# include <utility>
+
+# include "sml.hpp"
+
+namespace Sml {
+    /*! Default inline capacity of InplaceFunction (4 pointers, member function pointer + instance fit) .
+     */
+    static constexpr size_type inplace_function_capacity = 4 * sizeof(void*);
+
+    template <typename Signature, size_type Capacity = inplace_function_capacity>
+    class InplaceFunction;
+    /*! InplaceFunction .
+     *
+     * Like std::function, but the callable is stored in inline storage of Capacity bytes.
+     * Move only (so move only capture is allowed).
+     *  \tparam R return type
+     *  \tparam Args argument type(s)
+     *  \tparam Capacity inline storage size in bytes
+     */
+    template <typename R, typename... Args, size_type Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+        static constexpr size_type alignment = alignof(std::max_align_t);
+        using invoker_type = R (*)(void*, Args&&...);
+        using manager_type = void (*)(void* dst, void* src) noexcept; // src == nullptr: destroy dst, else move src to dst
+        template <typename F>
+        using is_self = std::is_same<std::remove_cvref_t<F>, InplaceFunction>;
+    public:
+        using result_type = R;
+        static constexpr size_type capacity = Capacity;
+
+        InplaceFunction() noexcept = default;
+        InplaceFunction(std::nullptr_t) noexcept {}
+        /*! Construct from callable .
+         *
+         * \note compile error when sizeof(callable) > Capacity
+         */
+        template <typename F>
+        requires (! is_self<F>::value && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InplaceFunction(F&& f) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F&&>)
+        {
+            using functor = std::decay_t<F>;
+            static_assert(sizeof(functor) <= Capacity, "The callable (capture) does not fit in InplaceFunction capacity, increase Capacity");
+            static_assert(alignof(functor) <= alignment, "The callable alignment is over InplaceFunction alignment");
+            static_assert(std::is_nothrow_move_constructible_v<functor>, "The callable must be nothrow move constructible");
+            ::new (static_cast<void*>(m_storage)) functor(std::forward<F>(f));
+            m_invoker = [](void* p, Args&&... a) -> R {
+                return static_cast<R>(std::invoke(*static_cast<functor*>(p), std::forward<Args>(a)...));
+            };
+            m_manager = [](void* dst, void* src) noexcept {
+                if (src) {
+                    ::new (dst) functor(std::move(*static_cast<functor*>(src)));
+                    static_cast<functor*>(src)->~functor();
+                } else {
+                    static_cast<functor*>(dst)->~functor();
+                }
+            };
+        }
+        InplaceFunction(InplaceFunction&& rhs) noexcept {move_from(rhs);}
+        InplaceFunction& operator=(InplaceFunction&& rhs) noexcept
+        {
+            if (this != &rhs) {
+                reset();
+                move_from(rhs);
+            }
+            return *this;
+        }
+        InplaceFunction& operator=(std::nullptr_t) noexcept {reset(); return *this;}
+        template <typename F>
+        requires (! is_self<F>::value && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InplaceFunction& operator=(F&& f)
+        {
+            return (*this = InplaceFunction(std::forward<F>(f)));
+        }
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+        ~InplaceFunction() {reset();}
+        /*! Call callable .
+         *
+         * \warning No check for empty, use operator bool before call.
+         */
+        auto operator()(Args... args) const -> R {return m_invoker(const_cast<void*>(static_cast<const void*>(m_storage)), std::forward<Args>(args)...);}
+        explicit operator bool() const noexcept {return m_invoker != nullptr;}
+        friend bool operator==(const InplaceFunction& f, std::nullptr_t) noexcept {return !f;}
+        /*! Destroy holding callable .
+         */
+        auto reset() noexcept -> void
+        {
+            if (m_manager) m_manager(m_storage, nullptr);
+            m_invoker = nullptr;
+            m_manager = nullptr;
+        }
+    private:
+        auto move_from(InplaceFunction& rhs) noexcept -> void
+        {
+            if (rhs.m_manager) {
+                rhs.m_manager(m_storage, rhs.m_storage);
+                m_invoker = rhs.m_invoker;
+                m_manager = rhs.m_manager;
+                rhs.m_invoker = nullptr;
+                rhs.m_manager = nullptr;
+            }
+        }
+        alignas(alignment) mutable std::byte m_storage[Capacity] {}; //!< inline storage for callable
+        invoker_type m_invoker {nullptr};                             //!< type erased call
+        manager_type m_manager {nullptr};                             //!< type erased move/destroy
+    }; //<-- class InplaceFunction ends here.
+
+    template <typename Signature>
+    class FunctionRef;
+    /*! FunctionRef .
+     *
+     * Non owning reference to callable (two pointers, no allocation).
+     * \warning The referred callable (or instance) must outlive FunctionRef.
+     */
+    template <typename R, typename... Args>
+    class FunctionRef<R(Args...)>
+    {
+        using invoker_type = R (*)(void*, Args&&...);
+        template <typename F>
+        using is_self = std::is_same<std::remove_cvref_t<F>, FunctionRef>;
+    public:
+        using result_type = R;
+
+        constexpr FunctionRef() noexcept = default;
+        constexpr FunctionRef(std::nullptr_t) noexcept {}
+        /*! Refer to function .
+         */
+        FunctionRef(R (*f)(Args...)) noexcept
+            : m_object {reinterpret_cast<void*>(f)}
+            , m_invoker {[](void* p, Args&&... a) -> R {return reinterpret_cast<R (*)(Args...)>(p)(std::forward<Args>(a)...);}}
+        {}
+        /*! Refer to callable object (lvalue only, rvalue would dangle) .
+         */
+        template <typename F>
+        requires (! is_self<F>::value && ! std::is_function_v<F> && std::is_invocable_r_v<R, F&, Args...>)
+        FunctionRef(F& f) noexcept
+            : m_object {const_cast<void*>(static_cast<const void*>(std::addressof(f)))}
+            , m_invoker {[](void* p, Args&&... a) -> R {return static_cast<R>(std::invoke(*static_cast<F*>(p), std::forward<Args>(a)...));}}
+        {}
+        template <typename F>
+        requires (! is_self<F>::value && ! std::is_function_v<std::remove_reference_t<F>> && ! std::is_lvalue_reference_v<F>)
+        FunctionRef(F&&) = delete;
+        /*! Refer to member function of instance .
+         *
+         *  \tparam MF member function pointer
+         *  \param[in] instance target object
+         */
+        template <auto MF, class C>
+        static auto bind(C* instance) noexcept -> FunctionRef
+        {
+            FunctionRef r;
+            r.m_object  = instance;
+            r.m_invoker = [](void* p, Args&&... a) -> R {return static_cast<R>(std::invoke(MF, static_cast<C*>(p), std::forward<Args>(a)...));};
+            return r;
+        }
+        /*! Call referred callable .
+         *
+         * \warning No check for empty, use operator bool before call.
+         */
+        auto operator()(Args... args) const -> R {return m_invoker(m_object, std::forward<Args>(args)...);}
+        explicit operator bool() const noexcept {return m_invoker != nullptr;}
+        friend bool operator==(const FunctionRef& f, std::nullptr_t) noexcept {return !f;}
+        auto reset() noexcept -> void {m_object = nullptr; m_invoker = nullptr;}
+    private:
+        void*        m_object  {nullptr}; //!< referred callable or instance
+        invoker_type m_invoker {nullptr}; //!< type erased call
+    }; //<-- class FunctionRef ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_INPLACE_FUNCTION_Hpp ends here.
+/** @} */
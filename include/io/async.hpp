@@ -0,0 +1,462 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file async.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Coroutine based asynchronous IO for ChannelBase (epoll)
+ *
+ * - IoScheduler epoll based event loop, one thread can service many channels
+ * - ReadAwaiter / WriteAwaiter returned by ChannelBase::async_read / async_write
+ * - IoTask coroutine return type (return_code)
+ *
+ * \code
+ * IoTask protocol(ChannelBase& ch)
+ * {
+ *     std::string buf(256, 0);
+ *     auto ret = co_await ch.async_write("ENQ"s, 100);
+ *     if (ret < 0) co_return ret;
+ *     ret = co_await ch.async_read(buf, 100); // IO_TIMEOUT after 100[ms]
+ *     co_return ret;
+ * }
+ * \endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef ASYNC_Hpp
+# define  ASYNC_Hpp
+
+# include <algorithm>
+# include <chrono>
+# include <coroutine>
+# include <unordered_map>
+# include <utility>
+# include <vector>
+# include <sys/epoll.h>
+
+# include "io/channel.hpp"
+
+namespace Sml {
+    namespace IO {
+        class IoScheduler;
+        /*! Waiting IO request registered in IoScheduler .
+         *
+         * on_ready() is called by IoScheduler when the fd has events.
+         * When on_ready() returns true, the request is completed and the coroutine is resumed.
+         * Destroying a registered waiter (e.g. IoTask dropped while suspended) cancels it.
+         */
+        class IoWaiter
+        {
+        public:
+            using clock      = std::chrono::steady_clock;
+            using time_point = clock::time_point;
+
+            IoWaiter() = default;
+            IoWaiter(const IoWaiter&) = delete;
+            IoWaiter& operator=(const IoWaiter&) = delete;
+            virtual ~IoWaiter();
+            /*! Try IO after fd event .
+             *  \param[in] events epoll events
+             *  \retval true completed (resume coroutine)
+             *  \retval false continue to wait
+             */
+            virtual auto on_ready(std::uint32_t events) noexcept -> bool = 0;
+            /*! Called when the deadline expired .
+             */
+            virtual auto on_timeout() noexcept -> void = 0;
+
+            fd_type                 m_fd       {void_fd()};     //!< target fd
+            direction               m_dir      {direction::in}; //!< wait direction
+            time_point              m_deadline {};              //!< time out point (if m_timed)
+            bool                    m_timed    {false};         //!< has deadline
+            std::coroutine_handle<> m_handle   {};              //!< waiting coroutine
+            IoScheduler*            m_owner    {nullptr};       //!< registered scheduler (until resumed)
+        }; //<-- class IoWaiter ends here.
+
+        /*! Epoll based IO scheduler .
+         *
+         * \note Not thread safe, use from one thread (the thread which calls run()).
+         */
+        class IoScheduler
+        {
+        public:
+            using clock      = IoWaiter::clock;
+            using time_point = IoWaiter::time_point;
+            static constexpr int max_events = 64;
+
+            IoScheduler() : m_epoll {::epoll_create1(EPOLL_CLOEXEC)}
+            {
+                if (is_error_fd(m_epoll)) SML_FATAL("=====> epoll_create1 failed error code > "s + std::to_string(errno));
+            }
+            IoScheduler(const IoScheduler&) = delete;
+            IoScheduler(IoScheduler&&) noexcept = delete;
+            IoScheduler& operator=(const IoScheduler&) = delete;
+            IoScheduler& operator=(IoScheduler&&) noexcept = delete;
+            ~IoScheduler()
+            {
+                for (auto& [fd, e] : m_entries) {
+                    for (auto w : {e.m_in, e.m_out}) if (w) w->m_owner = nullptr;
+                }
+                for (auto w : m_ready) if (w) w->m_owner = nullptr;
+                if (! is_error_fd(m_epoll)) ::close(m_epoll);
+            }
+            operator bool() const noexcept {return ! is_error_fd(m_epoll);}
+            /*! Register waiter .
+             *
+             *  \retval IO_OK registered
+             *  \retval IO_FAILURE epoll_ctl failed or already waiting same fd and direction
+             */
+            auto wait(IoWaiter& w) noexcept -> return_code
+            {
+                auto& e = m_entries[w.m_fd];
+                auto& slot = (w.m_dir == direction::in) ? e.m_in : e.m_out;
+                if (slot) return IO_FAILURE; // one waiter per direction
+                slot = &w;
+                if (update(w.m_fd, e) != IO_OK) {
+                    slot = nullptr;
+                    if (! e.m_in && ! e.m_out) m_entries.erase(w.m_fd);
+                    return IO_FAILURE;
+                }
+                ++m_waiters;
+                w.m_owner = this;
+                return IO_OK;
+            }
+            /*! Unregister waiter (without resume) .
+             *
+             * Also drops the waiter from the resume list of running run_once(),
+             * so a coroutine resumed earlier in the same pass may destroy it.
+             */
+            auto cancel(IoWaiter& w) noexcept -> void
+            {
+                if (w.m_owner != this) return;
+                w.m_owner = nullptr;
+                std::replace(m_ready.begin(), m_ready.end(), &w, static_cast<IoWaiter*>(nullptr));
+                unregister(w);
+            }
+            /*! Wait events and resume completed coroutines .
+             *
+             *  \param[in] max_wait maximum blocking time in [ms] (-1 : until event or deadline)
+             *  \retval number of resumed coroutines
+             */
+            auto run_once(millisec_interval max_wait) noexcept -> count_type
+            {
+                auto& ready = m_ready;
+                ready.clear();
+                epoll_event events[max_events];
+                auto n = ::epoll_wait(m_epoll, events, max_events, wait_time(max_wait));
+                for (int i = 0; i < n; ++i) {
+                    auto it = m_entries.find(events[i].data.fd);
+                    if (it == m_entries.end()) continue;
+                    auto ev = events[i].events;
+                    if (it->second.m_in && (ev & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+                        if (it->second.m_in->on_ready(ev)) ready.push_back(it->second.m_in);
+                    }
+                    if (it->second.m_out && (ev & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+                        if (it->second.m_out->on_ready(ev)) ready.push_back(it->second.m_out);
+                    }
+                }
+                auto now = clock::now();
+                for (auto& [fd, e] : m_entries) {
+                    for (auto w : {e.m_in, e.m_out}) {
+                        if (w && w->m_timed && w->m_deadline <= now && std::find(ready.begin(), ready.end(), w) == ready.end()) {
+                            w->on_timeout();
+                            ready.push_back(w);
+                        }
+                    }
+                }
+                for (auto w : ready) unregister(*w);
+                count_type resumed = 0;
+                for (size_type i = 0; i < ready.size(); ++i) {
+                    auto w = std::exchange(ready[i], nullptr);
+                    if (! w) continue; // cancelled by coroutine resumed before
+                    w->m_owner = nullptr;
+                    w->m_handle.resume(); // may register new waiter or destroy other waiter
+                    ++resumed;
+                }
+                ready.clear();
+                return resumed;
+            }
+            /*! Run event loop until no waiter or stop() .
+             */
+            auto run() noexcept -> void
+            {
+                m_stop = false;
+                while (! m_stop && m_waiters) {
+                    run_once(-1);
+                }
+            }
+            /*! Stop run() loop .
+             */
+            auto stop() noexcept -> void {m_stop = true;}
+            /*! Number of waiting requests .
+             */
+            auto pending() const noexcept -> count_type {return m_waiters;}
+        private:
+            struct entry
+            {
+                IoWaiter*     m_in         {nullptr}; //!< read waiter
+                IoWaiter*     m_out        {nullptr}; //!< write waiter
+                std::uint32_t m_registered {0};       //!< registered events in epoll
+            };
+            /// remove waiter from epoll set (m_owner is kept until resumed)
+            auto unregister(IoWaiter& w) noexcept -> void
+            {
+                auto it = m_entries.find(w.m_fd);
+                if (it == m_entries.end()) return;
+                auto& slot = (w.m_dir == direction::in) ? it->second.m_in : it->second.m_out;
+                if (slot != &w) return;
+                slot = nullptr;
+                --m_waiters;
+                update(w.m_fd, it->second);
+                if (! it->second.m_in && ! it->second.m_out) m_entries.erase(it);
+            }
+            /// apply waiter set of fd to epoll
+            auto update(fd_type fd, entry& e) noexcept -> return_code
+            {
+                std::uint32_t want = (e.m_in ? std::uint32_t {EPOLLIN} : 0u) | (e.m_out ? std::uint32_t {EPOLLOUT} : 0u);
+                if (want == e.m_registered) return IO_OK;
+                epoll_event ev {};
+                ev.events = want;
+                ev.data.fd = fd;
+                int op = (e.m_registered == 0) ? EPOLL_CTL_ADD : ((want == 0) ? EPOLL_CTL_DEL : EPOLL_CTL_MOD);
+                if (::epoll_ctl(m_epoll, op, fd, &ev) < 0) {
+                    SML_ERROR("=====> epoll_ctl failed in fd "s + std::to_string(fd) + " error code > "s + std::to_string(errno));
+                    return IO_FAILURE;
+                }
+                e.m_registered = want;
+                return IO_OK;
+            }
+            /// epoll_wait timeout from nearest deadline
+            auto wait_time(millisec_interval max_wait) const noexcept -> int
+            {
+                auto ret = static_cast<std::int64_t>(max_wait);
+                auto now = clock::now();
+                for (const auto& [fd, e] : m_entries) {
+                    for (auto w : {e.m_in, e.m_out}) {
+                        if (! w || ! w->m_timed) continue;
+                        auto left = std::chrono::ceil<std::chrono::milliseconds>(w->m_deadline - now).count();
+                        if (left < 0) left = 0;
+                        if (ret < 0 || left < ret) ret = left;
+                    }
+                }
+                return static_cast<int>(ret);
+            }
+            fd_type                            m_epoll   {void_fd()}; //!< epoll instance
+            std::unordered_map<fd_type, entry> m_entries {};          //!< waiters by fd
+            count_type                         m_waiters {0};         //!< number of waiters
+            std::vector<IoWaiter*>             m_ready   {};          //!< completed in current run_once()
+            bool                               m_stop    {false};     //!< stop request for run()
+        }; //<-- class IoScheduler ends here.
+
+        inline IoWaiter::~IoWaiter()
+        {
+            if (m_owner) m_owner->cancel(*this);
+        }
+
+        /*! Base of channel awaiters .
+         */
+        class ChannelAwaiter : public IoWaiter
+        {
+        public:
+            ChannelAwaiter(ChannelBase& ch, direction d, millisec_interval timeout) noexcept
+                : m_channel {ch}
+            {
+                m_fd  = ch.m_fd;
+                m_dir = d;
+                if (timeout >= 0) {
+                    m_timed    = true;
+                    m_deadline = clock::now() + std::chrono::milliseconds(timeout);
+                }
+            }
+            auto await_ready() noexcept -> bool
+            {
+                if (! m_channel.m_scheduler || is_error_fd(m_fd)) {
+                    m_result = IO_NOT_OPEN;
+                    return true;
+                }
+                return attempt(0);
+            }
+            auto await_suspend(std::coroutine_handle<> h) noexcept -> bool
+            {
+                m_handle = h;
+                if (m_channel.m_scheduler->wait(*this) != IO_OK) {
+                    m_result = IO_FAILURE;
+                    return false; // resume immediately
+                }
+                return true;
+            }
+            auto await_resume() const noexcept -> return_code {return m_result;}
+            auto on_ready(std::uint32_t events) noexcept -> bool override {return attempt(events);}
+            auto on_timeout() noexcept -> void override
+            {
+                m_channel.m_status.set_reset(status_flag::timeouted, (m_dir == direction::in) ? status_flag::ready_read : status_flag::ready_write);
+                m_result = IO_TIMEOUT;
+            }
+        protected:
+            using status_flag = ChannelBase::status_flag;
+            /*! Try IO .
+             *  \retval true completed (m_result is updated)
+             *  \retval false would block
+             */
+            virtual auto attempt(std::uint32_t events) noexcept -> bool = 0;
+            /// common error check for ::read / ::write result
+            auto would_block(ssize_t ret, errno_t num) noexcept -> bool
+            {
+                if (ret >= 0) return false;
+                if (num == EAGAIN || num == EWOULDBLOCK || num == EINTR) return true;
+                m_channel.m_status.set(status_flag::failure);
+                m_result = IO_FAILURE;
+                return false;
+            }
+            ChannelBase& m_channel;             //!< target channel
+            return_code  m_result {IO_FAILURE}; //!< result of IO
+        }; //<-- class ChannelAwaiter ends here.
+
+        /*! Awaiter for ChannelBase::async_read .
+         *
+         *  \retval (co_await) readed bytes, IO_TIMEOUT, IO_CUT_PARTNER, IO_FAILURE or IO_NOT_OPEN
+         */
+        class ReadAwaiter : public ChannelAwaiter
+        {
+        public:
+            ReadAwaiter(ChannelBase& ch, ChannelBase::byte_buffer& buffer, millisec_interval timeout) noexcept
+                : ChannelAwaiter {ch, direction::in, timeout}
+                , m_buffer {buffer}
+            {}
+        protected:
+            auto attempt(std::uint32_t events) noexcept -> bool override
+            {
+                auto ret = m_channel.read(m_buffer);
+                errno_t num = errno;
+                if (ret > 0) {
+                    m_channel.m_status.set_reset(status_flag::ready_read, status_flag::timeouted);
+                    m_result = ret;
+                    return true;
+                }
+                if (ret == 0) { // no data (VMIN = 0) or hang up
+                    if (events & (EPOLLHUP | EPOLLERR)) {
+                        m_result = IO_CUT_PARTNER;
+                        return true;
+                    }
+                    return false;
+                }
+                return ! would_block(ret, num);
+            }
+        private:
+            ChannelBase::byte_buffer& m_buffer; //!< read buffer
+        }; //<-- class ReadAwaiter ends here.
+
+        /*! Awaiter for ChannelBase::async_write .
+         *
+         * All data is written (partial writes are continued) before resume.
+         *  \retval (co_await) written bytes, IO_TIMEOUT, IO_FAILURE or IO_NOT_OPEN
+         */
+        class WriteAwaiter : public ChannelAwaiter
+        {
+        public:
+            WriteAwaiter(ChannelBase& ch, const ChannelBase::byte_buffer& data, millisec_interval timeout) noexcept
+                : ChannelAwaiter {ch, direction::out, timeout}
+                , m_data {data}
+            {}
+        protected:
+            auto attempt(std::uint32_t) noexcept -> bool override
+            {
+                while (m_done < m_data.size()) {
+                    auto ret = m_channel.write_some(m_data.data() + m_done, m_data.size() - m_done);
+                    errno_t num = errno;
+                    if (ret >= 0) {
+                        m_done += static_cast<size_type>(ret);
+                        continue;
+                    }
+                    if (would_block(ret, num)) return false;
+                    return true; // error
+                }
+                m_channel.m_status.set_reset(status_flag::ready_write, status_flag::timeouted);
+                m_result = static_cast<return_code>(m_done);
+                return true;
+            }
+        private:
+            const ChannelBase::byte_buffer& m_data;     //!< write data
+            size_type                       m_done {0}; //!< written bytes
+        }; //<-- class WriteAwaiter ends here.
+
+        inline auto ChannelBase::async_read(byte_buffer& readed, millisec_interval timeout) noexcept -> ReadAwaiter
+        {
+            return ReadAwaiter(*this, readed, timeout);
+        }
+        inline auto ChannelBase::async_write(const byte_buffer& forSend, millisec_interval timeout) noexcept -> WriteAwaiter
+        {
+            return WriteAwaiter(*this, forSend, timeout);
+        }
+
+        /*! Coroutine type for IO procedure .
+         *
+         * Started eagerly, the result is return_code (co_return).
+         * IoTask can be co_await-ed from other IoTask.
+         */
+        class IoTask
+        {
+        public:
+            struct promise_type
+            {
+                struct final_awaiter
+                {
+                    auto await_ready() const noexcept -> bool {return false;}
+                    auto await_suspend(std::coroutine_handle<promise_type> h) noexcept -> std::coroutine_handle<>
+                    {
+                        auto c = h.promise().m_continuation;
+                        return (c) ? c : std::noop_coroutine();
+                    }
+                    auto await_resume() const noexcept -> void {}
+                };
+                auto get_return_object() noexcept -> IoTask {return IoTask(std::coroutine_handle<promise_type>::from_promise(*this));}
+                auto initial_suspend() const noexcept -> std::suspend_never {return {};}
+                auto final_suspend() const noexcept -> final_awaiter {return {};}
+                auto return_value(return_code r) noexcept -> void {m_result = r;}
+                auto unhandled_exception() noexcept -> void {m_result = IO_FAILURE;}
+
+                return_code             m_result       {IO_FAILURE}; //!< co_return value
+                std::coroutine_handle<> m_continuation {};           //!< awaiting coroutine
+            };
+            using handle_type = std::coroutine_handle<promise_type>;
+
+            IoTask(IoTask&& rhs) noexcept : m_handle {std::exchange(rhs.m_handle, nullptr)} {}
+            IoTask& operator=(IoTask&& rhs) noexcept
+            {
+                if (this != &rhs) {
+                    if (m_handle) m_handle.destroy();
+                    m_handle = std::exchange(rhs.m_handle, nullptr);
+                }
+                return *this;
+            }
+            IoTask(const IoTask&) = delete;
+            IoTask& operator=(const IoTask&) = delete;
+            ~IoTask()
+            {
+                if (m_handle) m_handle.destroy();
+            }
+            /*! Completed check .
+             */
+            auto done() const noexcept -> bool {return ! m_handle || m_handle.done();}
+            /*! Result of co_return (valid after done) .
+             */
+            auto result() const noexcept -> return_code {return (m_handle) ? m_handle.promise().m_result : IO_FAILURE;}
+            // awaitable
+            auto await_ready() const noexcept -> bool {return done();}
+            auto await_suspend(std::coroutine_handle<> c) noexcept -> void {m_handle.promise().m_continuation = c;}
+            auto await_resume() const noexcept -> return_code {return result();}
+        private:
+            friend struct promise_type;
+            explicit IoTask(handle_type h) noexcept : m_handle {h} {}
+            handle_type m_handle {nullptr}; //!< coroutine
+        }; //<-- class IoTask ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  ASYNC_Hpp ends here.
+/** @} */
@@ -0,0 +1,349 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file capture.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Memory mapped capture file of raw IO traffic (for replay debugging)
+ *
+ * | file header (64 bytes) | record | record | ... | preallocated zero |
+ *
+ * A record is header (16 bytes, time stamp, length, channel id, direction) and payload
+ * padded to 8 bytes. The file grows by fallocate in segment unit and is mapped by mremap,
+ * so append is a copy into the mapping (no system call, no flush). m_used of the file header
+ * is updated after each record, so a file of crashed writer is still readable until the last record.
+ * close() truncates the preallocated rest.
+ *
+ * CaptureReader maps the file read only and returns views into the mapping (zero copy).
+ *
+ *\code
+ * Sml::IO::CaptureWriter w;
+ * w.open("serial.cap");
+ * w.append(0, Sml::IO::direction::in, buff.data(), n);
+ *
+ * Sml::IO::CaptureReader r;
+ * r.open("serial.cap");
+ * Sml::IO::CaptureView v;
+ * while (r.next(v) == Sml::IO::IO_OK) use(v.m_data);
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef CAPTURE_Hpp
+# define  CAPTURE_Hpp
+
+# include <atomic>
+# include <cerrno>
+# include <chrono>
+# include <cstdint>
+# include <cstring>
+# include <limits>
+# include <new>
+# include <string>
+# include <string_view>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "byte_buffer.hpp"
+# include "io/io.hpp"
+
+namespace Sml {
+    namespace IO {
+        using channel_id = std::uint16_t; //!< capture channel (e.g. index of serial port)
+
+        /*! File header of capture file .
+         */
+        struct CaptureFileHeader
+        {
+            static constexpr char          magic[8] = {'S', 'M', 'L', 'C', 'A', 'P', '\0', '\0'};
+            static constexpr std::uint32_t version  = 1;
+
+            char                       m_magic[8]    {};
+            std::uint32_t              m_version     {0};
+            std::uint32_t              m_header_size {0}; //!< offset of first record
+            std::atomic<std::uint64_t> m_used        {0}; //!< bytes of records
+            std::atomic<std::uint64_t> m_records     {0}; //!< number of records
+            std::uint64_t              m_origin      {0}; //!< steady clock at open [ns]
+            std::uint8_t               m_spare[24]   {};
+        }; //<-- struct CaptureFileHeader ends here.
+
+        /*! Record header of capture file .
+         */
+        struct CaptureRecord
+        {
+            static constexpr std::uint8_t marker = 0xa5; //!< valid record
+
+            std::uint64_t m_timestamp {0}; //!< steady clock [ns]
+            std::uint32_t m_length    {0}; //!< payload bytes
+            channel_id    m_channel   {0};
+            std::uint8_t  m_direction {0}; //!< direction::in or direction::out
+            std::uint8_t  m_marker    {0};
+        }; //<-- struct CaptureRecord ends here.
+
+        static_assert(sizeof(CaptureFileHeader) == 64 && sizeof(CaptureRecord) == 16, "capture file layout");
+
+        /*! One record in capture file (view into the mapping) .
+         */
+        struct CaptureView
+        {
+            std::uint64_t    m_timestamp {0};             //!< steady clock [ns]
+            channel_id       m_channel   {0};
+            direction        m_direction {direction::in};
+            std::string_view m_data      {};              //!< payload (valid while reader is opened)
+        }; //<-- struct CaptureView ends here.
+
+        /*! Steady clock in [ns] (time stamp of capture) .
+         */
+        inline auto capture_clock() noexcept -> std::uint64_t
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /*! Sequential capture writer .
+         */
+        class CaptureWriter
+        {
+        public:
+            static constexpr size_type default_segment = 16 * 1024 * 1024;
+            static constexpr size_type record_align    = 8;
+
+            CaptureWriter() = default;
+            CaptureWriter(const CaptureWriter&) = delete;
+            CaptureWriter& operator=(const CaptureWriter&) = delete;
+            ~CaptureWriter() {close();}
+            /*! Create (truncate) capture file .
+             *
+             *  \param[in] path file name
+             *  \param[in] segment growth unit of preallocation in bytes (rounded to page)
+             *  \retval IO_OK opened
+             *  \retval IO_FAILURE system call failed or already opened
+             */
+            auto open(const std::string& path, size_type segment = default_segment) noexcept -> return_code
+            {
+                if (! is_error_fd(m_fd)) return IO_FAILURE;
+                auto page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+                m_segment = std::max((segment + page - 1) / page * page, page);
+                m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (is_error_fd(m_fd)) return fail("open");
+                if (grow(m_segment) != IO_OK) {
+                    close();
+                    return IO_FAILURE;
+                }
+                m_header = new (m_base) CaptureFileHeader {};
+                std::memcpy(m_header->m_magic, CaptureFileHeader::magic, sizeof(CaptureFileHeader::magic));
+                m_header->m_version     = CaptureFileHeader::version;
+                m_header->m_header_size = sizeof(CaptureFileHeader);
+                m_header->m_origin      = capture_clock();
+                m_used = 0;
+                return IO_OK;
+            }
+            /*! Append one record .
+             *
+             *  \param[in] ch channel id
+             *  \param[in] d direction::in (received) or direction::out (sent)
+             *  \param[in] p payload
+             *  \param[in] n payload bytes
+             *  \param[in] timestamp steady clock [ns] (default now)
+             *  \retval IO_OK appended
+             *  \retval IO_FAILURE growth failed, or payload over 32 bits length
+             *  \retval IO_NOT_OPEN not opened
+             */
+            auto append(channel_id ch, direction d, const char* p, size_type n
+                      , std::uint64_t timestamp = capture_clock()) noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                if (n > std::numeric_limits<std::uint32_t>::max()) return IO_FAILURE; // CaptureRecord::m_length
+                auto need = record_size(n);
+                auto offset = sizeof(CaptureFileHeader) + m_used;
+                if (offset + need > m_mapped) {
+                    auto more = (offset + need - m_mapped + m_segment - 1) / m_segment * m_segment;
+                    if (grow(more) != IO_OK) return IO_FAILURE;
+                }
+                auto* rec = reinterpret_cast<CaptureRecord*>(static_cast<char*>(m_base) + offset);
+                rec->m_timestamp = timestamp;
+                rec->m_length    = static_cast<std::uint32_t>(n);
+                rec->m_channel   = ch;
+                rec->m_direction = static_cast<std::uint8_t>(d);
+                rec->m_marker    = CaptureRecord::marker;
+                std::memcpy(rec + 1, p, n);
+                m_used += need;
+                m_header->m_used.store(m_used, std::memory_order_release);
+                m_header->m_records.store(m_header->m_records.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return IO_OK;
+            }
+            auto append(channel_id ch, direction d, const ByteBuffer& b
+                      , std::uint64_t timestamp = capture_clock()) noexcept -> return_code
+            {
+                return append(ch, d, b.const_ptr(), b.size(), timestamp);
+            }
+            auto append(channel_id ch, direction d, std::string_view s
+                      , std::uint64_t timestamp = capture_clock()) noexcept -> return_code
+            {
+                return append(ch, d, s.data(), s.size(), timestamp);
+            }
+            /*! Write back dirty pages to file (asynchronous) .
+             */
+            auto sync() noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                return (::msync(m_base, sizeof(CaptureFileHeader) + m_used, MS_ASYNC) == 0) ? IO_OK : IO_FAILURE;
+            }
+            /*! Unmap and truncate preallocated rest .
+             */
+            auto close() noexcept -> void
+            {
+                if (m_base) ::munmap(m_base, m_mapped);
+                if (! is_error_fd(m_fd)) {
+                    if (m_header && ::ftruncate(m_fd, static_cast<off_t>(sizeof(CaptureFileHeader) + m_used)) < 0) fail("ftruncate");
+                    ::close(m_fd);
+                }
+                m_base   = nullptr;
+                m_header = nullptr;
+                m_fd     = void_fd();
+                m_mapped = 0;
+            }
+            auto is_open() const noexcept -> bool {return m_header != nullptr;}
+            auto used() const noexcept -> size_type {return m_used;}
+            auto records() const noexcept -> count_type {return (m_header) ? m_header->m_records.load(std::memory_order_relaxed) : 0;}
+            /*! Mapped (preallocated) bytes of file .
+             */
+            auto mapped() const noexcept -> size_type {return m_mapped;}
+            static constexpr auto record_size(size_type n) noexcept -> size_type
+            {
+                return (sizeof(CaptureRecord) + n + record_align - 1) & ~(record_align - 1);
+            }
+        private:
+            static auto fail(const char* what) noexcept -> return_code
+            {
+                SML_ERROR("=====> "s + what + " error code > "s + std::to_string(errno));
+                return IO_FAILURE;
+            }
+            /// preallocate more bytes at end of file, and map whole file
+            auto grow(size_type more) noexcept -> return_code
+            {
+                auto length = m_mapped + more;
+                if (::fallocate(m_fd, 0, static_cast<off_t>(m_mapped), static_cast<off_t>(more)) < 0) {
+                    if (errno != EOPNOTSUPP || ::ftruncate(m_fd, static_cast<off_t>(length)) < 0) return fail("fallocate");
+                }
+                auto* p = (m_base) ? ::mremap(m_base, m_mapped, length, MREMAP_MAYMOVE)
+                                   : ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+                if (p == MAP_FAILED) return fail("mmap");
+# if defined(MADV_POPULATE_WRITE)
+                ::madvise(static_cast<char*>(p) + m_mapped, more, MADV_POPULATE_WRITE); // prefault (no fault on append)
+# endif
+                m_base   = p;
+                m_header = (m_header) ? static_cast<CaptureFileHeader*>(p) : nullptr;
+                m_mapped = length;
+                return IO_OK;
+            }
+            void*              m_base    {nullptr};   //!< mapping of whole file
+            CaptureFileHeader* m_header  {nullptr};   //!< file header in mapping
+            fd_type            m_fd      {void_fd()}; //!< capture file
+            size_type          m_mapped  {0};         //!< mapped (allocated) bytes
+            size_type          m_used    {0};         //!< bytes of records
+            size_type          m_segment {default_segment}; //!< growth unit
+        }; //<-- class CaptureWriter ends here.
+
+        /*! Zero copy capture reader .
+         */
+        class CaptureReader
+        {
+        public:
+            CaptureReader() = default;
+            CaptureReader(const CaptureReader&) = delete;
+            CaptureReader& operator=(const CaptureReader&) = delete;
+            ~CaptureReader() {close();}
+            /*! Map capture file .
+             *
+             *  \retval IO_OK opened
+             *  \retval IO_FAILURE not a capture file or system call failed
+             */
+            auto open(const std::string& path) noexcept -> return_code
+            {
+                if (m_base) return IO_FAILURE;
+                auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (is_error_fd(fd)) return IO_FAILURE;
+                struct stat st {};
+                if (::fstat(fd, &st) < 0 || static_cast<size_type>(st.st_size) < sizeof(CaptureFileHeader)) {
+                    ::close(fd);
+                    return IO_FAILURE;
+                }
+                auto length = static_cast<size_type>(st.st_size);
+                auto* p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (p == MAP_FAILED) return IO_FAILURE;
+                m_base   = static_cast<const char*>(p);
+                m_mapped = length;
+                auto* h = reinterpret_cast<const CaptureFileHeader*>(m_base);
+                if (std::memcmp(h->m_magic, CaptureFileHeader::magic, sizeof(CaptureFileHeader::magic)) != 0
+                    || h->m_version != CaptureFileHeader::version || h->m_header_size != sizeof(CaptureFileHeader)) {
+                    SML_ERROR("=====> not a capture file " + path);
+                    close();
+                    return IO_FAILURE;
+                }
+                m_end = std::min(sizeof(CaptureFileHeader) + h->m_used.load(std::memory_order_acquire), m_mapped);
+                rewind();
+                return IO_OK;
+            }
+            auto close() noexcept -> void
+            {
+                if (m_base) ::munmap(const_cast<char*>(m_base), m_mapped);
+                m_base   = nullptr;
+                m_mapped = 0;
+                m_end    = 0;
+                m_pos    = 0;
+            }
+            /*! Next record .
+             *
+             *  \param[out] v view into the mapping
+             *  \retval IO_OK got record
+             *  \retval NO_DATA end of capture
+             *  \retval IO_NOT_OPEN not opened
+             */
+            auto next(CaptureView& v) noexcept -> return_code
+            {
+                if (! m_base) return IO_NOT_OPEN;
+                if (m_pos + sizeof(CaptureRecord) > m_end) return NO_DATA;
+                auto* rec = reinterpret_cast<const CaptureRecord*>(m_base + m_pos);
+                auto size = CaptureWriter::record_size(rec->m_length);
+                if (rec->m_marker != CaptureRecord::marker || m_pos + size > m_end) return NO_DATA;
+                v.m_timestamp = rec->m_timestamp;
+                v.m_channel   = rec->m_channel;
+                v.m_direction = static_cast<direction>(rec->m_direction);
+                v.m_data      = std::string_view(reinterpret_cast<const char*>(rec + 1), rec->m_length);
+                m_pos += size;
+                return IO_OK;
+            }
+            auto rewind() noexcept -> void {m_pos = sizeof(CaptureFileHeader);}
+            auto is_open() const noexcept -> bool {return m_base != nullptr;}
+            /*! Number of records written by writer .
+             */
+            auto records() const noexcept -> count_type
+            {
+                return (m_base) ? reinterpret_cast<const CaptureFileHeader*>(m_base)->m_records.load(std::memory_order_relaxed) : 0;
+            }
+            /*! Steady clock [ns] when the writer opened .
+             */
+            auto origin() const noexcept -> std::uint64_t
+            {
+                return (m_base) ? reinterpret_cast<const CaptureFileHeader*>(m_base)->m_origin : 0;
+            }
+        private:
+            const char* m_base   {nullptr}; //!< read only mapping
+            size_type   m_mapped {0};       //!< mapped bytes
+            size_type   m_end    {0};       //!< end of records
+            size_type   m_pos    {0};       //!< next record
+        }; //<-- class CaptureReader ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  CAPTURE_Hpp ends here.
+/** @} */
@@ -17,14 +17,27 @@
 # define  CHANNEL_Hpp
 
 # include <csignal>
+# include <memory>
+# include <new>
+# include <poll.h>
+# include <stop_token>
+# include <sys/eventfd.h>
 # include <sys/select.h>
+# include <unistd.h>
 
 # include "base.hpp"
+# include "io/channel_stats.hpp"
 # include "io/io.hpp"
+# include "io/output_queue.hpp"
 # include "io/status_flag.hpp"
 
 namespace Sml {
+    class ChainBuffer;
     namespace IO {
+        class IoScheduler;
+        class ChannelAwaiter;
+        class ReadAwaiter;
+        class WriteAwaiter;
         /*! Device connection parameter(s) abstract base class .
          */
         class ConnectionParameterBase : public Sml::Base
@@ -53,6 +66,9 @@ namespace Sml {
             using sigset_ptr    = std::shared_ptr<sigset_t>;
             using byte_buffer   = std::string;
             using status_flag   = StatusFlag;
+            using output_queue  = OutputQueue;
+            using channel_stats = ChannelStats;
+            static constexpr size_type max_iovec = 64; //!< segments per writev call
 
             ChannelBase()
                 : m_timeout{std::make_unique<timespec_type>(0, 0)}
@@ -66,7 +82,10 @@ namespace Sml {
             }
             ChannelBase(const ChannelBase&) = delete;
             ChannelBase(ChannelBase&&) noexcept = delete;
-            virtual ~ChannelBase() = default;
+            virtual ~ChannelBase()
+            {
+                if (! is_error_fd(m_wakeup)) ::close(m_wakeup);
+            }
             /*! setup by derived class .
              */
             virtual auto setup() noexcept -> void {}
@@ -84,6 +103,82 @@ namespace Sml {
              *  \param[in] forSend mean sending data to channel
              */
             virtual auto write(const byte_buffer& forSend) noexcept -> return_code = 0;
+            /*! Post data to output queue .
+             * The data is coalesced with other posted data, and written when the flush policy hits.
+             *  \param[in] forSend mean sending data to channel
+             *  \retval IO_OK queued (or flushed)
+             *  \retval IO_TIMEOUT flushed partially, the channel would block (remaining data is kept)
+             *  \retval IO_FAILURE write error
+             *  \retval NO_RESOURCE when catch bad_alloc() from output queue (data is not queued)
+             */
+            auto post(const byte_buffer& forSend) noexcept -> return_code
+            {
+                try {
+                    m_outq.push(forSend.data(), forSend.size());
+                } catch (std::bad_alloc& e) {
+                    SML_ERROR("=====> post failed in fd "s + std::to_string(m_fd) + " "s + e.what());
+                    return NO_RESOURCE;
+                }
+                return (m_outq.due()) ? flush() : IO_OK;
+            }
+            /*! Flush output queue .
+             *  \retval IO_OK all pending data written
+             *  \retval IO_TIMEOUT the channel would block (remaining data is kept)
+             *  \retval IO_FAILURE write error
+             *  \retval IO_NOT_OPEN the channel has no fd
+             */
+            auto flush() noexcept -> return_code
+            {
+                if (m_outq.empty()) return IO_OK;
+                if (is_error_fd(m_fd)) return IO_NOT_OPEN;
+                auto ret = m_outq.flush([this](const char* p, size_type n) {return write_some(p, n);});
+                if (ret == IO_TIMEOUT) {
+                    m_status.set_reset(status_flag::timeouted, status_flag::ready_write);
+                } else if (ret == IO_FAILURE) {
+                    m_status.set_reset(status_flag::failure, status_flag::ready_write);
+                    SML_FATAL("=====> write error in fd "s + std::to_string(m_fd) + " error code > "s + std::to_string(errno));
+                }
+                return ret;
+            }
+            /*! Gather write of chained buffer by ::writev (segments are not coalesced) .
+             * \note defined in io/writev.hpp
+             *  \param[in] frame mean sending data to channel (first max_iovec segments per call)
+             *  \retval written bytes (may be partial, frame.trim_front(ret) then retry the rest)
+             *  \retval IO_TIMEOUT the channel would block
+             *  \retval IO_FAILURE write error
+             *  \retval IO_NOT_OPEN the channel has no fd
+             */
+            auto writev(const ChainBuffer& frame) noexcept -> return_code;
+            /*! Flush output queue when deadline (or size threshold) is hit .
+             * Call this periodically from writer loop (e.g. after isReady() timeout).
+             */
+            auto flush_if_due() noexcept -> return_code {return (m_outq.due()) ? flush() : IO_OK;}
+            /*! Attach IO scheduler for async_read / async_write .
+             *  \param[in] s scheduler (not owned, nullptr detach)
+             */
+            auto scheduler(IoScheduler* s) noexcept -> void {m_scheduler = s;}
+            auto scheduler() const noexcept -> IoScheduler* {return m_scheduler;}
+            /*! Asynchronous read (co_await) .
+             * \note defined in io/async.hpp
+             *  \param[out] readed mean readed data from channel
+             *  \param[in] timeout in [ms] (-1 : no timeout)
+             */
+            auto async_read(byte_buffer& readed, millisec_interval timeout = -1) noexcept -> ReadAwaiter;
+            /*! Asynchronous write (co_await) .
+             * \note defined in io/async.hpp
+             *  \param[in] forSend mean sending data to channel (must outlive co_await)
+             *  \param[in] timeout in [ms] (-1 : no timeout)
+             */
+            auto async_write(const byte_buffer& forSend, millisec_interval timeout = -1) noexcept -> WriteAwaiter;
+            auto output() const noexcept -> const output_queue& {return m_outq;}
+            auto output() noexcept -> output_queue& {return m_outq;}
+            /*! IO statistics of this channel (use stats().snapshot() for read) .
+             */
+            auto stats() const noexcept -> const channel_stats& {return m_stats;}
+            auto stats() noexcept -> channel_stats& {return m_stats;}
+            /*! File descriptor (for external event loop, e.g. poll / epoll) .
+             */
+            auto fd() const noexcept -> fd_type {return m_fd;}
             auto status() const noexcept -> const status_flag& {return m_status;}
             auto status() noexcept -> status_flag& {return m_status;}
             /*! Check IO ready .
@@ -98,6 +193,7 @@ namespace Sml {
                 FD_ZERO(&fdset);
                 FD_SET(m_fd, &fdset);
 
+                auto start = channel_stats::now();
                 if (d == direction::in) {
                     s = status_flag::ready_read;
                     ret = pselect(m_fd + 1, &fdset, NULL, NULL, m_timeout.get(), m_mask.get());
@@ -106,6 +202,7 @@ namespace Sml {
                     ret = pselect(m_fd + 1, NULL, &fdset, NULL, m_timeout.get(), m_mask.get());
                 }
                 errno_t num = errno; // set error number
+                m_stats.on_ready(ready_code(ret, num, false), start);
                 // update flag
                 if (ret > 0) { // PSELECT
                     if (FD_ISSET(m_fd, &fdset)) {
@@ -132,11 +229,93 @@ namespace Sml {
                 } //<-- PSELECT result check ends here.
                 return static_cast<return_code>(ret);
             }
+            /*! Check IO ready, wake up by stop request .
+             * Waits m_fd and the wakeup eventfd (created at first call) by ppoll,
+             * a stop callback writes the eventfd, so the waiting is canceled immediately.
+             *  \param[in] d is direction code direction::in wait readable, direction::out wait writeable
+             *  \param[in] st stop token (e.g. given to Runnable::run)
+             *  \param[in] timeout in [ms] (-1 : no timeout)
+             *  \retval IO_CANCELED stop requested
+             */
+            auto isReady(direction d, std::stop_token st, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                if (st.stop_requested()) return IO_CANCELED;
+                if (is_error_fd(m_wakeup)) {
+                    m_wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    if (is_error_fd(m_wakeup)) return IO_FAILURE;
+                }
+                auto s = (d == direction::in) ? status_flag::ready_read : status_flag::ready_write;
+                pollfd fds[2] = {
+                    {m_fd, static_cast<short>((d == direction::in) ? POLLIN : POLLOUT), 0},
+                    {m_wakeup, POLLIN, 0},
+                };
+                auto wakeup = m_wakeup;
+                std::stop_callback cb(st, [wakeup] {
+                    eventfd_t one = 1;
+                    [[maybe_unused]] auto r = ::write(wakeup, &one, sizeof(one));
+                });
+                timespec_type limit {timeout / 1000, static_cast<long>(timeout % 1000) * 1000000L};
+                auto start = channel_stats::now();
+                auto ret = ::ppoll(fds, 2, (timeout < 0) ? nullptr : &limit, m_mask.get());
+                errno_t num = errno; // set error number
+                if (ret > 0 && (fds[1].revents & POLLIN)) {
+                    eventfd_t drain;
+                    [[maybe_unused]] auto r = ::read(m_wakeup, &drain, sizeof(drain));
+                }
+                if (st.stop_requested()) return IO_CANCELED;
+                if (ret > 0 && fds[0].revents == 0) ret = 0; // spurious wakeup (drained)
+                m_stats.on_ready(ready_code(ret, num, true), start); // EINTR is IO_TIMEOUT here
+                if (ret > 0) {
+                    m_status.set_reset(s, status_flag::timeouted);
+                    return IO_OK;
+                } else if (ret == 0 || num == EAGAIN || num == EINTR) {
+                    m_status.set_reset(status_flag::timeouted, s);
+                    return IO_TIMEOUT;
+                }
+                m_status.set_reset(status_flag::failure, s);
+                SML_FATAL("=====> in fd "s + std::to_string(m_fd) + " error code > "s + std::to_string(num));
+                return IO_FAILURE;
+            }
         protected:
+            friend class ChannelAwaiter;
+            friend class ReadAwaiter;
+            friend class WriteAwaiter;
+            /*! Low level write for output queue .
+             *  \retval ssize_t same as ::write
+             */
+            virtual auto write_some(const char* p, size_type n) noexcept -> ssize_t
+            {
+                auto start = channel_stats::now();
+                auto ret = ::write(m_fd, p, n);
+                m_stats.on_write(ret, n, start);
+                return ret;
+            }
+            /*! Low level read with statistics .
+             *  \retval ssize_t same as ::read
+             */
+            auto read_some(char* p, size_type n) noexcept -> ssize_t
+            {
+                auto ret = ::read(m_fd, p, n);
+                m_stats.on_read(ret);
+                return ret;
+            }
+
             fd_type      m_fd      {void_fd()}; //!< communication channel target fd
             status_flag  m_status  {};          //!< communication channel status
             timespec_ptr m_timeout {nullptr};   //!< for use pselect system call
-            sigset_ptr m_mask{nullptr};         //!< for use pselect system call
+            sigset_ptr   m_mask    {nullptr};   //!< for use pselect system call
+            output_queue m_outq    {};          //!< coalescing output queue
+            IoScheduler* m_scheduler {nullptr}; //!< for async IO (not owned)
+            channel_stats m_stats  {};          //!< IO statistics
+            fd_type      m_wakeup  {void_fd()}; //!< eventfd for stop request (isReady with stop token)
+        private:
+            /// pselect / ppoll result to isReady return code (for statistics, same as returned code)
+            static constexpr auto ready_code(ssize_t ret, errno_t num, bool eintr_timeout) noexcept -> return_code
+            {
+                if (ret > 0) return IO_OK;
+                if (ret == 0 || num == EAGAIN || (eintr_timeout && num == EINTR)) return IO_TIMEOUT;
+                return IO_FAILURE;
+            }
         }; //<-- abstract class ChannelBase ends here.
         }  // namespace IO
         }  // namespace Sml
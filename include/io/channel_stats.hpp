@@ -0,0 +1,176 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file channel_stats.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Per channel IO statistics (counters and latency histograms)
+ *
+ * Recorded by relaxed atomics on the IO path, read by snapshot() from any thread.
+ * Each direction of one channel has a single writer thread (same as OutputQueue), so
+ * counters of one direction are relaxed load and store without lock prefixed instruction.
+ * Counters of both directions (EAGAIN, isReady wait and timeouts) are recorded by
+ * fetch_add, because the reader and the writer thread may record them concurrently.
+ * Define SML_IO_STATS_DISABLE for compile out all recording (and clock reading).
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef CHANNEL_STATS_Hpp
+# define  CHANNEL_STATS_Hpp
+
+# include <atomic>
+# include <cerrno>
+# include <chrono>
+# include <sys/types.h>
+
+# include "histogram.hpp"
+# include "io/io.hpp"
+
+namespace Sml {
+    namespace IO {
+# if defined(SML_IO_STATS_DISABLE)
+        static constexpr bool io_stats_enabled = false;
+# else
+        static constexpr bool io_stats_enabled = true;
+# endif
+        using latency_histogram          = AtomicHistogram<>;               //!< latency in [ns]
+        using latency_histogram_snapshot = latency_histogram::snapshot_type;
+
+        /*! Snapshot of ChannelStats .
+         */
+        struct ChannelStatsSnapshot
+        {
+            count_type                 m_bytes_in     {0}; //!< received bytes
+            count_type                 m_bytes_out    {0}; //!< sent bytes
+            count_type                 m_reads        {0}; //!< read system calls
+            count_type                 m_writes       {0}; //!< write system calls
+            count_type                 m_timeouts     {0}; //!< isReady timeouts
+            count_type                 m_again        {0}; //!< EAGAIN (or EWOULDBLOCK) of read / write
+            count_type                 m_partial      {0}; //!< partial writes
+            latency_histogram_snapshot m_ready_wait   {};  //!< isReady waiting time [ns]
+            latency_histogram_snapshot m_write_time   {};  //!< write system call time [ns]
+        }; //<-- struct ChannelStatsSnapshot ends here.
+
+        /*! Per channel IO statistics .
+         */
+        class ChannelStats
+        {
+        public:
+            using clock_type    = std::chrono::steady_clock;
+            using time_point    = clock_type::time_point;
+            using snapshot_type = ChannelStatsSnapshot;
+
+            ChannelStats() = default;
+            ChannelStats(const ChannelStats&) = delete;
+            ChannelStats& operator=(const ChannelStats&) = delete;
+            ~ChannelStats() = default;
+            /*! Time stamp for latency (epoch when stats disabled) .
+             */
+            static auto now() noexcept -> time_point
+            {
+                if constexpr (io_stats_enabled) return clock_type::now();
+                else return time_point{};
+            }
+            /*! Record result of read system call .
+             *
+             *  \param[in] ret return value of ::read (errno is checked when ret < 0)
+             */
+            auto on_read(ssize_t ret) noexcept -> void
+            {
+                if constexpr (io_stats_enabled) {
+                    add(m_reads, 1);
+                    if (ret > 0) add(m_bytes_in, static_cast<count_type>(ret));
+                    else if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) add_shared(m_again, 1);
+                }
+            }
+            /*! Record result of write system call .
+             *
+             *  \param[in] ret return value of ::write (errno is checked when ret < 0)
+             *  \param[in] requested requested length
+             *  \param[in] start time stamp of just before ::write
+             */
+            auto on_write(ssize_t ret, size_type requested, time_point start) noexcept -> void
+            {
+                if constexpr (io_stats_enabled) {
+                    m_write_time.record_exclusive(elapsed(start));
+                    add(m_writes, 1);
+                    if (ret >= 0) {
+                        add(m_bytes_out, static_cast<count_type>(ret));
+                        if (static_cast<size_type>(ret) < requested) add(m_partial, 1);
+                    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        add_shared(m_again, 1);
+                    }
+                }
+            }
+            /*! Record result of isReady .
+             *
+             *  \param[in] ret return code of isReady
+             *  \param[in] start time stamp of just before waiting
+             */
+            auto on_ready(return_code ret, time_point start) noexcept -> void
+            {
+                if constexpr (io_stats_enabled) {
+                    m_ready_wait.record(elapsed(start)); // isReady(in) and isReady(out)
+                    if (ret == IO_TIMEOUT) add_shared(m_timeouts, 1);
+                }
+            }
+            /*! Copy current statistics .
+             */
+            auto snapshot() const noexcept -> snapshot_type
+            {
+                snapshot_type s;
+                s.m_bytes_in   = m_bytes_in.load(std::memory_order_relaxed);
+                s.m_bytes_out  = m_bytes_out.load(std::memory_order_relaxed);
+                s.m_reads      = m_reads.load(std::memory_order_relaxed);
+                s.m_writes     = m_writes.load(std::memory_order_relaxed);
+                s.m_timeouts   = m_timeouts.load(std::memory_order_relaxed);
+                s.m_again      = m_again.load(std::memory_order_relaxed);
+                s.m_partial    = m_partial.load(std::memory_order_relaxed);
+                s.m_ready_wait = m_ready_wait.snapshot();
+                s.m_write_time = m_write_time.snapshot();
+                return s;
+            }
+            auto reset() noexcept -> void
+            {
+                for (auto* c : {&m_bytes_in, &m_bytes_out, &m_reads, &m_writes, &m_timeouts, &m_again, &m_partial}) {
+                    c->store(0, std::memory_order_relaxed);
+                }
+                m_ready_wait.reset();
+                m_write_time.reset();
+            }
+        private:
+            /// counter of one direction (single writer)
+            static auto add(std::atomic<count_type>& c, count_type n) noexcept -> void
+            {
+                c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+            /// counter of both directions
+            static auto add_shared(std::atomic<count_type>& c, count_type n) noexcept -> void
+            {
+                c.fetch_add(n, std::memory_order_relaxed);
+            }
+            static auto elapsed(time_point start) noexcept -> std::uint64_t
+            {
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+                return (ns > 0) ? static_cast<std::uint64_t>(ns) : 0;
+            }
+            std::atomic<count_type> m_bytes_in   {0};
+            std::atomic<count_type> m_bytes_out  {0};
+            std::atomic<count_type> m_reads      {0};
+            std::atomic<count_type> m_writes     {0};
+            std::atomic<count_type> m_timeouts   {0};
+            std::atomic<count_type> m_again      {0};
+            std::atomic<count_type> m_partial    {0};
+            latency_histogram       m_ready_wait {};  //!< isReady waiting time [ns]
+            latency_histogram       m_write_time {};  //!< write system call time [ns]
+        }; //<-- class ChannelStats ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  CHANNEL_STATS_Hpp ends here.
+/** @} */
@@ -32,6 +32,7 @@ namespace Sml{
         static inline constexpr return_code IO_NOT_OPEN    = IO_CUT_PARTNER - 1;
         static inline constexpr return_code IO_SUM_ERROR   = IO_NOT_OPEN    - 1;
         static inline constexpr return_code IO_OVER_RETRY  = IO_SUM_ERROR   - 1;
+        static inline constexpr return_code IO_CANCELED    = IO_OVER_RETRY  - 1;
 
         using fd_type = int;
         static inline constexpr fd_type void_fd() {return -1;}
@@ -0,0 +1,170 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file output_queue.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Output queue for coalescing small writes (Nagle like flush policy)
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef OUTPUT_QUEUE_Hpp
+# define  OUTPUT_QUEUE_Hpp
+
+# include <cerrno>
+# include <string>
+# include <sys/types.h>
+
+# include "measure_time.hpp"
+# include "io/io.hpp"
+
+namespace Sml {
+    namespace IO {
+        /*! Flush policy for OutputQueue .
+         *
+         * Pending data is flushed when one of the conditions is hit
+         * - pending size reached m_threshold
+         * - oldest pending data waited m_deadline [ms] or more
+         * - flush() was called explicitly
+         */
+        struct CoalescePolicy
+        {
+            size_type         m_threshold {256}; //!< flush size in bytes (0 mean write through)
+            millisec_interval m_deadline  {2};   //!< maximum waiting time of the oldest pending data in [ms]
+        }; //<-- struct CoalescePolicy ends here.
+
+        /*! Counters for OutputQueue .
+         */
+        struct CoalesceCounters
+        {
+            count_type m_posted   {0}; //!< number of posted (requested) writes
+            count_type m_syscalls {0}; //!< number of write system calls
+            count_type m_flushes  {0}; //!< number of flush which wrote out all pending data
+            count_type m_bytes    {0}; //!< number of written bytes
+            count_type m_partial  {0}; //!< number of partial writes
+            count_type m_again    {0}; //!< number of EAGAIN (or EWOULDBLOCK)
+            /*! Saved system calls .
+             *
+             * How many system calls did not happen compared with one write per post.
+             */
+            auto saved() const noexcept -> count_type {return (m_posted > m_syscalls) ? m_posted - m_syscalls : 0;}
+        }; //<-- struct CoalesceCounters ends here.
+
+        /*! Output queue .
+         *
+         * Coalesces the posted data into one buffer, and writes out by given writer.
+         * The writer is a callable like ssize_t(const char*, size_type) (e.g. wrapper of ::write).
+         * \note Not thread safe, use from one writer thread.
+         */
+        class OutputQueue
+        {
+        public:
+            using buffer_type   = std::string;
+            using policy_type   = CoalescePolicy;
+            using counters_type = CoalesceCounters;
+
+            OutputQueue() : OutputQueue(policy_type{}) {}
+            explicit OutputQueue(policy_type p)
+                : m_policy {p}
+                , m_pending {}
+                , m_counters {}
+                , m_timer {false}
+            {
+                m_pending.reserve(m_policy.m_threshold);
+            }
+            OutputQueue(const OutputQueue&) = delete;
+            OutputQueue& operator=(const OutputQueue&) = delete;
+            ~OutputQueue() = default;
+            /*! Append data to pending buffer .
+             *
+             *  \param[in] p head of data
+             *  \param[in] n length of data
+             */
+            auto push(const char* p, size_type n) -> void
+            {
+                ++m_counters.m_posted;
+                if (n == 0) return;
+                if (m_pending.empty()) m_timer.start(); // oldest data time stamp
+                m_pending.append(p, n);
+            }
+            /*! Check flush condition of size or deadline .
+             *
+             *  \retval true necessary flush
+             *  \retval false keep pending
+             */
+            auto due() const noexcept -> bool
+            {
+                if (m_pending.empty()) return false;
+                if (m_pending.size() >= m_policy.m_threshold) return true;
+                return (m_timer.acquire() >= (static_cast<std::int64_t>(m_policy.m_deadline) * 1000));
+            }
+            /*! Write out pending data by writer .
+             *
+             * Partial writes are continued until all data written or writer would block.
+             * Written prefix is removed, so not written data is kept for next flush.
+             *  \param[in] w writer ssize_t(const char*, size_type)
+             *  \retval IO_OK all pending data written (or nothing pending)
+             *  \retval IO_TIMEOUT writer would block (EAGAIN), remaining data is kept
+             *  \retval IO_FAILURE writer failed, remaining data is kept
+             */
+            template <typename W>
+            auto flush(W&& w) noexcept -> return_code
+            {
+                size_type done = 0;
+                return_code ret = IO_OK;
+                while (done < m_pending.size()) {
+                    auto remain = m_pending.size() - done;
+                    auto n = w(m_pending.data() + done, remain);
+                    if (n >= 0) {
+                        ++m_counters.m_syscalls;
+                        m_counters.m_bytes += static_cast<count_type>(n);
+                        done += static_cast<size_type>(n);
+                        if (static_cast<size_type>(n) < remain) ++m_counters.m_partial;
+                        continue;
+                    }
+                    errno_t num = errno;
+                    if (num == EINTR) continue;
+                    ++m_counters.m_syscalls;
+                    if (num == EAGAIN || num == EWOULDBLOCK) {
+                        ++m_counters.m_again;
+                        ret = IO_TIMEOUT;
+                    } else {
+                        ret = IO_FAILURE;
+                    }
+                    break;
+                }
+                if (done == m_pending.size()) {
+                    if (done) ++m_counters.m_flushes;
+                    m_pending.clear();
+                } else if (done) {
+                    m_pending.erase(0, done);
+                }
+                return ret;
+            }
+            /*! Discard pending data .
+             */
+            auto clear() noexcept -> void {m_pending.clear();}
+            /*! Pending data size .
+             */
+            auto pending() const noexcept -> size_type {return m_pending.size();}
+            auto empty() const noexcept -> bool {return m_pending.empty();}
+            auto policy() const noexcept -> const policy_type& {return m_policy;}
+            auto policy(policy_type p) noexcept -> void {m_policy = p;}
+            auto counters() const noexcept -> const counters_type& {return m_counters;}
+            auto reset_counters() noexcept -> void {m_counters = counters_type{};}
+        private:
+            policy_type   m_policy;   //!< flush policy
+            buffer_type   m_pending;  //!< coalesced data
+            counters_type m_counters; //!< statistics
+            MeasureTime   m_timer;    //!< waiting time of the oldest pending data
+        }; //<-- class OutputQueue ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  OUTPUT_QUEUE_Hpp ends here.
+/** @} */
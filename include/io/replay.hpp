@@ -0,0 +1,158 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file replay.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Replay of capture file through fake channel
+ *
+ * ReplayChannel is ChannelBase over pipe, m_fd is read side, so isReady, read, stats and
+ * async_read work same as real device. replay() writes received (direction::in) records
+ * of capture into the pipe at original timing (scaled by speed), sent data by write() is kept
+ * in written() for comparison with captured direction::out records.
+ *
+ *\code
+ * Sml::IO::CaptureReader cap;
+ * cap.open("serial.cap");
+ * Sml::IO::ReplayChannel ch;
+ * std::jthread feeder([&](std::stop_token st) {ch.replay(cap, 10.0, st);}); // 10 times faster
+ * while (ch.isReady(direction::in, feeder.get_stop_token(), 1000) == Sml::IO::IO_OK) ch.read(buff);
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef REPLAY_Hpp
+# define  REPLAY_Hpp
+
+# include <atomic>
+# include <condition_variable>
+# include <mutex>
+# include <stop_token>
+# include <fcntl.h>
+# include <poll.h>
+
+# include "io/capture.hpp"
+# include "io/channel.hpp"
+
+namespace Sml {
+    namespace IO {
+        /*! Fake channel fed by capture file .
+         */
+        class ReplayChannel : public ChannelBase
+        {
+        public:
+            static constexpr int all_channels = -1;
+
+            ReplayChannel()
+            {
+                int fds[2] = {-1, -1};
+                if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) == 0) {
+                    m_fd   = fds[0];
+                    m_feed = fds[1];
+                    m_status.set(status_flag::opened);
+                }
+            }
+            ~ReplayChannel()
+            {
+                if (! is_error_fd(m_feed)) ::close(m_feed);
+                if (! is_error_fd(m_fd)) ::close(m_fd);
+            }
+            auto read(byte_buffer& readed) noexcept -> return_code override
+            {
+                return static_cast<return_code>(read_some(readed.data(), readed.size()));
+            }
+            /*! Write (kept in written()) .
+             */
+            auto write(const byte_buffer& forSend) noexcept -> return_code override
+            {
+                std::lock_guard<std::mutex> lock(m_guard);
+                m_written.append(forSend);
+                return static_cast<return_code>(forSend.size());
+            }
+            /*! Feed received records of capture .
+             *
+             *  \param[in] reader capture (from current position)
+             *  \param[in] speed 1.0 original timing, 10.0 ten times faster, 0 (or less) no wait
+             *  \param[in] st stop token
+             *  \param[in] ch channel id to feed (all_channels feeds every channel)
+             *  \retval number of fed records
+             */
+            auto replay(CaptureReader& reader, double speed = 1.0, std::stop_token st = {}, int ch = all_channels) noexcept -> count_type
+            {
+                using clock = std::chrono::steady_clock;
+                CaptureView v;
+                count_type fed = 0;
+                auto start = clock::now();
+                std::uint64_t first = 0;
+                bool has_first = false;
+                while (! st.stop_requested() && reader.next(v) == IO_OK) {
+                    if (v.m_direction != direction::in || (ch != all_channels && v.m_channel != ch)) continue;
+                    if (! has_first) {
+                        first = v.m_timestamp;
+                        has_first = true;
+                    }
+                    if (speed > 0 && v.m_timestamp > first) {
+                        auto offset = std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(v.m_timestamp - first) / speed));
+                        if (! sleep_until(start + offset, st)) break;
+                    }
+                    if (feed(v.m_data, st) != IO_OK) break;
+                    ++fed;
+                }
+                m_fed.fetch_add(fed, std::memory_order_relaxed);
+                return fed;
+            }
+            /*! Data written by application .
+             */
+            auto written() const -> byte_buffer
+            {
+                std::lock_guard<std::mutex> lock(m_guard);
+                return m_written;
+            }
+            auto clear_written() -> void
+            {
+                std::lock_guard<std::mutex> lock(m_guard);
+                m_written.clear();
+            }
+            /*! Number of records fed by replay() in total .
+             */
+            auto fed() const noexcept -> count_type {return m_fed.load(std::memory_order_relaxed);}
+        private:
+            static auto sleep_until(std::chrono::steady_clock::time_point t, std::stop_token st) -> bool
+            {
+                std::mutex m;
+                std::condition_variable_any cv;
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait_until(lock, st, t, [] {return false;});
+                return ! st.stop_requested();
+            }
+            /// write whole data into pipe (waits while the reader doesn't read)
+            auto feed(std::string_view data, const std::stop_token& st) noexcept -> return_code
+            {
+                while (! data.empty()) {
+                    auto ret = ::write(m_feed, data.data(), data.size());
+                    if (ret > 0) {
+                        data.remove_prefix(static_cast<size_type>(ret));
+                        continue;
+                    }
+                    if (ret < 0 && errno != EAGAIN && errno != EINTR) return IO_FAILURE;
+                    if (st.stop_requested()) return IO_CANCELED;
+                    pollfd p {m_feed, POLLOUT, 0};
+                    ::poll(&p, 1, 10);
+                }
+                return IO_OK;
+            }
+            fd_type                 m_feed    {void_fd()}; //!< write side of pipe
+            byte_buffer             m_written {};          //!< written by application
+            mutable std::mutex      m_guard   {};          //!< for m_written
+            std::atomic<count_type> m_fed     {0};         //!< fed records (read by fed() from other thread)
+        }; //<-- class ReplayChannel ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  REPLAY_Hpp ends here.
+/** @} */
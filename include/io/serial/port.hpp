@@ -20,6 +20,7 @@
 
 # include <sys/ioctl.h>
 # include "params.hpp"
+# include "profiler.hpp"
 
 namespace Sml {
     namespace IO {
@@ -82,6 +83,8 @@ namespace Sml {
                 auto disconnect() noexcept -> return_code override
                 {
                     if (m_fd > 2) { //
+                        flush(); // best effort for pending data
+                        m_outq.clear();
                         m_status.clear();
                         m_param->ioctl()->restoreTermios(m_fd);
                         auto x =static_cast<return_code>(::close(m_fd));
@@ -94,14 +97,15 @@ namespace Sml {
                  */
                 auto write(const byte_buffer_t& buff) noexcept -> return_code override
                 {
-                    auto ret = ::write(m_fd, buff.data(), buff.size());
+                    auto ret = write_some(buff.data(), buff.size());
                     return static_cast<return_code>(ret);
                 }
                 /*! Read data .
                  */
                 auto read(byte_buffer_t& buff) noexcept -> return_code override
                 {
-                    auto ret = ::read(m_fd, buff.data(), buff.capacity());
+                    SML_PROFILE_ZONE("Port::read");
+                    auto ret = read_some(buff.data(), buff.capacity());
                     //if (ret >= 0) buff.update_tail(static_cast<size_type>(ret));
                     return static_cast<return_code>(ret);
                 }
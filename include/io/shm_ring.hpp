@@ -0,0 +1,595 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file shm_ring.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Shared memory frame ring between processes (zero copy hand-off)
+ *
+ * Mapping of memfd (inherited by fork, or passed fd) or POSIX shared memory (shm_open by name),
+ * | header page | data area (capacity bytes, power of two) |
+ *
+ * The header is the same layout as BufferBase in offsets, m_data_offset is m_head,
+ * m_data_offset + m_capacity is m_end, m_tail is written position and m_read is read position.
+ * Positions increase monotonically (64 bits), offset in data area is position & (capacity - 1).
+ *
+ * A frame is a record header (16 bytes) followed by payload, padded to 16 bytes.
+ * When a frame doesn't fit until the end of data area, a pad record fills the rest,
+ * so every frame is contiguous and can be used in place by the reader.
+ * The record kind is stored together with a tag of the reserved position (one 64 bits store),
+ * so recover() never takes stale bytes of a previous lap for a header.
+ *
+ * - SPSC one producer, reserve and commit are plain stores
+ * - MPSC many producers reserve by CAS, commit is published in reservation order
+ *
+ * Waiting is futex on words in the shared header (works across processes).
+ * Positions live in the shared memory, so a restarted consumer resumes from m_read
+ * (frames not consumed yet are delivered again), and recover() discards the frames
+ * reserved by dead producers (detected by pid) which block m_tail.
+ *
+ *\code
+ * Sml::IO::ShmRing ring;
+ * ring.create("", 1 << 20, Sml::IO::ShmRingMode::spsc); // memfd
+ * if (fork() == 0) {
+ *     Sml::IO::ShmRing::WriteSlot w;
+ *     ring.reserve(n, w);
+ *     fill(w.m_data, w.m_size);
+ *     ring.commit(w);
+ *     _exit(0);
+ * }
+ * Sml::IO::ShmRing::ReadSlot r;
+ * if (ring.peek(r, 100) == Sml::IO::IO_OK) {
+ *     use(r.m_data, r.m_size);
+ *     ring.consume(r);
+ * }
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SHM_RING_Hpp
+# define  SHM_RING_Hpp
+
+# include <atomic>
+# include <bit>
+# include <cerrno>
+# include <chrono>
+# include <climits>
+# include <csignal>
+# include <cstdint>
+# include <cstring>
+# include <ctime>
+# include <new>
+# include <string>
+# include <thread>
+# include <fcntl.h>
+# include <linux/futex.h>
+# include <pthread.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+
+# include "byte_buffer.hpp"
+# include "io/io.hpp"
+# include "signal.hpp"
+
+namespace Sml {
+    namespace IO {
+        /*! Producer mode of ShmRing .
+         */
+        enum class ShmRingMode : std::uint32_t {
+            spsc = 1, //!< single producer single consumer
+            mpsc = 2, //!< multi producer single consumer
+        };
+
+        /*! Header page of ShmRing (in shared memory) .
+         */
+        struct ShmRingHeader
+        {
+            using position = std::atomic<std::uint64_t>;
+            using word     = std::atomic<std::uint32_t>;
+
+            std::uint32_t     m_magic            {0}; //!< set last at create
+            std::uint32_t     m_version          {0};
+            ShmRingMode       m_mode             {ShmRingMode::spsc};
+            std::uint32_t     m_header_size      {0}; //!< sizeof(ShmRingHeader) for check
+            std::uint64_t     m_data_offset      {0}; //!< offset of data area (BufferBase::m_head)
+            std::uint64_t     m_capacity         {0}; //!< bytes of data area (power of two)
+            alignas(64) position m_tail          {0}; //!< published position (BufferBase::m_tail)
+            word              m_data_seq         {0}; //!< futex word for consumer
+            word              m_consumer_waiting {0}; //!< consumer is in futex wait
+            alignas(64) position m_read          {0}; //!< consumed position (BufferBase::m_read)
+            word              m_space_seq        {0}; //!< futex word for producers
+            word              m_producer_waiting {0}; //!< number of producers in futex wait
+            alignas(64) position m_reserve       {0}; //!< reserved position (>= m_tail)
+        }; //<-- struct ShmRingHeader ends here.
+
+        /*! Record header of one frame (in shared memory) .
+         *
+         * m_stamp is kind (low 32 bits) and tag of the record position (high 32 bits, position / 16),
+         * stored last with release, so length and pid are valid when the tag matches the position.
+         */
+        struct ShmRecord
+        {
+            static constexpr std::uint32_t free_kind     = 0;
+            static constexpr std::uint32_t reserved_kind = 0x56534552; //!< "RESV" written by reserve()
+            static constexpr std::uint32_t data_kind     = 0x41544144; //!< "DATA" written by commit()
+            static constexpr std::uint32_t pad_kind      = 0x20444150; //!< "PAD " skipped by consumer
+
+            static constexpr auto stamp(std::uint32_t kind, std::uint64_t pos) noexcept -> std::uint64_t
+            {
+                return ((pos >> 4) << 32) | kind;
+            }
+            static constexpr auto kind_of(std::uint64_t stamp) noexcept -> std::uint32_t {return static_cast<std::uint32_t>(stamp);}
+            /// stamp was written for the record at pos (not stale bytes of a previous lap)
+            static constexpr auto tagged(std::uint64_t stamp, std::uint64_t pos) noexcept -> bool
+            {
+                return (stamp >> 32) == static_cast<std::uint32_t>(pos >> 4);
+            }
+
+            std::atomic<std::uint64_t> m_stamp  {0}; //!< kind and position tag
+            std::uint32_t              m_length {0}; //!< payload bytes (pad: whole bytes of pad record)
+            std::int32_t               m_pid    {0}; //!< writer process
+        }; //<-- struct ShmRecord ends here.
+
+        /*! Shared memory frame ring .
+         *
+         * \note One consumer only (peek / consume / read), in both modes.
+         */
+        class ShmRing
+        {
+        public:
+            using clock     = std::chrono::steady_clock;
+            using header    = ShmRingHeader;
+            using record    = ShmRecord;
+            using pos_type  = std::uint64_t;
+
+            static constexpr std::uint32_t magic         = 0x474e5253; //!< "SRNG"
+            static constexpr std::uint32_t version       = 2;
+            static constexpr size_type     header_size   = 4096;       //!< header page
+            static constexpr size_type     record_align  = sizeof(ShmRecord);
+            static constexpr size_type     min_capacity  = 4096;
+            static constexpr count_type    spin_count    = 256;        //!< spin before futex wait (multi core only)
+            static constexpr millisec_interval recover_interval = 1;   //!< recover() period while waiting in order commit
+            static_assert(sizeof(ShmRingHeader) <= header_size, "header page");
+            static_assert(sizeof(ShmRecord) == 16, "record header");
+            static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "record stamp is shared between processes");
+
+            /*! Frame reserved by reserve(), fill m_data then commit() .
+             */
+            struct WriteSlot
+            {
+                char*     m_data  {nullptr};
+                size_type m_size  {0};
+                pos_type  m_start {0}; //!< reservation start (including pad)
+                pos_type  m_end   {0}; //!< reservation end
+            }; //<-- struct WriteSlot ends here.
+            /*! Frame peeked by peek(), valid until consume() .
+             */
+            struct ReadSlot
+            {
+                const char* m_data  {nullptr};
+                size_type   m_size  {0};
+                pos_type    m_start {0};
+                pos_type    m_end   {0};
+            }; //<-- struct ReadSlot ends here.
+
+            ShmRing() = default;
+            ShmRing(const ShmRing&) = delete;
+            ShmRing& operator=(const ShmRing&) = delete;
+            ~ShmRing() {close();}
+            /*! Create new ring .
+             *
+             *  \param[in] name POSIX shared memory name (e.g. "/sml-serial"), empty is anonymous memfd
+             *  \param[in] capacity bytes of data area (rounded up to power of two)
+             *  \param[in] mode SPSC or MPSC
+             *  \retval IO_OK created and mapped
+             *  \retval IO_FAILURE system call failed (errno is kept) or already opened
+             */
+            auto create(const std::string& name, size_type capacity, ShmRingMode mode) noexcept -> return_code
+            {
+                if (m_header) return IO_FAILURE;
+                capacity = std::bit_ceil(std::max(capacity, min_capacity));
+                auto fd = (name.empty()) ? ::memfd_create("sml-shm-ring", 0)
+                                         : ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                if (is_error_fd(fd)) return fail("create");
+                if (::ftruncate(fd, static_cast<off_t>(header_size + capacity)) < 0) {
+                    ::close(fd);
+                    if (! name.empty()) ::shm_unlink(name.c_str());
+                    return fail("ftruncate");
+                }
+                if (map(fd, header_size + capacity) != IO_OK) {
+                    if (! name.empty()) ::shm_unlink(name.c_str());
+                    return IO_FAILURE;
+                }
+                auto* h = new (m_base) header {};
+                h->m_version     = version;
+                h->m_mode        = mode;
+                h->m_header_size = sizeof(header);
+                h->m_data_offset = header_size;
+                h->m_capacity    = capacity;
+                std::atomic_ref<std::uint32_t>(h->m_magic).store(magic, std::memory_order_release);
+                bind(h);
+                return IO_OK;
+            }
+            /*! Open ring created by other process .
+             *
+             *  \param[in] name POSIX shared memory name
+             */
+            auto open(const std::string& name) noexcept -> return_code
+            {
+                if (m_header) return IO_FAILURE;
+                auto fd = ::shm_open(name.c_str(), O_RDWR, 0);
+                if (is_error_fd(fd)) return fail("shm_open");
+                return attach(fd);
+            }
+            /*! Attach ring by fd (e.g. memfd passed to exec-ed process), the fd is owned .
+             *
+             *  \retval IO_FAILURE not a ShmRing
+             */
+            auto attach(fd_type fd) noexcept -> return_code
+            {
+                if (m_header) return IO_FAILURE;
+                struct stat st {};
+                if (::fstat(fd, &st) < 0 || static_cast<size_type>(st.st_size) < header_size + min_capacity) {
+                    ::close(fd);
+                    return fail("fstat");
+                }
+                if (map(fd, static_cast<size_type>(st.st_size)) != IO_OK) return IO_FAILURE;
+                auto* h = static_cast<header*>(m_base);
+                if (std::atomic_ref<std::uint32_t>(h->m_magic).load(std::memory_order_acquire) != magic
+                    || h->m_version != version || h->m_header_size != sizeof(header)
+                    || h->m_data_offset != header_size || h->m_data_offset + h->m_capacity != m_length) {
+                    SML_ERROR("=====> not a shared memory ring");
+                    close();
+                    return IO_FAILURE;
+                }
+                bind(h);
+                return IO_OK;
+            }
+            /*! Unmap and close (the ring itself is kept while other process maps it) .
+             */
+            auto close() noexcept -> void
+            {
+                if (m_base) ::munmap(m_base, m_length);
+                if (! is_error_fd(m_fd)) ::close(m_fd);
+                m_base   = nullptr;
+                m_header = nullptr;
+                m_data   = nullptr;
+                m_fd     = void_fd();
+                m_length = 0;
+            }
+            /*! Remove name of POSIX shared memory .
+             */
+            static auto unlink(const std::string& name) noexcept -> return_code
+            {
+                return (::shm_unlink(name.c_str()) == 0) ? IO_OK : IO_FAILURE;
+            }
+            /*! Reserve one frame (producer) .
+             *
+             *  \param[in] n payload bytes (up to max_frame())
+             *  \param[out] slot reserved frame
+             *  \param[in] timeout in [ms] for free space (-1 : no timeout, 0 : no wait)
+             *  \retval IO_OK reserved, commit() must follow
+             *  \retval IO_TIMEOUT no space
+             *  \retval IO_FAILURE too large frame
+             *  \retval IO_NOT_OPEN not mapped
+             */
+            auto reserve(size_type n, WriteSlot& slot, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                if (n > max_frame()) return IO_FAILURE;
+                auto need = record_size(n);
+                auto deadline = limit(timeout);
+                auto r = m_header->m_reserve.load(std::memory_order_relaxed);
+                pos_type pad = 0;
+                for (;;) {
+                    auto offset = r & m_mask;
+                    pad = (offset + need > m_capacity) ? m_capacity - offset : 0;
+                    auto read = m_header->m_read.load(std::memory_order_acquire);
+                    if (r + pad + need - read > m_capacity) {
+                        auto ret = wait_space(r + pad + need - m_capacity, timeout, deadline);
+                        if (ret != IO_OK) return ret;
+                        r = m_header->m_reserve.load(std::memory_order_relaxed);
+                        continue;
+                    }
+                    if (m_header->m_mode == ShmRingMode::spsc) {
+                        m_header->m_reserve.store(r + pad + need, std::memory_order_relaxed);
+                        break;
+                    }
+                    if (m_header->m_reserve.compare_exchange_weak(r, r + pad + need
+                                                                 , std::memory_order_acq_rel
+                                                                 , std::memory_order_relaxed)) break;
+                }
+                if (pad) mark(r, record::pad_kind, static_cast<std::uint32_t>(pad));
+                mark(r + pad, record::reserved_kind, static_cast<std::uint32_t>(n));
+                slot = {payload(at(r + pad)), n, r, r + pad + need};
+                return IO_OK;
+            }
+            /*! Publish reserved frame (producer) .
+             *
+             * MPSC publishes in reservation order, so this waits previous producers' commit,
+             * and discards frames of dead producers by recover() while waiting.
+             */
+            auto commit(const WriteSlot& slot) noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                auto pos = slot.m_end - record_size(slot.m_size);
+                at(pos)->m_stamp.store(record::stamp(record::data_kind, pos), std::memory_order_release);
+                if (m_header->m_mode == ShmRingMode::spsc) {
+                    m_header->m_tail.store(slot.m_end, std::memory_order_release);
+                } else {
+                    auto last = clock::now();
+                    for (count_type i = 0;; ++i) {
+                        auto expected = slot.m_start;
+                        if (m_header->m_tail.compare_exchange_weak(expected, slot.m_end
+                                                                  , std::memory_order_release
+                                                                  , std::memory_order_relaxed)) break;
+                        if (expected >= slot.m_end) break; // published by recover()
+                        if (i < spin_count) {
+                            cpu_relax();
+                            continue;
+                        }
+                        std::this_thread::yield();
+                        if (clock::now() - last >= std::chrono::milliseconds(recover_interval)) {
+                            recover();
+                            last = clock::now();
+                        }
+                    }
+                }
+                notify(m_header->m_data_seq, m_header->m_consumer_waiting);
+                return IO_OK;
+            }
+            /*! Copy one frame into ring (reserve, copy and commit) .
+             */
+            auto write(const char* p, size_type n, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                WriteSlot slot;
+                auto ret = reserve(n, slot, timeout);
+                if (ret != IO_OK) return ret;
+                std::memcpy(slot.m_data, p, n);
+                return commit(slot);
+            }
+            auto write(const ByteBuffer& b, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                return write(b.const_ptr(), b.size(), timeout);
+            }
+            /*! Oldest frame in place (consumer) .
+             *
+             *  \param[out] slot frame, valid until consume()
+             *  \param[in] timeout in [ms] (-1 : no timeout, 0 : no wait)
+             *  \retval IO_OK frame available
+             *  \retval IO_TIMEOUT no frame
+             */
+            auto peek(ReadSlot& slot, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                auto deadline = limit(timeout);
+                auto read = m_header->m_read.load(std::memory_order_relaxed);
+                for (;;) {
+                    if (m_header->m_tail.load(std::memory_order_acquire) == read) {
+                        auto ret = wait_data(read, timeout, deadline);
+                        if (ret != IO_OK) return ret;
+                        continue;
+                    }
+                    auto* rec = at(read);
+                    if (record::kind_of(rec->m_stamp.load(std::memory_order_acquire)) == record::pad_kind) {
+                        auto next = read + rec->m_length;
+                        rec->m_stamp.store(record::free_kind, std::memory_order_relaxed);
+                        release(next);
+                        read = next;
+                        continue;
+                    }
+                    slot = {payload(rec), rec->m_length, read, read + record_size(rec->m_length)};
+                    return IO_OK;
+                }
+            }
+            /*! Release peeked frame (consumer) .
+             */
+            auto consume(const ReadSlot& slot) noexcept -> return_code
+            {
+                if (! m_header) return IO_NOT_OPEN;
+                at(slot.m_start)->m_stamp.store(record::free_kind, std::memory_order_relaxed);
+                release(slot.m_end);
+                return IO_OK;
+            }
+            /*! Copy one frame out of ring (peek, copy and consume) .
+             */
+            auto read(ByteBuffer& out, millisec_interval timeout = -1) noexcept -> return_code
+            {
+                ReadSlot slot;
+                auto ret = peek(slot, timeout);
+                if (ret != IO_OK) return ret;
+                out.assign(slot.m_data, slot.m_size);
+                return consume(slot);
+            }
+            /*! Discard frames reserved by dead producers .
+             *
+             * Walks from m_tail, publishes committed frames and pads out frames whose
+             * producer process doesn't exist, stops at a frame of live producer, or at
+             * a record whose header is not written yet (tag differs from the position).
+             * Call by consumer (e.g. after peek() timeout) or by restarted producer.
+             *  \retval number of discarded frames
+             */
+            auto recover() noexcept -> count_type
+            {
+                if (! m_header) return 0;
+                auto start = m_header->m_tail.load(std::memory_order_acquire);
+                auto end   = m_header->m_reserve.load(std::memory_order_acquire);
+                auto pos   = start;
+                count_type discarded = 0;
+                while (pos < end) {
+                    auto* rec = at(pos);
+                    auto stamp = rec->m_stamp.load(std::memory_order_acquire);
+                    if (! record::tagged(stamp, pos)) break; // reserved, header is not written yet
+                    auto kind = record::kind_of(stamp);
+                    if (kind == record::pad_kind && rec->m_length >= record_align && pos + rec->m_length <= end) {
+                        pos += rec->m_length;
+                    } else if (kind == record::data_kind && pos + record_size(rec->m_length) <= end) {
+                        pos += record_size(rec->m_length);
+                    } else if (kind == record::reserved_kind && pos + record_size(rec->m_length) <= end && ! alive(rec->m_pid)) {
+                        auto n = record_size(rec->m_length);
+                        mark(pos, record::pad_kind, static_cast<std::uint32_t>(n));
+                        pos += n;
+                        ++discarded;
+                    } else {
+                        break; // live producer is writing
+                    }
+                }
+                if (pos != start && m_header->m_tail.compare_exchange_strong(start, pos, std::memory_order_release)) {
+                    if (discarded) SML_INFO("discarded "s + std::to_string(discarded) + " frames of dead producer");
+                    notify(m_header->m_data_seq, m_header->m_consumer_waiting);
+                }
+                return discarded;
+            }
+            auto is_open() const noexcept -> bool {return m_header != nullptr;}
+            auto fd() const noexcept -> fd_type {return m_fd;}
+            auto mode() const noexcept -> ShmRingMode {return (m_header) ? m_header->m_mode : ShmRingMode::spsc;}
+            auto capacity() const noexcept -> size_type {return m_capacity;}
+            /*! Largest payload of one frame .
+             */
+            auto max_frame() const noexcept -> size_type {return m_capacity / 2 - record_align;}
+            /*! Bytes published but not consumed (including record headers and pads) .
+             */
+            auto size() const noexcept -> size_type
+            {
+                if (! m_header) return 0;
+                return m_header->m_tail.load(std::memory_order_acquire) - m_header->m_read.load(std::memory_order_acquire);
+            }
+            auto empty() const noexcept -> bool {return size() == 0;}
+            auto shared_header() const noexcept -> const header* {return m_header;}
+        private:
+            using time_point = clock::time_point;
+
+            static constexpr auto record_size(size_type n) noexcept -> pos_type
+            {
+                return (sizeof(ShmRecord) + n + record_align - 1) & ~(record_align - 1);
+            }
+            static auto alive(std::int32_t pid) noexcept -> bool
+            {
+                return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+            }
+            static auto fail(const char* what) noexcept -> return_code
+            {
+                SML_ERROR("=====> "s + what + " error code > "s + std::to_string(errno));
+                return IO_FAILURE;
+            }
+            static auto limit(millisec_interval timeout) noexcept -> time_point
+            {
+                return (timeout < 0) ? time_point::max() : clock::now() + std::chrono::milliseconds(timeout);
+            }
+            auto map(fd_type fd, size_type length) noexcept -> return_code
+            {
+                auto* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    return fail("mmap");
+                }
+                m_base   = p;
+                m_fd     = fd;
+                m_length = length;
+                return IO_OK;
+            }
+            auto bind(header* h) noexcept -> void
+            {
+                m_header   = h;
+                m_data     = static_cast<char*>(m_base) + h->m_data_offset;
+                m_capacity = h->m_capacity;
+                m_mask     = h->m_capacity - 1;
+            }
+            auto at(pos_type pos) const noexcept -> record* {return reinterpret_cast<record*>(m_data + (pos & m_mask));}
+            static auto payload(record* rec) noexcept -> char* {return reinterpret_cast<char*>(rec + 1);}
+            auto mark(pos_type pos, std::uint32_t kind, std::uint32_t length) noexcept -> void
+            {
+                auto* rec = at(pos);
+                rec->m_length = length;
+                rec->m_pid    = (kind == record::pad_kind) ? 0 : process_id();
+                rec->m_stamp.store(record::stamp(kind, pos), std::memory_order_release);
+            }
+            /// pid of this process (cached, cleared in child of fork)
+            static auto process_id() noexcept -> std::int32_t
+            {
+                static std::atomic<std::int32_t> pid {0};
+                [[maybe_unused]] static const int registered = ::pthread_atfork(nullptr, nullptr, [] {pid.store(0, std::memory_order_relaxed);});
+                auto p = pid.load(std::memory_order_relaxed);
+                if (p == 0) {
+                    p = static_cast<std::int32_t>(::getpid());
+                    pid.store(p, std::memory_order_relaxed);
+                }
+                return p;
+            }
+            auto release(pos_type next) noexcept -> void
+            {
+                m_header->m_read.store(next, std::memory_order_release);
+                notify(m_header->m_space_seq, m_header->m_producer_waiting);
+            }
+            static auto notify(header::word& seq, header::word& waiting) noexcept -> void
+            {
+                seq.fetch_add(1, std::memory_order_seq_cst);
+                if (waiting.load(std::memory_order_seq_cst) > 0) {
+                    ::syscall(SYS_futex, &seq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+                }
+            }
+            /*! Wait until pred() by spin then futex wait on seq .
+             */
+            template <typename P>
+            static auto wait(header::word& seq, header::word& waiting, P pred
+                           , millisec_interval timeout, time_point deadline) noexcept -> return_code
+            {
+                static const count_type spins = (std::thread::hardware_concurrency() > 1) ? spin_count : 1;
+                for (count_type i = 0; i < spins; ++i) {
+                    if (pred()) return IO_OK;
+                    if (timeout == 0) return IO_TIMEOUT;
+                    cpu_relax();
+                }
+                for (;;) {
+                    waiting.fetch_add(1, std::memory_order_seq_cst);
+                    auto current = seq.load(std::memory_order_seq_cst);
+                    if (pred()) {
+                        waiting.fetch_sub(1, std::memory_order_seq_cst);
+                        return IO_OK;
+                    }
+                    timespec rel {};
+                    if (timeout >= 0) {
+                        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - clock::now()).count();
+                        if (ns <= 0) {
+                            waiting.fetch_sub(1, std::memory_order_seq_cst);
+                            return IO_TIMEOUT;
+                        }
+                        rel.tv_sec  = ns / 1000000000;
+                        rel.tv_nsec = ns % 1000000000;
+                    }
+                    ::syscall(SYS_futex, &seq, FUTEX_WAIT, current, (timeout >= 0) ? &rel : nullptr, nullptr, 0);
+                    waiting.fetch_sub(1, std::memory_order_seq_cst);
+                }
+            }
+            auto wait_data(pos_type read, millisec_interval timeout, time_point deadline) noexcept -> return_code
+            {
+                return wait(m_header->m_data_seq, m_header->m_consumer_waiting
+                          , [this, read] {return m_header->m_tail.load(std::memory_order_seq_cst) != read;}
+                          , timeout, deadline);
+            }
+            auto wait_space(pos_type target, millisec_interval timeout, time_point deadline) noexcept -> return_code
+            {
+                return wait(m_header->m_space_seq, m_header->m_producer_waiting
+                          , [this, target] {return m_header->m_read.load(std::memory_order_seq_cst) >= target;}
+                          , timeout, deadline);
+            }
+            void*        m_base     {nullptr};   //!< mapping (header page)
+            header*      m_header   {nullptr};   //!< shared header
+            char*        m_data     {nullptr};   //!< data area
+            fd_type      m_fd       {void_fd()}; //!< memfd or shared memory
+            size_type    m_length   {0};         //!< mapped bytes
+            pos_type     m_capacity {0};         //!< bytes of data area
+            pos_type     m_mask     {0};         //!< m_capacity - 1
+        }; //<-- class ShmRing ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SHM_RING_Hpp ends here.
+/** @} */
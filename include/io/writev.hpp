@@ -0,0 +1,62 @@
+/*!
+ * \addtogroup io
+ * @{
+ * \file writev.hpp
+ *
+ * \copyright © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Gather write of ChainBuffer for ChannelBase (::writev)
+ *
+ * Include this header where ChannelBase::writev is used, so that channel.hpp
+ * itself does not depend on chain_buffer.hpp.
+ *
+ * \code
+ * Sml::ChainBuffer frame(std::move(payload));
+ * frame.prepend(header);
+ * auto ret = channel.writev(frame);
+ * if (ret > 0) frame.trim_front(static_cast<Sml::size_type>(ret));
+ * \endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef WRITEV_Hpp
+# define  WRITEV_Hpp
+
+# include <cerrno>
+# include <sys/uio.h>
+
+# include "chain_buffer.hpp"
+# include "io/channel.hpp"
+
+namespace Sml {
+    namespace IO {
+        inline auto ChannelBase::writev(const ChainBuffer& frame) noexcept -> return_code
+        {
+            if (is_error_fd(m_fd)) return IO_NOT_OPEN;
+            ::iovec iov[max_iovec];
+            auto n = frame.fill_iovec(iov);
+            size_type requested = 0;
+            for (size_type i = 0; i < n; ++i) requested += iov[i].iov_len;
+            auto start = channel_stats::now();
+            auto ret = ::writev(m_fd, iov, static_cast<int>(n));
+            m_stats.on_write(ret, requested, start);
+            if (ret < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                    m_status.set_reset(status_flag::timeouted, status_flag::ready_write);
+                    return IO_TIMEOUT;
+                }
+                m_status.set_reset(status_flag::failure, status_flag::ready_write);
+                SML_FATAL("=====> writev error in fd "s + std::to_string(m_fd) + " error code > "s + std::to_string(errno));
+                return IO_FAILURE;
+            }
+            return static_cast<return_code>(ret);
+        }
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  WRITEV_Hpp ends here.
+/** @} */
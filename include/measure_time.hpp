@@ -117,6 +117,14 @@ namespace Sml {
         {
             return std::chrono::duration_cast<std::chrono::microseconds>(system_clock::now() - m_time).count();
         }
+        /*!  aquire time in nanoseconds.
+         *
+         * Same as acquire, but nanoseconds unit (for latency histogram)
+         */
+        auto acquire_ns() const noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(system_clock::now() - m_time).count();
+        }
     private:
         time_point m_time;   //!< for mark start time stamp
         bool       m_flag;   //!<
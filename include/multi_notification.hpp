@@ -0,0 +1,163 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file multi_notification.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Multi subscriber notification (one event to many receivers)
+ *
+ * The subscriber list is immutable snapshot (copy on write).
+ * notify() only loads current snapshot and calls receivers without lock,
+ * connect()/disconnect() copy the list, modify and publish new snapshot.
+ * So notify can run concurrently with connect/disconnect (rarely called).
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_MULTI_NOTIFICATION_Hpp
+# define  SML_MULTI_NOTIFICATION_Hpp
+
+# include <atomic>
+# include <memory>
+# include <mutex>
+# include <vector>
+
+# include "debug.hpp"
+# include "inplace_function.hpp"
+
+namespace Sml {
+    /*! Connection handle of MultiNotification .
+     */
+    struct Connection
+    {
+        using id_type = std::uint64_t;
+        static constexpr id_type void_id = 0;
+
+        constexpr Connection() = default;
+        constexpr explicit Connection(id_type id) : m_id {id} {}
+        constexpr auto id() const noexcept -> id_type {return m_id;}
+        constexpr explicit operator bool() const noexcept {return m_id != void_id;}
+        friend constexpr bool operator==(const Connection&, const Connection&) = default;
+        id_type m_id {void_id}; //!< connection id (0 is not connected)
+    }; //<-- struct Connection ends here.
+
+    /*! Multi subscriber notification .
+     *
+     * \note Receiver called from notify() after disconnect() is possible while the old snapshot is used by other thread.
+     *  \tparam Args Argument type of receivers
+     */
+    template <typename... Args>
+    class MultiNotification
+    {
+    public:
+        using reciver_type  = InplaceFunction<return_code(Args...)>; //!< callback
+        using slot_type     = std::pair<Connection::id_type, std::shared_ptr<reciver_type>>;
+        using slots_type    = std::vector<slot_type>;
+        using snapshot_type = std::shared_ptr<const slots_type>;
+        using lock_type     = std::mutex;
+        using guard         = std::lock_guard<lock_type>;
+
+        MultiNotification() : m_slots {std::make_shared<const slots_type>()} {}
+        MultiNotification(const MultiNotification&) = delete;
+        MultiNotification(MultiNotification&&) noexcept = delete;
+        MultiNotification& operator=(const MultiNotification&) = delete;
+        MultiNotification& operator=(MultiNotification&&) noexcept = delete;
+        ~MultiNotification() = default;
+        /*! Connect callable (function, lambda or functor) .
+         *
+         *  \retval Connection handle for disconnect
+         */
+        template <typename T>
+        auto connect(T&& func) -> Connection
+        {
+            return add(std::make_shared<reciver_type>(std::forward<T>(func)));
+        }
+        /*! Connect member function .
+         *
+         *  \param[in] mf member function
+         *  \param[in] instance of class pointer (not owned)
+         *  \retval Connection handle for disconnect
+         */
+        template <class C, typename T>
+        requires std::is_member_function_pointer_v<T>
+        auto connect(T mf, C* instance) -> Connection
+        {
+            return connect([mf, instance](Args... a) -> return_code {return (instance->*mf)(std::forward<Args>(a)...);});
+        }
+        /*! Disconnect subscriber .
+         *
+         *  \retval OK disconnected
+         *  \retval NO_DATA the connection was not found
+         */
+        auto disconnect(Connection c) -> return_code
+        {
+            guard lock(m_guard);
+            auto current = m_slots.load(std::memory_order_acquire);
+            auto next = std::make_shared<slots_type>();
+            next->reserve(current->size());
+            for (const auto& s : *current) {
+                if (s.first != c.id()) next->push_back(s);
+            }
+            if (next->size() == current->size()) return NO_DATA;
+            m_slots.store(std::move(next), std::memory_order_release);
+            return OK;
+        }
+        /*! Disconnect all subscribers .
+         */
+        auto disconnect_all() -> void
+        {
+            guard lock(m_guard);
+            m_slots.store(std::make_shared<const slots_type>(), std::memory_order_release);
+        }
+        /*! Notify to all subscribers .
+         *
+         *  \param[inout] args is argument(s) for callback
+         *  \retval OK all receivers returned OK
+         *  \retval first not OK return code of receivers
+         *  \retval FAILURE no subscriber
+         */
+        auto notify(Args... args) noexcept -> return_code
+        {
+            auto snapshot = m_slots.load(std::memory_order_acquire);
+            if (snapshot->empty()) return FAILURE;
+            return_code ret = OK;
+            for (const auto& s : *snapshot) {
+                auto r = (*s.second)(args...);
+                if (ret == OK && r != OK) ret = r;
+            }
+            return ret;
+        }
+        /*! Functor for notify .
+         */
+        auto operator()(Args... args) noexcept {return notify(args...);}
+        /*! Number of subscribers .
+         */
+        auto size() const noexcept -> size_type {return m_slots.load(std::memory_order_acquire)->size();}
+        operator bool() const noexcept {return size() != 0;}
+        /*! Current subscriber list (for diagnostics) .
+         */
+        auto snapshot() const noexcept -> snapshot_type {return m_slots.load(std::memory_order_acquire);}
+    private:
+        auto add(std::shared_ptr<reciver_type> r) -> Connection
+        {
+            guard lock(m_guard);
+            auto current = m_slots.load(std::memory_order_acquire);
+            auto next = std::make_shared<slots_type>(*current);
+            Connection c {++m_last_id};
+            next->emplace_back(c.id(), std::move(r));
+            m_slots.store(std::move(next), std::memory_order_release);
+            return c;
+        }
+        std::atomic<snapshot_type> m_slots   {};  //!< published subscriber list
+        lock_type                  m_guard   {};  //!< serialize writers (connect / disconnect)
+        Connection::id_type        m_last_id {0}; //!< last issued connection id
+    }; //<-- class MultiNotification ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_MULTI_NOTIFICATION_Hpp ends here.
+/** @} */
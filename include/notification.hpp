@@ -24,6 +24,8 @@
 # include <memory>
 
 # include "debug.hpp"
+# include "inplace_function.hpp"
+# include "profiler.hpp"
 
 
 namespace Sml {
@@ -141,6 +143,7 @@ namespace Sml {
          */
         auto notify(Args... args) noexcept
         {
+            SML_PROFILE_ZONE("Notification::notify");
             int ret = FAILURE;
             if (m_reciver) { // is valid reciver
                 try {
@@ -246,6 +249,110 @@ namespace Sml {
     inline void connect(Notification<A...> *n, T &&mf, AA... a) {
       n->connect(mf, a...);
     }
+
+    /*! Notification with allocation free receiver .
+     *
+     * Same usage as Notification, but the receiver is stored in Receiver (InplaceFunction or FunctionRef)
+     * instead of std::function + std::bind, and notify() is not wrapped by try/catch.
+     * \warning The receiver must not throw (notify is noexcept, so std::terminate is called).
+     *  \tparam Receiver callable holder for return_code(Args...)
+     *  \tparam Args Argument type of a member function (callback) that receives an event
+     */
+    template <typename Receiver, typename... Args>
+    class BasicNotification
+    {
+    public:
+        using reciver_type = Receiver; //!< callback
+        /*! Default constructor .
+         */
+        BasicNotification() = default;
+        /*! Constructor with callable (function, lambda or functor) .
+         */
+        template <typename T>
+        requires (! std::is_same_v<std::remove_cvref_t<T>, BasicNotification> && std::is_constructible_v<reciver_type, T&&>)
+        BasicNotification(T&& func) : m_reciver {std::forward<T>(func)} {}
+        /*! Constructor with member function and instance .
+         */
+        template <class C, typename T>
+        requires std::is_member_function_pointer_v<T>
+        BasicNotification(T mf, C* instance) {connect(mf, instance);}
+        BasicNotification(BasicNotification&&) noexcept = default;
+        BasicNotification& operator=(BasicNotification&&) noexcept = default;
+        BasicNotification(const BasicNotification&) = delete;
+        BasicNotification& operator=(const BasicNotification&) = delete;
+        ~BasicNotification() = default;
+        /*! Connect callable (function, lambda or functor) .
+         */
+        template <typename T>
+        requires std::is_constructible_v<reciver_type, T&&>
+        auto connect(T&& func) noexcept(std::is_nothrow_constructible_v<reciver_type, T&&>) {m_reciver = reciver_type(std::forward<T>(func));}
+        /*! Connect member function (raw pointer version) .
+         *
+         * Only owning receiver (InplaceFunction), for FunctionRef use connect<&C::mf>(instance)
+         */
+        template <class C, typename T>
+        requires std::is_member_function_pointer_v<T>
+        auto connect(T mf, C* instance) noexcept
+        {
+            m_reciver = reciver_type([mf, instance](Args... a) -> return_code {return (instance->*mf)(std::forward<Args>(a)...);});
+        }
+        /*! Connect member function (shared pointer version, instance is not owned) .
+         */
+        template <class C, typename T>
+        requires std::is_member_function_pointer_v<T>
+        auto connect(T mf, const std::shared_ptr<C>& instance) noexcept {connect(mf, instance.get());}
+        /*! Connect member function given as template argument .
+         *
+         * Member function pointer is a compile time constant, only instance pointer is stored.
+         *  \tparam MF member function pointer
+         */
+        template <auto MF, class C>
+        auto connect(C* instance) noexcept
+        {
+            if constexpr (requires {reciver_type::template bind<MF>(instance);}) {
+                m_reciver = reciver_type::template bind<MF>(instance);
+            } else {
+                m_reciver = reciver_type([instance](Args... a) -> return_code {return std::invoke(MF, instance, std::forward<Args>(a)...);});
+            }
+        }
+        /*! Disconnect receiver .
+         */
+        auto disconnect() noexcept {m_reciver = reciver_type();}
+        /*! Execute callback(reciver function)
+         *
+         *  \param[inout] args is argument(s) for callback
+         *  \retval return value of callback
+         *  \retval FAILURE no receiver
+         */
+        auto notify(Args... args) noexcept -> return_code
+        {
+            if (m_reciver) [[likely]] {
+                return m_reciver(std::forward<Args>(args)...);
+            }
+            SML_ERROR("====> Notification :: No assignment receiver function(no callback)!! please setup me!!");
+            return FAILURE;
+        }
+        /*! Functor for notify .
+         */
+        auto operator()(Args... args) noexcept {return notify(std::forward<Args>(args)...);}
+        /*!  Valid reciver check.
+         */
+        operator bool() const noexcept {return static_cast<bool>(m_reciver);}
+    private:
+        reciver_type m_reciver {}; //!< notify reciver
+    }; //<-- class BasicNotification ends here.
+    /*! Notification with inline (fixed capacity) receiver storage .
+     *
+     *  \tparam N inline capacity in bytes (the capture over N is compile error)
+     */
+    template <size_type N, typename... Args>
+    using InplaceNotification = BasicNotification<InplaceFunction<return_code(Args...), N>, Args...>;
+    /*! Notification with non owning receiver (function_ref) .
+     *
+     * \warning The connected callable (or instance) must outlive the notification.
+     */
+    template <typename... Args>
+    using NotificationRef = BasicNotification<FunctionRef<return_code(Args...)>, Args...>;
     } // namespace Sml
 
 #endif //<-- macro  SML_NOTIFICATION_Hpp ends here.
@@ -0,0 +1,380 @@
+/*!
+ * \file profiler.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Scoped profiler (RAII zone, per thread event buffer, Chrome trace export)
+ *
+ * - Zone is measured by time stamp counter (rdtsc on x86, steady_clock otherwise),
+ *   the counter is calibrated against MeasureTime::system_clock (steady_clock) on enable().
+ * - Each thread records into own fixed size buffer (no lock, no allocation on record),
+ *   events over the capacity are dropped and counted. Buffer of exited thread is kept
+ *   for output until clear().
+ * - write_chrome_trace() outputs JSON for chrome://tracing or Perfetto.
+ *
+ * Recording is off by default, Profiler::enable() turns on at run time.
+ * Define SML_PROFILE_DISABLE for compile out all zones.
+ *
+ *\code
+ * auto foo() {
+ *     SML_PROFILE_ZONE("foo");
+ *     ...
+ * }
+ * Sml::Profiler::enable();
+ * foo();
+ * Sml::Profiler::disable();
+ * Sml::Profiler::write_chrome_trace(std::cout);
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_PROFILER_Hpp
+# define  SML_PROFILER_Hpp
+
+# include <atomic>
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <ostream>
+# include <string>
+# include <vector>
+# include <unistd.h>
+# if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+# endif
+
+# include "measure_time.hpp"
+
+namespace Sml {
+    /*! Time stamp counter .
+     *
+     * \note Assumes invariant TSC (constant rate, synchronized between cores) on x86.
+     */
+    struct TscClock
+    {
+        using tick_type = std::uint64_t;
+        using reference = MeasureTime::system_clock;
+
+        static auto now() noexcept -> tick_type
+        {
+# if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+# else
+            return static_cast<tick_type>(std::chrono::duration_cast<std::chrono::nanoseconds>(reference::now().time_since_epoch()).count());
+# endif
+        }
+    }; //<-- struct TscClock ends here.
+
+    /*! Static information of profiling point (one per source location) .
+     */
+    struct ProfileSite
+    {
+        const char*   m_name; //!< zone name
+        const char*   m_file; //!< source file
+        std::uint32_t m_line; //!< source line
+    }; //<-- struct ProfileSite ends here.
+
+    /*! One measured zone .
+     */
+    struct ProfileEvent
+    {
+        const ProfileSite*   m_site;  //!< where
+        TscClock::tick_type  m_begin; //!< zone start tick
+        TscClock::tick_type  m_end;   //!< zone end tick
+    }; //<-- struct ProfileEvent ends here.
+
+    /*! Per thread event buffer .
+     *
+     * Single writer (owner thread), the reader reads [0, size()) after acquire.
+     */
+    class ProfileBuffer
+    {
+    public:
+        explicit ProfileBuffer(size_type capacity)
+            : m_events {std::make_unique<ProfileEvent[]>(capacity)}
+            , m_capacity {capacity}
+            , m_tid {static_cast<std::uint32_t>(::gettid())}
+        {}
+        ProfileBuffer(const ProfileBuffer&) = delete;
+        ProfileBuffer& operator=(const ProfileBuffer&) = delete;
+        ~ProfileBuffer() = default;
+        auto push(const ProfileEvent& e) noexcept -> void
+        {
+            auto n = m_size.load(std::memory_order_relaxed);
+            if (n == m_capacity) [[unlikely]] {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            m_events[n] = e;
+            m_size.store(n + 1, std::memory_order_release);
+        }
+        auto size() const noexcept -> size_type {return m_size.load(std::memory_order_acquire);}
+        auto at(size_type i) const noexcept -> const ProfileEvent& {return m_events[i];}
+        auto dropped() const noexcept -> count_type {return m_dropped.load(std::memory_order_relaxed);}
+        auto tid() const noexcept -> std::uint32_t {return m_tid;}
+        /*! Owner thread exited .
+         */
+        auto retired() const noexcept -> bool {return m_retired.load(std::memory_order_acquire);}
+        auto clear() noexcept -> void
+        {
+            m_size.store(0, std::memory_order_release);
+            m_dropped.store(0, std::memory_order_relaxed);
+        }
+    private:
+        friend class Profiler;
+        std::unique_ptr<ProfileEvent[]> m_events;        //!< fixed size storage
+        size_type                       m_capacity;      //!< number of events
+        std::uint32_t                   m_tid;           //!< owner thread id (gettid)
+        std::string                     m_name {};       //!< owner thread name (guarded by Profiler lock)
+        std::atomic<size_type>          m_size {0};      //!< number of recorded events
+        std::atomic<count_type>         m_dropped {0};   //!< number of events over capacity
+        std::atomic<bool>               m_retired {false}; //!< owner thread exited
+    }; //<-- class ProfileBuffer ends here.
+
+    /*! Profiler (process wide registry of thread buffers) .
+     */
+    class Profiler
+    {
+    public:
+        using buffer_ptr = std::shared_ptr<ProfileBuffer>;
+        using lock_type  = std::mutex;
+        using guard      = std::lock_guard<lock_type>;
+
+        static constexpr size_type default_capacity = 65536; //!< events per thread
+
+        /*! Calibrate and start recording .
+         */
+        static auto enable() -> void
+        {
+            calibrate();
+            s_enabled.store(true, std::memory_order_release);
+        }
+        static auto disable() noexcept -> void {s_enabled.store(false, std::memory_order_release);}
+        static auto enabled() noexcept -> bool {return s_enabled.load(std::memory_order_relaxed);}
+        /*! Events capacity of thread buffer (effective for not yet recorded thread) .
+         */
+        static auto capacity(size_type n) noexcept -> void {s_capacity.store(n, std::memory_order_relaxed);}
+        /*! Record event to the buffer of calling thread .
+         */
+        static auto record(const ProfileSite& site, TscClock::tick_type begin, TscClock::tick_type end) noexcept -> void
+        {
+            auto* b = local();
+            if (b == nullptr) [[unlikely]] b = attach();
+            if (b) b->push(ProfileEvent {&site, begin, end});
+        }
+        /*! Name of calling thread in trace output .
+         */
+        static auto thread_name(const std::string& name) -> void
+        {
+            auto* b = local();
+            if (b == nullptr) b = attach();
+            if (b) {
+                guard lock(registry().m_guard);
+                b->m_name = name;
+            }
+        }
+        /*! Convert tick to nanoseconds from calibration point .
+         */
+        static auto to_ns(TscClock::tick_type tick) noexcept -> double
+        {
+            auto& c = registry();
+            return (static_cast<double>(tick) - static_cast<double>(c.m_base_tick)) * c.m_ns_per_tick;
+        }
+        static auto ns_per_tick() noexcept -> double {return registry().m_ns_per_tick;}
+        /*! Rate of TscClock, calibrated once here when enable() is not called yet .
+         */
+        static auto calibrated_ns_per_tick() -> double
+        {
+            auto& r = registry();
+            {
+                guard lock(r.m_guard);
+                if (r.m_base_tick != 0) return r.m_ns_per_tick;
+            }
+            calibrate();
+            guard lock(r.m_guard);
+            return r.m_ns_per_tick;
+        }
+        /*! Number of recorded events of all threads .
+         */
+        static auto size() -> size_type
+        {
+            auto& r = registry();
+            guard lock(r.m_guard);
+            size_type n = 0;
+            for (const auto& b : r.m_buffers) n += b->size();
+            return n;
+        }
+        /*! Number of registered thread buffers (including exited threads until clear()) .
+         */
+        static auto buffers() -> size_type
+        {
+            auto& r = registry();
+            guard lock(r.m_guard);
+            return r.m_buffers.size();
+        }
+        static auto dropped() -> count_type
+        {
+            auto& r = registry();
+            guard lock(r.m_guard);
+            count_type n = 0;
+            for (const auto& b : r.m_buffers) n += b->dropped();
+            return n;
+        }
+        /*! Discard recorded events, and release buffers of exited threads .
+         *
+         * \warning Call after disable() and recording threads quiesced.
+         */
+        static auto clear() -> void
+        {
+            auto& r = registry();
+            guard lock(r.m_guard);
+            std::erase_if(r.m_buffers, [](const buffer_ptr& b) {return b->retired();});
+            for (auto& b : r.m_buffers) b->clear();
+        }
+        /*! Output recorded events as Chrome trace event format (JSON) .
+         *
+         * Complete events ("ph":"X") with ts/dur in micro seconds, and thread name metadata.
+         * \warning Call after disable(), or events recorded during output may be omitted.
+         */
+        static auto write_chrome_trace(std::ostream& os) -> void
+        {
+            auto& r = registry();
+            guard lock(r.m_guard);
+            const auto pid = ::getpid();
+            bool first = true;
+            auto separator = [&]() -> std::ostream& {
+                if (! first) os << ",\n";
+                first = false;
+                return os;
+            };
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+            for (const auto& b : r.m_buffers) {
+                if (! b->m_name.empty()) {
+                    separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << b->tid()
+                                << ",\"args\":{\"name\":\"" << escape(b->m_name.c_str()) << "\"}}";
+                }
+                auto n = b->size();
+                for (size_type i = 0; i < n; ++i) {
+                    const auto& e = b->at(i);
+                    auto ts  = to_ns(e.m_begin) / 1000.0;
+                    auto dur = static_cast<double>(e.m_end - e.m_begin) * r.m_ns_per_tick / 1000.0;
+                    separator() << "{\"name\":\"" << escape(e.m_site->m_name) << "\",\"cat\":\"sml\",\"ph\":\"X\""
+                                << ",\"ts\":" << ts << ",\"dur\":" << dur
+                                << ",\"pid\":" << pid << ",\"tid\":" << b->tid()
+                                << ",\"args\":{\"file\":\"" << escape(e.m_site->m_file) << "\",\"line\":" << e.m_site->m_line << "}}";
+                }
+            }
+            os << "\n]}\n";
+        }
+    private:
+        struct registry_type
+        {
+            lock_type               m_guard       {};
+            std::vector<buffer_ptr> m_buffers     {};
+            TscClock::tick_type     m_base_tick   {0};   //!< tick at calibration
+            double                  m_ns_per_tick {1.0}; //!< calibrated rate
+        };
+        static auto registry() noexcept -> registry_type&
+        {
+            static registry_type r;
+            return r;
+        }
+        /// buffer of calling thread, marked retired on thread exit
+        struct owner_type
+        {
+            ProfileBuffer* m_buffer {nullptr};
+            ~owner_type()
+            {
+                if (m_buffer) m_buffer->m_retired.store(true, std::memory_order_release);
+            }
+        };
+        static auto local() noexcept -> ProfileBuffer*&
+        {
+            thread_local owner_type owner;
+            return owner.m_buffer;
+        }
+        /// create and register buffer of calling thread (kept after thread exit for output until clear())
+        static auto attach() noexcept -> ProfileBuffer*
+        {
+            try {
+                auto b = std::make_shared<ProfileBuffer>(s_capacity.load(std::memory_order_relaxed));
+                auto& r = registry();
+                guard lock(r.m_guard);
+                std::erase_if(r.m_buffers, [](const buffer_ptr& e) {return e->retired() && e->size() == 0;});
+                r.m_buffers.push_back(b);
+                local() = b.get();
+            } catch (...) {
+                disable();
+                return nullptr;
+            }
+            return local();
+        }
+        /// measure tick rate against steady_clock (about 10ms busy wait)
+        static auto calibrate() -> void
+        {
+            using namespace std::chrono;
+            auto& r = registry();
+            auto t0 = TscClock::reference::now();
+            auto c0 = TscClock::now();
+            while (TscClock::reference::now() - t0 < milliseconds(10)) {}
+            auto t1 = TscClock::reference::now();
+            auto c1 = TscClock::now();
+            auto ns = static_cast<double>(duration_cast<nanoseconds>(t1 - t0).count());
+            guard lock(r.m_guard);
+            if (r.m_base_tick == 0) r.m_base_tick = c0; // keep time origin of already recorded events
+            r.m_ns_per_tick = (c1 > c0) ? ns / static_cast<double>(c1 - c0) : 1.0;
+        }
+        static auto escape(const char* s) -> std::string
+        {
+            std::string out;
+            for (; s && *s; ++s) {
+                if (*s == '"' || *s == '\\') out.push_back('\\');
+                if (static_cast<unsigned char>(*s) >= 0x20) out.push_back(*s);
+            }
+            return out;
+        }
+        static inline std::atomic<bool>      s_enabled  {false};
+        static inline std::atomic<size_type> s_capacity {default_capacity};
+    }; //<-- class Profiler ends here.
+
+    /*! RAII profiling zone .
+     */
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const ProfileSite& site) noexcept
+            : m_site {Profiler::enabled() ? &site : nullptr}
+            , m_begin {m_site ? TscClock::now() : 0}
+        {}
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+        ~ProfileZone()
+        {
+            if (m_site) Profiler::record(*m_site, m_begin, TscClock::now());
+        }
+    private:
+        const ProfileSite*  m_site;  //!< nullptr when profiler disabled at zone start
+        TscClock::tick_type m_begin; //!< start tick
+    }; //<-- class ProfileZone ends here.
+} //<-- namespace Sml ends here.
+
+# define SML_PROFILE_CONCAT_IMPL(a, b) a##b
+# define SML_PROFILE_CONCAT(a, b) SML_PROFILE_CONCAT_IMPL(a, b)
+# if defined(SML_PROFILE_DISABLE)
+#  define SML_PROFILE_ZONE(name) do {} while (0)
+# else
+/*! Profile from here to end of scope .
+ *
+ *  \param[in] name string literal
+ */
+#  define SML_PROFILE_ZONE(name)                                                                          \
+    static constexpr ::Sml::ProfileSite SML_PROFILE_CONCAT(sml_profile_site_, __LINE__) {name, __FILE__, __LINE__}; \
+    ::Sml::ProfileZone SML_PROFILE_CONCAT(sml_profile_zone_, __LINE__) {SML_PROFILE_CONCAT(sml_profile_site_, __LINE__)}
+# endif
+
+#endif //<-- macro  SML_PROFILER_Hpp ends here.
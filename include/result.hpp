@@ -14,7 +14,9 @@
 #ifndef SML_RESULT_Hpp
 # define  SML_RESULT_Hpp
 
-// # include <type_traits>
+# include <functional>
+# include <memory>
+# include <type_traits>
 # include "sml.hpp"
 # if 0
 # define SML_TRACE 1
@@ -54,30 +56,39 @@ namespace Sml {
     /*! Result type checker .
      *
      *  \tparam T is result value type
+     *  \note copy constructible is not required (move only type e.g. std::unique_ptr is allowed)
      */
     template <typename T>
     using is_result_requirement = std::conjunction<
-        std::is_copy_constructible<T>
-        , std::is_move_constructible<T>
+        std::is_move_constructible<T>
         , std::negation<std::is_reference<T>>
         , std::negation<std::is_pointer<T>>
         , std::negation<std::is_same<error_type, T>>
         >;
+
+    template <typename T> class Result;
+
+    template <typename T>
+    struct is_result : std::false_type {};
+    template <typename T>
+    struct is_result<Result<T>> : std::true_type {};
+    template <typename T>
+    inline constexpr bool is_result_v = is_result<std::remove_cvref_t<T>>::value;
     /*! Result class .
      *
      * This class can propagate value_type or error_type to caller as appropriate.
      *
-     *  \tparam T value_type has constraint, that is movable, copyable, not error_type, not pointer and not reference.
+     *  \tparam T value_type has constraint, that is movable, not error_type, not pointer and not reference.
      */
     template <typename T>
     class Result
     {
-        static_assert(is_result_requirement<T>::value, "Necessary the typename T can be copy and move constructible and Not pointer and reference");
-        using value_type = T;
-        using reference = Result<value_type>&;
-        using const_reference = const Result<value_type>&;
-        using rvalue_reference = Result<value_type>&&;
+        static_assert(is_result_requirement<T>::value, "Necessary the typename T can be move constructible and Not pointer and reference");
+        using reference = Result<T>&;
+        using const_reference = const Result<T>&;
+        using rvalue_reference = Result<T>&&;
     public:
+        using value_type = T;
         /*! constructor 1 .
          *
          * No effect...
@@ -87,17 +98,19 @@ namespace Sml {
          *
          * for create result value from value_type reference
          */
-        constexpr explicit Result(const value_type& v) : m_has_value(true) {construct_value(v);}
+        constexpr explicit Result(const value_type& v) requires std::is_copy_constructible_v<value_type> : m_has_value(true) {construct_value(v);}
         /*! constructor 3 .
          *
          * for create result value from value_type rvalue reference
          */
-        constexpr explicit Result(value_type&& v) : m_has_value(true) {construct_value(v);}
+        constexpr explicit Result(value_type&& v) : m_has_value(true) {construct_value(std::move(v));}
         /*! constructor 4 .
          *
          * for create result value with the result object constructing
          */
-        template <class... Args> constexpr Result(Args... args) : m_has_value(true) {construct_value(args ...);}
+        template <class... Args>
+        requires (std::is_constructible_v<value_type, Args&&...> && ! (sizeof...(Args) == 1 && (is_result_v<Args> && ...)))
+        constexpr Result(Args&&... args) : m_has_value(true) {construct_value(std::forward<Args>(args)...);}
         // error_type result
         /*! constructor 5 .
          *
@@ -108,23 +121,48 @@ namespace Sml {
          *
          * for create error value from error_type rvalue reference
          */
-        constexpr explicit Result(error_type&& e) : m_has_value(false) {construct_error(e);}
-        // /*! constructor 7 .
-        //  *
-        //  * for create result value with the result object constructing
-        //  */
-        // template < class Arg > constexpr Result(Arg arg) : m_has_value(false) {construct_error(arg);}
-        // copy move delete
-        //Result(const_reference) = delete;
-        //Result(rvalue_reference) = delete;
-        // reference operator=(const_reference) = delete;
-        // reference operator=(rvalue_reference) = delete;
-        ~Result()
+        constexpr explicit Result(error_type&& e) : m_has_value(false) {construct_error(std::move(e));}
+        /*! Copy constructor (only copyable value_type) .
+         */
+        constexpr Result(const_reference rhs) requires std::is_copy_constructible_v<value_type>
+            : m_has_value(rhs.m_has_value)
         {
-            if constexpr (! std::is_trivially_destructible_v<value_type>) {
-                // if !m_has_value maybe not constructed
-                if (m_has_value) m_value.~T(); // call destructor
+            if (m_has_value) construct_value(rhs.m_value); else construct_error(rhs.m_error);
+        }
+        /*! Move constructor .
+         *
+         * rhs keeps has_value state, but the value is moved from.
+         */
+        constexpr Result(rvalue_reference rhs) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+            : m_has_value(rhs.m_has_value)
+        {
+            if (m_has_value) construct_value(std::move(rhs.m_value)); else construct_error(rhs.m_error);
+        }
+        /*! Copy assign operator (only copyable value_type) .
+         */
+        reference operator=(const_reference rhs) requires std::is_copy_constructible_v<value_type>
+        {
+            if (this != &rhs) {
+                destroy();
+                m_has_value = rhs.m_has_value;
+                if (m_has_value) construct_value(rhs.m_value); else construct_error(rhs.m_error);
             }
+            return *this;
+        }
+        /*! Move assign operator .
+         */
+        reference operator=(rvalue_reference rhs) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+        {
+            if (this != &rhs) {
+                destroy();
+                m_has_value = rhs.m_has_value;
+                if (m_has_value) construct_value(std::move(rhs.m_value)); else construct_error(rhs.m_error);
+            }
+            return *this;
+        }
+        ~Result()
+        {
+            destroy();
             // error_type class allways trivially desutructible
             static_assert(std::is_trivially_destructible_v<error_type>, "All way true!!");
         }
@@ -132,9 +170,38 @@ namespace Sml {
         /*!  resut value getter.
          *
          * if has_value is true
-         *  \retval value in value_type (T)
+         *  \retval value in value_type (T) by reference, no copy
+         */
+        constexpr auto value() & noexcept -> value_type& {return this->m_value;}
+        /*!  resut value getter (const).
+         *
+         *  \retval value in value_type (T) by const reference, no copy
+         */
+        constexpr auto value() const& noexcept -> const value_type& {return this->m_value;}
+        /*!  resut value getter (rvalue).
+         *
+         * Move out the value from expiring Result. e.g. auto v = std::move(r).value();
+         *  \retval value in value_type (T) by rvalue reference
+         */
+        constexpr auto value() && noexcept -> value_type&& {return std::move(this->m_value);}
+        /*! Value or default value .
+         *
+         *  \param[in] d default value, when has not value
+         */
+        template <typename U>
+        constexpr auto value_or(U&& d) const& -> value_type
+        {
+            return (m_has_value) ? m_value : static_cast<value_type>(std::forward<U>(d));
+        }
+        /*! Value or default value (rvalue) .
+         *
+         *  \param[in] d default value, when has not value
          */
-        constexpr auto value() const noexcept -> value_type {return this->m_value;}
+        template <typename U>
+        constexpr auto value_or(U&& d) && -> value_type
+        {
+            return (m_has_value) ? std::move(m_value) : static_cast<value_type>(std::forward<U>(d));
+        }
         /*! error Result getter .
          *
          * if !has_value
@@ -142,7 +209,7 @@ namespace Sml {
          * if you need value, use error_type::code() function
          */
         constexpr auto error() const noexcept {return this->m_error();}
-        auto error(error_type&& e) noexcept {construct_error(e);}
+        auto error(error_type&& e) noexcept {destroy(); m_has_value = false; construct_error(std::move(e));}
         /*! Check for existence of value.
          *
          *  \retval ture value existence
@@ -154,7 +221,67 @@ namespace Sml {
          *
          */
         constexpr operator bool() const noexcept {return m_has_value;}
+        //////////////
+        // monadic
+        //////////////
+        /*! Chain function returning Result .
+         *
+         * f(value) is called when has value, otherwise error is propagated.
+         *  \tparam F callable value_type -> Result<U>
+         */
+        template <typename F> constexpr auto and_then(F&& f) &      {return and_then_impl(*this, std::forward<F>(f));}
+        template <typename F> constexpr auto and_then(F&& f) const& {return and_then_impl(*this, std::forward<F>(f));}
+        template <typename F> constexpr auto and_then(F&& f) &&     {return and_then_impl(std::move(*this), std::forward<F>(f));}
+        /*! Transform value .
+         *
+         * f(value) is called when has value and wrapped by Result<U>, otherwise error is propagated.
+         *  \tparam F callable value_type -> U
+         */
+        template <typename F> constexpr auto transform(F&& f) &      {return transform_impl(*this, std::forward<F>(f));}
+        template <typename F> constexpr auto transform(F&& f) const& {return transform_impl(*this, std::forward<F>(f));}
+        template <typename F> constexpr auto transform(F&& f) &&     {return transform_impl(std::move(*this), std::forward<F>(f));}
+        /*! Recover from error .
+         *
+         * f(error) is called when has error, otherwise value is propagated.
+         *  \tparam F callable const error_type& -> Result<T> (error_type is not implicitly copyable)
+         */
+        template <typename F>
+        constexpr auto or_else(F&& f) const& -> Result requires std::is_copy_constructible_v<value_type>
+        {
+            if (m_has_value) return *this;
+            return std::forward<F>(f)(m_error);
+        }
+        template <typename F>
+        constexpr auto or_else(F&& f) && -> Result
+        {
+            if (m_has_value) return std::move(*this);
+            return std::forward<F>(f)(m_error);
+        }
     private:
+        template <typename Self, typename F>
+        static constexpr auto and_then_impl(Self&& self, F&& f)
+        {
+            using result_type = std::remove_cvref_t<std::invoke_result_t<F, decltype(std::forward<Self>(self).value())>>;
+            static_assert(is_result_v<result_type>, "and_then function must return Result<U>");
+            if (self.m_has_value) return std::invoke(std::forward<F>(f), std::forward<Self>(self).value());
+            return result_type(error_type(self.m_error.code()));
+        }
+        template <typename Self, typename F>
+        static constexpr auto transform_impl(Self&& self, F&& f)
+        {
+            using value_u = std::remove_cvref_t<std::invoke_result_t<F, decltype(std::forward<Self>(self).value())>>;
+            using result_type = Result<value_u>;
+            if (self.m_has_value) return result_type(std::invoke(std::forward<F>(f), std::forward<Self>(self).value()));
+            return result_type(error_type(self.m_error.code()));
+        }
+        /// destroy value (if has)
+        constexpr auto destroy() noexcept -> void
+        {
+            if constexpr (! std::is_trivially_destructible_v<value_type>) {
+                // if !m_has_value maybe not constructed
+                if (m_has_value) m_value.~T(); // call destructor
+            }
+        }
         //////////////////////////////////////////////
         // helper value_type / error_type constructors
         //////////////////////////////////////////////
@@ -162,19 +289,14 @@ namespace Sml {
         /// direct construct
         template <class... Args>
         constexpr auto construct_value(Args&&... args) noexcept -> void {new (std::addressof(m_value)) T(std::forward<Args>(args)...);}
-        /// copy construct
-        constexpr auto construct_value(const T& v) noexcept -> void {new (std::addressof(m_value)) T(v);}
-        /// move construct
-        constexpr auto construct_value(T&& v) noexcept -> void {new (std::addressof(m_value)) T(std::move(v));}
         /// error
         // direct construct
         template <class Arg>
         constexpr auto construct_error(Arg&& arg) noexcept -> void {new (std::addressof(m_error)) error_type(std::forward<Arg>(arg));}
         /// copy construct
         constexpr auto construct_error(const error_type& v) noexcept -> void {new (std::addressof(m_error)) error_type(v);}
-        /// move construct
-        constexpr auto construct_error(error_type&& v) noexcept -> void {new (std::addressof(m_error)) error_type(std::move(v));}
     private:
+        template <typename U> friend class Result;
         bool m_has_value       = false;
         union {
             bool         dummy = false;
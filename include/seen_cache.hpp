@@ -0,0 +1,264 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file seen_cache.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Bounded, sharded LRU cache of seen frames (duplicate suppression)
+ *
+ * Frames are identified by 64 bits hash of contents (hash_bytes(), length is mixed in),
+ * contents are not kept. Each shard has own lock, fixed node pool (LRU list) and open
+ * addressing index, so no allocation occurs after construction.
+ *
+ *\code
+ * Sml::SeenCache seen(4096);         // last 4096 frames
+ * // thread of link A and thread of link B
+ * if (seen.check_and_insert(frame)) return; // already received by other link
+ * dispatch(frame);
+ * SML_INFO("hit rate "s + std::to_string(seen.stats().hit_rate()));
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_SEEN_CACHE_Hpp
+# define  SML_SEEN_CACHE_Hpp
+
+# include <bit>
+# include <memory>
+# include <mutex>
+# include <vector>
+
+# include "hash.hpp"
+
+namespace Sml {
+    /*! Counters of SeenCache .
+     */
+    struct SeenCacheStats
+    {
+        count_type m_lookups   {0}; //!< number of check_and_insert() / contains()
+        count_type m_hits      {0}; //!< found (duplicate)
+        count_type m_inserts   {0}; //!< recorded new frame
+        count_type m_evictions {0}; //!< least recently seen frame dropped by insert
+
+        auto hit_rate() const noexcept -> double
+        {
+            return (m_lookups == 0) ? 0.0 : static_cast<double>(m_hits) / static_cast<double>(m_lookups);
+        }
+        auto operator+=(const SeenCacheStats& rhs) noexcept -> SeenCacheStats&
+        {
+            m_lookups   += rhs.m_lookups;
+            m_hits      += rhs.m_hits;
+            m_inserts   += rhs.m_inserts;
+            m_evictions += rhs.m_evictions;
+            return *this;
+        }
+    }; //<-- struct SeenCacheStats ends here.
+
+    /*! Seen frame cache .
+     */
+    class SeenCache
+    {
+    public:
+        using key_type = std::uint64_t;
+
+        /*!
+         *  \param[in] capacity number of frames kept (in total, split into shards)
+         *  \param[in] shards number of shards (rounded up to power of 2)
+         */
+        explicit SeenCache(size_type capacity = request_volume(rooms::V4K), size_type shards = 8)
+            : m_shift(64 - std::countr_zero(std::bit_ceil(std::max<size_type>(shards, 1))))
+            , m_shards(std::bit_ceil(std::max<size_type>(shards, 1)))
+        {
+            auto per_shard = std::max<size_type>((capacity + m_shards.size() - 1) / m_shards.size(), 1);
+            for (auto& s : m_shards) s.init(per_shard);
+        }
+        SeenCache(const SeenCache&) = delete;
+        SeenCache& operator=(const SeenCache&) = delete;
+
+        /*! Check frame was seen, and record it (most recently seen) .
+         *  \retval true duplicate
+         *  \retval false new frame (recorded)
+         */
+        auto check_and_insert(key_type key) noexcept -> bool
+        {
+            auto& s = shard(key);
+            std::lock_guard<std::mutex> lock(s.m_guard);
+            return s.check_and_insert(key);
+        }
+        auto check_and_insert(const void* p, size_type n) noexcept -> bool {return check_and_insert(key_of(p, n));}
+        auto check_and_insert(std::string_view s) noexcept -> bool {return check_and_insert(key_of(s.data(), s.size()));}
+        auto check_and_insert(const BufferBase<char>& b) noexcept -> bool {return check_and_insert(key_of(b.const_ptr(), b.size()));}
+        /*! Check frame was seen (no record, LRU order is not changed) .
+         */
+        auto contains(key_type key) noexcept -> bool
+        {
+            auto& s = shard(key);
+            std::lock_guard<std::mutex> lock(s.m_guard);
+            ++s.m_stats.m_lookups;
+            auto found = (s.find(key) != Shard::npos);
+            if (found) ++s.m_stats.m_hits;
+            return found;
+        }
+        auto contains(std::string_view s) noexcept -> bool {return contains(key_of(s.data(), s.size()));}
+        auto contains(const BufferBase<char>& b) noexcept -> bool {return contains(key_of(b.const_ptr(), b.size()));}
+        /*! Forget all frames (counters are kept) .
+         */
+        auto clear() noexcept -> void
+        {
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s.m_guard);
+                s.clear();
+            }
+        }
+        /*! Sum of counters of shards .
+         */
+        auto stats() const noexcept -> SeenCacheStats
+        {
+            SeenCacheStats total;
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s.m_guard);
+                total += s.m_stats;
+            }
+            return total;
+        }
+        auto reset_stats() noexcept -> void
+        {
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s.m_guard);
+                s.m_stats = SeenCacheStats{};
+            }
+        }
+        /*! Number of frames kept .
+         */
+        auto size() const noexcept -> size_type
+        {
+            size_type n = 0;
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s.m_guard);
+                n += s.m_size;
+            }
+            return n;
+        }
+        auto capacity() const noexcept -> size_type {return m_shards.size() * m_shards.front().m_nodes.size();}
+        auto shards() const noexcept -> size_type {return m_shards.size();}
+        static auto key_of(const void* p, size_type n) noexcept -> key_type {return hash_bytes(p, n);}
+    private:
+        /*! One shard, LRU list on node pool and linear probing index .
+         */
+        struct alignas(64) Shard
+        {
+            static constexpr std::uint32_t npos = ~std::uint32_t{0};
+            struct Node
+            {
+                key_type      m_key  {0};
+                std::uint32_t m_prev {npos};
+                std::uint32_t m_next {npos};
+            };
+            auto init(size_type n) -> void
+            {
+                m_nodes.resize(n);
+                m_slots.assign(std::bit_ceil(n * 2), npos);
+                m_mask = m_slots.size() - 1;
+                clear();
+            }
+            auto clear() noexcept -> void
+            {
+                std::fill(m_slots.begin(), m_slots.end(), npos);
+                m_head = m_tail = npos;
+                m_size = 0;
+            }
+            auto slot_of(key_type key) const noexcept -> size_type {return static_cast<size_type>(key) & m_mask;}
+            /// node index of key or npos
+            auto find(key_type key) const noexcept -> std::uint32_t
+            {
+                for (auto i = slot_of(key); m_slots[i] != npos; i = (i + 1) & m_mask) {
+                    if (m_nodes[m_slots[i]].m_key == key) return m_slots[i];
+                }
+                return npos;
+            }
+            auto check_and_insert(key_type key) noexcept -> bool
+            {
+                ++m_stats.m_lookups;
+                auto n = find(key);
+                if (n != npos) {
+                    ++m_stats.m_hits;
+                    unlink(n);
+                    push_front(n);
+                    return true;
+                }
+                if (m_size < m_nodes.size()) {
+                    n = static_cast<std::uint32_t>(m_size++);
+                } else {
+                    n = m_tail; // least recently seen
+                    unlink(n);
+                    erase_slot(m_nodes[n].m_key);
+                    ++m_stats.m_evictions;
+                }
+                m_nodes[n].m_key = key;
+                push_front(n);
+                auto i = slot_of(key);
+                while (m_slots[i] != npos) i = (i + 1) & m_mask;
+                m_slots[i] = n;
+                ++m_stats.m_inserts;
+                return false;
+            }
+            /// remove index entry of key (backward shift deletion)
+            auto erase_slot(key_type key) noexcept -> void
+            {
+                auto i = slot_of(key);
+                while (m_nodes[m_slots[i]].m_key != key) i = (i + 1) & m_mask;
+                auto j = i;
+                for (;;) {
+                    j = (j + 1) & m_mask;
+                    if (m_slots[j] == npos) break;
+                    auto home = slot_of(m_nodes[m_slots[j]].m_key);
+                    // move j into hole i when home of j is not in (i, j] cyclically
+                    if (((j - home) & m_mask) >= ((j - i) & m_mask)) {
+                        m_slots[i] = m_slots[j];
+                        i = j;
+                    }
+                }
+                m_slots[i] = npos;
+            }
+            auto unlink(std::uint32_t n) noexcept -> void
+            {
+                auto& x = m_nodes[n];
+                if (x.m_prev != npos) m_nodes[x.m_prev].m_next = x.m_next; else m_head = x.m_next;
+                if (x.m_next != npos) m_nodes[x.m_next].m_prev = x.m_prev; else m_tail = x.m_prev;
+                x.m_prev = x.m_next = npos;
+            }
+            auto push_front(std::uint32_t n) noexcept -> void
+            {
+                auto& x = m_nodes[n];
+                x.m_prev = npos;
+                x.m_next = m_head;
+                if (m_head != npos) m_nodes[m_head].m_prev = n;
+                m_head = n;
+                if (m_tail == npos) m_tail = n;
+            }
+
+            mutable std::mutex         m_guard {};     //!< lock of this shard
+            std::vector<Node>          m_nodes {};     //!< node pool (LRU list)
+            std::vector<std::uint32_t> m_slots {};     //!< index (node or npos)
+            size_type                  m_mask  {0};    //!< slots - 1
+            std::uint32_t              m_head  {npos}; //!< most recently seen
+            std::uint32_t              m_tail  {npos}; //!< least recently seen
+            size_type                  m_size  {0};    //!< used nodes
+            SeenCacheStats             m_stats {};     //!< counters
+        }; //<-- struct Shard ends here.
+        /// shard by upper bits (index uses lower bits)
+        auto shard(key_type key) noexcept -> Shard& {return m_shards[(m_shift >= 64) ? 0 : static_cast<size_type>(key >> m_shift)];}
+
+        unsigned           m_shift  {64}; //!< 64 - log2(shards)
+        std::vector<Shard> m_shards {};   //!< shards
+    }; //<-- class SeenCache ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_SEEN_CACHE_Hpp ends here.
+/** @} */
@@ -0,0 +1,150 @@
+/*!
+ * \addtogroup ds
+ * @{
+ * \file shared_buffer.hpp
+ *
+ * \copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE file for details
+ *
+ * \brief Immutable reference counted view of ByteBuffer (copy on write)
+ *
+ * SharedBuffer takes ByteBuffer by move, copy of SharedBuffer only increments the (atomic)
+ * reference count, so one received frame can be handed to many consumers (logger, decoder,
+ * capture ...) without copy. slice() makes sub view of same block, mutate() copies only when
+ * the block is shared.
+ *
+ *\code
+ * Sml::SharedBuffer frame(std::move(received));
+ * logger.post(frame);                 // no copy
+ * decoder.post(frame.slice(2, n));    // body only, no copy
+ * auto w = frame.mutate();            // copied here when logger or decoder still holds it
+ * w[0] = 0x06;
+ *\endcode
+ *
+ * \author s3mat3
+ */
+
+#pragma once
+
+#ifndef SML_SHARED_BUFFER_Hpp
+# define  SML_SHARED_BUFFER_Hpp
+
+# include <algorithm>
+# include <memory>
+# include <span>
+# include <string_view>
+
+# include "byte_buffer.hpp"
+
+namespace Sml {
+    /*! Shared (reference counted) immutable bytes .
+     *
+     * \note Same SharedBuffer object must not be used by threads at once (same as std::shared_ptr),
+     *       copies of it may be used by other threads.
+     */
+    class SharedBuffer
+    {
+    public:
+        using block_type      = std::shared_ptr<ByteBuffer>;
+        using const_pointer   = const char*;
+        using const_iterator  = const char*;
+
+        SharedBuffer() = default;
+        /*! Take buffer (moved, no copy) .
+         */
+        explicit SharedBuffer(ByteBuffer&& b)
+            : m_block(std::make_shared<ByteBuffer>(std::move(b)))
+            , m_offset(0)
+            , m_length(m_block->size())
+        {}
+        /*! Copy of bytes .
+         */
+        static auto copy_of(const char* p, size_type n) -> SharedBuffer
+        {
+            ByteBuffer b(std::max<size_type>(n, 1));
+            b.append(p, n);
+            return SharedBuffer(std::move(b));
+        }
+        static auto copy_of(std::string_view s) -> SharedBuffer {return copy_of(s.data(), s.size());}
+
+        /*! Sub view [first, first + length) sharing the block .
+         *
+         * Length is clamped into this view (same as BufferBase::substr).
+         */
+        auto slice(size_type first, size_type length) const noexcept -> SharedBuffer
+        {
+            first  = std::min(first, m_length);
+            length = std::min(length, m_length - first);
+            return SharedBuffer(m_block, m_offset + first, length);
+        }
+        auto slice(size_type first) const noexcept -> SharedBuffer {return slice(first, m_length);}
+        /*! Writable bytes of this view, copied when the block is shared .
+         */
+        auto mutate() -> std::span<char>
+        {
+            if (! m_block) return {};
+            if (! unique()) {
+                ByteBuffer b(std::max<size_type>(m_length, 1));
+                b.append(data(), m_length);
+                m_block  = std::make_shared<ByteBuffer>(std::move(b));
+                m_offset = 0;
+            }
+            return {m_block->ptr() + m_offset, m_length};
+        }
+        /*! Bytes as ByteBuffer (moved out when this is the only owner of whole block, else copied) .
+         *
+         * This becomes empty.
+         */
+        auto release() -> ByteBuffer
+        {
+            if (! m_block) return ByteBuffer(1);
+            if (unique() && m_offset == 0 && m_length == m_block->size()) {
+                ByteBuffer b(std::move(*m_block));
+                reset();
+                return b;
+            }
+            ByteBuffer b(std::max<size_type>(m_length, 1));
+            b.append(data(), m_length);
+            reset();
+            return b;
+        }
+        auto reset() noexcept -> void
+        {
+            m_block.reset();
+            m_offset = 0;
+            m_length = 0;
+        }
+        auto data() const noexcept -> const_pointer {return (m_block) ? m_block->const_ptr() + m_offset : nullptr;}
+        auto size() const noexcept -> size_type {return m_length;}
+        auto empty() const noexcept -> bool {return m_length == 0;}
+        auto begin() const noexcept -> const_iterator {return data();}
+        auto end() const noexcept -> const_iterator {return data() + m_length;}
+        auto view() const noexcept -> std::string_view {return {data(), m_length};}
+        auto span() const noexcept -> std::span<const char> {return {data(), m_length};}
+        auto operator[](size_type i) const noexcept -> char {return data()[i];}
+        /*! Number of owners of the block .
+         */
+        auto use_count() const noexcept -> long {return m_block.use_count();}
+        auto unique() const noexcept -> bool {return m_block.use_count() == 1;}
+        /*! Shared block (for ChainBuffer::append(block, offset(), size())) .
+         */
+        auto block() const noexcept -> std::shared_ptr<const ByteBuffer> {return m_block;}
+        auto offset() const noexcept -> size_type {return m_offset;}
+    private:
+        SharedBuffer(block_type b, size_type offset, size_type length) noexcept
+            : m_block(std::move(b))
+            , m_offset(offset)
+            , m_length(length)
+        {}
+        block_type m_block  {nullptr}; //!< shared block
+        size_type  m_offset {0};       //!< first byte of view in block
+        size_type  m_length {0};       //!< bytes of view
+    }; //<-- class SharedBuffer ends here.
+
+    inline auto operator==(const SharedBuffer& lhs, std::string_view rhs) noexcept -> bool {return lhs.view() == rhs;}
+    inline auto operator==(const SharedBuffer& lhs, const SharedBuffer& rhs) noexcept -> bool {return lhs.view() == rhs.view();}
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  SML_SHARED_BUFFER_Hpp ends here.
+/** @} */
@@ -9,6 +9,15 @@
  *
  * \brief Signal sender/reciver in blocked
  *
+ * The waiting side is selected per instance by WaitPolicy,
+ * - WaitStrategy::block condition variable (default, same as before)
+ * - WaitStrategy::spin busy spin with pause instruction (occupies one core while waiting)
+ * - WaitStrategy::hybrid bounded spin, then bounded sched_yield, then futex park
+ *
+ * Spinning helps only when writer and reader run on different cores
+ * (e.g. pinned by ThreadAttributes) and the update cadence is a few micro seconds.
+ * Which phase satisfied each wait is counted, see last_phase() and phase_count().
+ *
  * \author s3mat3
  */
 
@@ -17,10 +26,19 @@
 #ifndef SML_SIGNAL_Hpp
 # define  SML_SIGNAL_Hpp
 
+# include <array>
+# include <atomic>
 # include <chrono>
+# include <climits>
 # include <condition_variable>
+# include <ctime>
 # include <exception>
 # include <mutex>
+# include <stop_token>
+# include <thread>
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
 
 # include "sml.hpp"
 
@@ -31,17 +49,60 @@ namespace Sml {
      */
     struct canceled_wait_event : std::exception {};
 
+    /*! Hint to cpu in spin loop (pause instruction) .
+     */
+    inline void cpu_relax() noexcept
+    {
+# if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+# elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+# endif
+    }
+
+    /*! How Signal waits update .
+     */
+    enum class WaitStrategy : std::uint8_t {
+        block,  //!< condition variable
+        spin,   //!< busy spin with pause
+        hybrid, //!< spin, yield, then futex park
+    };
+
+    /*! Phase which satisfied one wait .
+     */
+    enum class WaitPhase : std::uint8_t {
+        none,    //!< no wait yet
+        block,   //!< woke up from condition variable
+        spin,    //!< found while spinning
+        yield,   //!< found while yielding
+        park,    //!< woke up from futex
+        timeout, //!< timed out (any strategy)
+        end_of_phase,
+    };
+
+    /*! Wait strategy with bounds of hybrid phases .
+     */
+    struct WaitPolicy
+    {
+        WaitStrategy m_strategy {WaitStrategy::block};
+        count_type   m_spin     {2000}; //!< spin count before yield (hybrid)
+        count_type   m_yield    {16};   //!< yield count before park (hybrid)
+    }; //<-- struct WaitPolicy ends here.
+
     /*! Signal .
      *
      * Signal delivery with blocking.
      * Usecase is one writer and one reader.
      * Don't more reader, because no queue.
+     * The stop token overloads always wait on condition variable.
      */
     class Signal {
         using signal_id = return_code;
         using lock_type = std::mutex;
         using locker    = std::unique_lock<lock_type>;
         using cv        = std::condition_variable;
+        using clock     = std::chrono::steady_clock;
+        using phases    = std::array<std::atomic<count_type>, static_cast<size_type>(WaitPhase::end_of_phase)>;
         static constexpr signal_id TIMEOUT = Sml::TIMEOUT;
     public:
         /*! Constructor 1 .
@@ -49,6 +110,11 @@ namespace Sml {
          * necessary default constructable SignalCode as m_id
          */
         Signal()                             = default;
+        /*! Constructor 2 .
+         *
+         *  \param[in] policy wait strategy of this instance
+         */
+        explicit Signal(WaitPolicy policy) : m_policy {policy} {}
         ~Signal()                            = default;
 
         Signal(const Signal&)                = delete;
@@ -59,60 +125,190 @@ namespace Sml {
          */
         void update(const signal_id& x)
         {
-            locker guard(m_guard);
-            m_updated = true;
-            m_id = x;
-            m_monitor.notify_all();
+            {
+                locker guard(m_guard);
+                m_updated = true;
+                m_id = x;
+                m_pending.store(1, std::memory_order_seq_cst);
+                m_monitor.notify_all();
+            }
+            wake_parked();
         }
         /*! Wait update .
          */
         signal_id wait_update() noexcept(false)
         {
+            if (m_policy.m_strategy != WaitStrategy::block) return wait_pending(nullptr);
             locker guard(m_guard);
             m_monitor.wait(guard, [&] {return m_updated || m_canceled;});
-            if (m_canceled) {
-                m_canceled = false;
-                throw canceled_wait_event();
-            }
-            if (m_updated) m_updated = false;
-            return m_id;
+            count(WaitPhase::block);
+            return take(guard, true);
         }
         /*! Wait update with timeout.
          */
         signal_id wait_for(millisec_interval tout) noexcept(false)
         {
+            if (m_policy.m_strategy != WaitStrategy::block) {
+                auto deadline = clock::now() + std::chrono::milliseconds(tout);
+                return wait_pending(&deadline);
+            }
             locker guard(m_guard);
             auto ret = m_monitor.wait_for(guard
                                        , std::chrono::milliseconds(tout)
                                        , [&] {return m_updated || m_canceled;});
-            if (m_canceled) {
-                m_canceled = false;
-                throw canceled_wait_event();
-            }
-            if (m_updated) m_updated = false;
-            if (! ret) return TIMEOUT;
-            return m_id;
+            count((ret) ? WaitPhase::block : WaitPhase::timeout);
+            return take(guard, ret);
+        }
+        /*! Wait update until stop requested .
+         *
+         * Stop request wakes up waiting thread by stop callback, and throws canceled_wait_event
+         * same as cancel() (an update already occurred has priority over stop).
+         *  \param[in] st stop token (e.g. given to Runnable::run)
+         */
+        signal_id wait_update(std::stop_token st) noexcept(false)
+        {
+            std::stop_callback wakeup(st, [this] {locker guard(m_guard); m_monitor.notify_all();});
+            locker guard(m_guard);
+            m_monitor.wait(guard, [&] {return m_updated || m_canceled || st.stop_requested();});
+            count(WaitPhase::block);
+            return take(guard, true);
+        }
+        /*! Wait update with timeout until stop requested .
+         */
+        signal_id wait_for(millisec_interval tout, std::stop_token st) noexcept(false)
+        {
+            std::stop_callback wakeup(st, [this] {locker guard(m_guard); m_monitor.notify_all();});
+            locker guard(m_guard);
+            auto ret = m_monitor.wait_for(guard
+                                       , std::chrono::milliseconds(tout)
+                                       , [&] {return m_updated || m_canceled || st.stop_requested();});
+            count((ret) ? WaitPhase::block : WaitPhase::timeout);
+            return take(guard, ret);
         }
         void clear()
         {
             locker guard(m_guard);
             m_updated  = false;
             m_canceled = false;
+            m_pending.store(0, std::memory_order_relaxed);
         }
         /*! cancel for wait .
          */
         void cancel()
         {
-            locker guard(m_guard);
-            m_canceled = true;
-            m_monitor.notify_all();
+            {
+                locker guard(m_guard);
+                m_canceled = true;
+                m_pending.store(1, std::memory_order_seq_cst);
+                m_monitor.notify_all();
+            }
+            wake_parked();
+        }
+        /*! Change wait strategy (don't call while waiting) .
+         */
+        void policy(WaitPolicy p) noexcept {m_policy = p;}
+        auto policy() const noexcept -> WaitPolicy {return m_policy;}
+        /*! Phase which satisfied the latest wait .
+         */
+        auto last_phase() const noexcept -> WaitPhase {return m_last.load(std::memory_order_relaxed);}
+        /*! Number of waits satisfied by the phase .
+         */
+        auto phase_count(WaitPhase ph) const noexcept -> count_type
+        {
+            return m_phases[static_cast<size_type>(ph)].load(std::memory_order_relaxed);
+        }
+        void reset_phase_count() noexcept
+        {
+            for (auto& c : m_phases) c.store(0, std::memory_order_relaxed);
+            m_last.store(WaitPhase::none, std::memory_order_relaxed);
         }
     private:
-        bool      m_updated  {false}; //!< updated flag true: update occurred, false: no update
-        bool      m_canceled {false}; //!< cancel flag true: cancel occurrerd, false: no action
-        signal_id m_id       {0};     //!< signal id
-        lock_type m_guard    {};      //!< resource guard
-        cv        m_monitor  {};      //!< monitor with condition variable
+        /*! Wait by spin / yield / park, then consume under lock .
+         *
+         *  \param[in] deadline nullptr is no timeout
+         */
+        signal_id wait_pending(const clock::time_point* deadline) noexcept(false)
+        {
+            for (;;) {
+                auto ph = await_pending(deadline);
+                locker guard(m_guard);
+                if (ph == WaitPhase::timeout) {
+                    count(ph);
+                    return take(guard, false); // an update just at the deadline is still taken
+                }
+                if (m_updated || m_canceled) {
+                    count(ph);
+                    return take(guard, true);
+                }
+                m_pending.store(0, std::memory_order_relaxed); // consumed by other wait (e.g. stop token overload)
+            }
+        }
+        auto await_pending(const clock::time_point* deadline) noexcept -> WaitPhase
+        {
+            auto expired = [deadline] {return deadline && clock::now() >= *deadline;};
+            for (count_type i = 1;; ++i) {
+                if (m_pending.load(std::memory_order_acquire)) return WaitPhase::spin;
+                if (m_policy.m_strategy == WaitStrategy::hybrid && i > m_policy.m_spin) break;
+                cpu_relax();
+                if ((i & 0x3f) == 0 && expired()) return WaitPhase::timeout;
+            }
+            for (count_type i = 0; i < m_policy.m_yield; ++i) {
+                std::this_thread::yield();
+                if (m_pending.load(std::memory_order_acquire)) return WaitPhase::yield;
+                if (expired()) return WaitPhase::timeout;
+            }
+            for (;;) {
+                timespec rel {};
+                if (deadline) {
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(*deadline - clock::now()).count();
+                    if (ns <= 0) return m_pending.load(std::memory_order_acquire) ? WaitPhase::park : WaitPhase::timeout;
+                    rel.tv_sec  = ns / 1000000000;
+                    rel.tv_nsec = ns % 1000000000;
+                }
+                m_parked.fetch_add(1, std::memory_order_seq_cst);
+                ::syscall(SYS_futex, &m_pending, FUTEX_WAIT_PRIVATE, 0, (deadline) ? &rel : nullptr, nullptr, 0);
+                m_parked.fetch_sub(1, std::memory_order_seq_cst);
+                if (m_pending.load(std::memory_order_acquire)) return WaitPhase::park;
+            }
+        }
+        void wake_parked() noexcept
+        {
+            if (m_parked.load(std::memory_order_seq_cst) > 0) {
+                ::syscall(SYS_futex, &m_pending, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+            }
+        }
+        void count(WaitPhase ph) noexcept
+        {
+            auto& c = m_phases[static_cast<size_type>(ph)];
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // only the reader thread
+            m_last.store(ph, std::memory_order_relaxed);
+        }
+        signal_id take(locker&, bool ready) noexcept(false)
+        {
+            if (m_canceled) {
+                m_canceled = false;
+                if (! m_updated) m_pending.store(0, std::memory_order_relaxed);
+                throw canceled_wait_event();
+            }
+            if (m_updated) {
+                m_updated = false;
+                m_pending.store(0, std::memory_order_relaxed);
+                return m_id;
+            }
+            if (ready) throw canceled_wait_event(); // stop requested
+            return TIMEOUT;
+        }
+        bool                       m_updated  {false}; //!< updated flag true: update occurred, false: no update
+        bool                       m_canceled {false}; //!< cancel flag true: cancel occurrerd, false: no action
+        signal_id                  m_id       {0};     //!< signal id
+        lock_type                  m_guard    {};      //!< resource guard
+        cv                         m_monitor  {};      //!< monitor with condition variable
+        WaitPolicy                 m_policy   {};      //!< wait strategy
+        std::atomic<std::uint32_t> m_pending  {0};     //!< futex word, 1: updated or canceled (not taken yet)
+        std::atomic<std::uint32_t> m_parked   {0};     //!< number of futex parked waiters
+        std::atomic<WaitPhase>     m_last     {WaitPhase::none}; //!< phase of the latest wait
+        phases                     m_phases   {};      //!< number of waits by phase
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free && sizeof(std::uint32_t) == 4, "futex word");
     }; //<-- class Signal ends here.
 
     /*! \class Signal
@@ -15,52 +15,86 @@
 #ifndef SML_THREAD_Hpp
 # define  SML_THREAD_Hpp
 
+# include <algorithm>
+# include <atomic>
+# include <bit>
+# include <cerrno>
+# include <cstring>
+# include <condition_variable>
+# include <ctime>
 # include <memory>
+# include <mutex>
+# include <stop_token>
+# include <string>
 # include <thread>
+# include <vector>
+# include <limits.h>
+# include <pthread.h>
+# include <sched.h>
+# include <sys/syscall.h>
+# include <unistd.h>
 
 # include "base.hpp"
 # include "debug.hpp"
 
 namespace Sml{
     /*!  Runnable Interface class.
+     *
+     * Thread calls run(void*, std::stop_token), the default forwards to run(void*) for legacy runnables.
      */
     class Runnable
     {
     public:
         virtual ~Runnable() {}
         virtual void run(void*) noexcept = 0;
+        /*! Run with stop token (requested by Thread::request_stop or ~Thread) .
+         */
+        virtual void run(void* vp, std::stop_token) noexcept {run(vp);}
         virtual return_code stop(void) noexcept = 0;
     }; //<-- class Runnable ends here.
 
     /*!  Runnableadapter
      *
      * The condition for attaching is that return_code stop() must be implemented in the class member function.
-     * Also, a member function corresponding to entrypoint_t executed in run(VP) must be implemented.
+     * Also, a member function corresponding to entrypoint_t executed in run(VP) must be implemented,
+     * or stoppable_entrypoint_t which receives std::stop_token of the thread.
      * The Thread class launches the function of any class attached to this class as a separate thread space.
      */
     template <class C>
     class RunnableAdapter : public Runnable
     {
     public:
-        using entrypoint_t = void (C::*)(void_ptr);
-        using instance_p = std::shared_ptr<C>;
+        using entrypoint_t           = void (C::*)(void_ptr);
+        using stoppable_entrypoint_t = void (C::*)(void_ptr, std::stop_token);
+        using instance_p             = std::shared_ptr<C>;
 
         explicit RunnableAdapter(instance_p target, entrypoint_t func) noexcept
             : m_instance(std::move(target))
             , m_entrypoint(func)
         {}
+        explicit RunnableAdapter(instance_p target, stoppable_entrypoint_t func) noexcept
+            : m_instance(std::move(target))
+            , m_entrypoint(nullptr)
+            , m_stoppable(func)
+        {}
         RunnableAdapter() : RunnableAdapter(nullptr, nullptr) {}
 
         RunnableAdapter(const RunnableAdapter&) = delete;
 
         RunnableAdapter(RunnableAdapter&& rhs) noexcept
-            : RunnableAdapter(std::move(rhs.m_instance), rhs.m_entrypoint) {}
+            : m_instance(std::move(rhs.m_instance))
+            , m_entrypoint(rhs.m_entrypoint)
+            , m_stoppable(rhs.m_stoppable) {}
 
         virtual ~RunnableAdapter() = default;
 
-        virtual void run(void_ptr vp) noexcept override
+        virtual void run(void_ptr vp) noexcept override {run(vp, std::stop_token{});}
+
+        virtual void run(void_ptr vp, std::stop_token st) noexcept override
         {
-            if (m_instance && m_entrypoint) {
+            if (m_instance && m_stoppable) {
+                (*m_instance.*m_stoppable)(vp, std::move(st));
+            } else if (m_instance && m_entrypoint) {
                 (*m_instance.*m_entrypoint)(vp);
             } else {
                 SML_FATAL("=====> Hasn't runnable entrypoint object");
@@ -69,6 +103,7 @@ namespace Sml{
 
         virtual return_code stop() noexcept override
         {
+            if (! m_instance) return NO_RESOURCE;
             m_instance->stop();
             SML_LOG("stoped");
             return OK;
@@ -100,28 +135,60 @@ namespace Sml{
             return *this;
         }
     private:
-        instance_p   m_instance;    //!< target class instance
-        entrypoint_t m_entrypoint;  //!< adapted runner
+        instance_p             m_instance;            //!< target class instance
+        entrypoint_t           m_entrypoint;          //!< adapted runner
+        stoppable_entrypoint_t m_stoppable {nullptr}; //!< adapted runner with stop token
     }; //<-- class RunnableAdapter ends here.
 
+    /*! Scheduling policy of thread .
+     */
+    enum class SchedPolicy : int {
+        other = SCHED_OTHER, //!< normal time sharing (default)
+        fifo  = SCHED_FIFO,  //!< real time first in first out (needs CAP_SYS_NICE)
+        rr    = SCHED_RR,    //!< real time round robin (needs CAP_SYS_NICE)
+    };
+
+    /*! Thread attributes .
+     *
+     * Requested by Thread::attributes(), and read back from the started thread by Thread::applied().
+     */
+    struct ThreadAttributes
+    {
+        using cpu_list = std::vector<int>;
+
+        cpu_list    m_cpus       {};                   //!< CPU affinity (empty: inherit)
+        SchedPolicy m_policy     {SchedPolicy::other}; //!< scheduling policy
+        int         m_priority   {0};                  //!< static priority (1 ... 99 for fifo / rr, 0 for other)
+        size_type   m_stack_size {0};                  //!< stack size in bytes (0: default)
+        int         m_numa_node  {-1};                 //!< preferred NUMA node for memory allocation (-1: no preference)
+        std::string m_name       {};                   //!< thread name (empty: Base::name(), truncated to 15 chars)
+    }; //<-- struct ThreadAttributes ends here.
+
     /*!  \class Thread
      * \brief Thread class for evry class
      *
      * This class is final. (can not derived)
      *
      * It is simply a helper class to easily migrate a void(*)(void*) member function of a certain class to the thread space.
+     * The thread is created by pthread with attributes (stack size, affinity, scheduling),
+     * and name / NUMA preference are set in the new thread, all before Runnable::run() begins.
+     * Like std::jthread, the thread has std::stop_source, the token is passed to Runnable::run
+     * and the destructor requests stop before join.
      */
     class Thread final : public Base
     {
     public:
-        using runnable_p = std::shared_ptr<Runnable>;
-        using runnable_w = std::weak_ptr<Runnable>;
-        using thread_u   = std::unique_ptr<std::thread>;
+        using runnable_p      = std::shared_ptr<Runnable>;
+        using runnable_w      = std::weak_ptr<Runnable>;
+        using handle_type     = pthread_t;
+        using attributes_type = ThreadAttributes;
+
+        static constexpr size_type name_max = 15; //!< pthread_setname_np limit (without '\0')
 
         Thread(runnable_p runnable, ID_t id, const std::string& name) noexcept
             : Base{id, name}
             , m_runnable{runnable}
-            , m_thread{nullptr}
+            , m_handle{}
             , m_started{false} {}
         explicit Thread(runnable_p runnable, const std::string& name) noexcept : Thread(runnable, 0, name) {}
         explicit Thread(runnable_p runnable) noexcept : Thread(runnable, "some thread") {}
@@ -133,33 +200,48 @@ namespace Sml{
 
         ~Thread() noexcept
         {
+            if (m_started) request_stop();
             auto c = this->join();
             SML_LOG(name() + " Thread object deleting : " + std::to_string(c));
-            m_thread.reset();
             SML_LOG(name() + "::~Thread");
         }
         /*! start threading
          *
          *  runnnable runner go to other thread space
          *  to move another memory context
+         *  Returns after the attributes applied in new thread (before run()).
          *
          *  \param[inout] vp thread argument(s)
          *  \retval OK thread lunched
          *  \retval NO_RESOURCE We have not the RUNNABLE
+         *  \retval FAIL_LUNCH pthread_create failed (e.g. EPERM for SCHED_FIFO without privilege, EINVAL for CPU set)
          */
-        auto start(void* vp) noexcept
+        auto start(void* vp) noexcept -> return_code
         {
-            return_code ret = NO_RESOURCE;
-            if (m_runnable) {
-                m_started = true;
-                SML_LOG(name() + " start thread");
-                m_thread.reset(new std::thread([this,vp]{m_runnable->run(vp);}));
-                return OK;
-            } else {
+            if (! m_runnable) {
                 SML_LOG("=====> No setup Runnable object < " + name());
-                return ret; // NO_RESOURCE
+                return NO_RESOURCE;
             }
-            return ret; // but naver here.
+            if (m_started) join();
+            pthread_attr_t attr;
+            ::pthread_attr_init(&attr);
+            auto ret = setup(attr);
+            if (ret == 0) {
+                m_arg = vp;
+                m_apply_error = 0;
+                m_stop = std::stop_source {};
+                m_ready.store(false, std::memory_order_relaxed);
+                ret = ::pthread_create(&m_handle, &attr, &Thread::entry, this);
+            }
+            ::pthread_attr_destroy(&attr);
+            if (ret != 0) {
+                SML_ERROR(name() + " =====> fail start thread : " + std::strerror(ret));
+                return FAIL_LUNCH;
+            }
+            m_started = true;
+            SML_LOG(name() + " start thread");
+            m_ready.wait(false, std::memory_order_acquire);
+            return OK;
         }
         /*! set runnable for new thread
          *
@@ -177,23 +259,77 @@ namespace Sml{
          *  \retval false hasn't runnable
          */
         operator bool() const noexcept {return (m_runnable) ? true : false;}
+        /*! Set attributes for next start() .
+         */
+        auto attributes(const attributes_type& a) -> void {m_attributes = a;}
+        /*! Requested attributes .
+         */
+        auto attributes() const noexcept -> const attributes_type& {return m_attributes;}
+        /*! Attributes in effect, read back in the thread before run() (valid after start()) .
+         */
+        auto applied() const noexcept -> const attributes_type& {return m_applied;}
+        /*! errno of setting name or NUMA preference in thread (0: all applied) .
+         */
+        auto apply_error() const noexcept -> errno_t {return m_apply_error;}
+        auto native_handle() const noexcept -> handle_type {return m_handle;}
+        /*! Request stop .
+         *
+         * Requests stop of the token (stop callbacks wake up waits in Signal / ChannelBase::isReady),
+         * and calls Runnable::stop() for legacy runnables.
+         *  \retval true this call made the stop request
+         *  \retval false already requested or not started
+         */
+        auto request_stop() noexcept -> bool
+        {
+            auto ret = m_stop.request_stop();
+            if (ret && m_runnable) m_runnable->stop();
+            return ret;
+        }
+        auto stop_requested() const noexcept -> bool {return m_stop.stop_requested();}
+        auto stop_token() const noexcept -> std::stop_token {return m_stop.get_token();}
+        /*! wait for join with timeout
+         *
+         *  \param[in] timeout in [ms] (negative : no timeout, same as join())
+         *  \retval OK joined
+         *  \retval TIMEOUT the thread is still running (joinable yet)
+         *  \retval FAILURE not started or already joined
+         *  \retval FAIL_JOIN when pthread_timedjoin_np failed (the thread is joinable yet)
+         */
+        auto join_for(millisec_interval timeout) noexcept -> return_code
+        {
+            if (! m_started) return FAILURE;
+            if (timeout < 0) return join();
+            timespec deadline {};
+            ::clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec  += timeout / 1000;
+            deadline.tv_nsec += static_cast<long>(timeout % 1000) * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec  += 1;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            auto ret = ::pthread_timedjoin_np(m_handle, nullptr, &deadline);
+            if (ret == ETIMEDOUT) return TIMEOUT;
+            if (ret != 0) {
+                SML_FATAL(name() + " =====> fail join : " + std::strerror(ret));
+                return FAIL_JOIN;
+            }
+            m_started = false;
+            SML_INFO(name() + " => Joined thread");
+            return OK;
+        }
         /*! wait for join terminate thread
          *
          *  \retval OK joined
          *  \retval FAILURE maybe already joined
-         *  \retval FAIL_JOIN when catch std::system_error or other
+         *  \retval FAIL_JOIN when pthread_join failed
          */
         auto join() noexcept -> return_code
         {
-            if (m_thread->joinable() && m_started) {
-                try {
-                    m_started = false;
-                    m_thread->join();
-                } catch (std::system_error& e) {
-                    SML_FATAL(name() + " =====> fail join : " + e.what());
-                    return FAIL_JOIN;
-                } catch (...) {
-                    SML_FATAL(name() + " =====> fail join : Catch unknown EXCEPTION");
+            if (m_started) {
+                m_started = false;
+                auto ret = ::pthread_join(m_handle, nullptr);
+                if (ret != 0) {
+                    SML_FATAL(name() + " =====> fail join : " + std::strerror(ret));
                     return FAIL_JOIN;
                 }
                 SML_INFO(name() + " => Joined thread");
@@ -233,6 +369,21 @@ namespace Sml{
         {
             std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
         }
+        /*! sleep current thread until time passed or stop requested
+         *
+         *  \param[in] milliseconds in milliseconds unit ([ms])
+         *  \param[in] st stop token (e.g. given to Runnable::run)
+         *  \retval true slept whole time
+         *  \retval false woke up by stop request
+         */
+        static inline bool sleep(millisec_interval milliseconds, std::stop_token st)
+        {
+            std::mutex m;
+            std::condition_variable_any cv;
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait_for(lock, st, std::chrono::milliseconds(milliseconds), [] {return false;});
+            return ! st.stop_requested();
+        }
         /*! yield current thread
          *
          */
@@ -241,9 +392,106 @@ namespace Sml{
             std::this_thread::yield();
         }
     protected:
-        runnable_p  m_runnable; //!< real thread runner
-        thread_u    m_thread;   //!< thread holder
-        bool        m_started;  //!< running flag
+        /// pthread attributes (stack size, affinity, scheduling), returns errno
+        auto setup(pthread_attr_t& attr) const noexcept -> int
+        {
+            int ret = 0;
+            if (m_attributes.m_stack_size) {
+                auto size = std::max<size_type>(m_attributes.m_stack_size, PTHREAD_STACK_MIN);
+                if ((ret = ::pthread_attr_setstacksize(&attr, size)) != 0) return ret;
+            }
+            if (! m_attributes.m_cpus.empty()) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (auto c : m_attributes.m_cpus) {
+                    if (c < 0 || c >= CPU_SETSIZE) return EINVAL;
+                    CPU_SET(c, &set);
+                }
+                if ((ret = ::pthread_attr_setaffinity_np(&attr, sizeof(set), &set)) != 0) return ret;
+            }
+            if (m_attributes.m_policy != SchedPolicy::other) {
+                sched_param param {};
+                param.sched_priority = m_attributes.m_priority;
+                if ((ret = ::pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED)) != 0) return ret;
+                if ((ret = ::pthread_attr_setschedpolicy(&attr, static_cast<int>(m_attributes.m_policy))) != 0) return ret;
+                if ((ret = ::pthread_attr_setschedparam(&attr, &param)) != 0) return ret;
+            }
+            return ret;
+        }
+        /// in new thread: name, NUMA preference and read back (before run)
+        auto prepare() noexcept -> void
+        {
+            auto n = (m_attributes.m_name.empty()) ? name() : m_attributes.m_name;
+            if (n.size() > name_max) n.resize(name_max);
+            if (auto e = ::pthread_setname_np(::pthread_self(), n.c_str()); e != 0) m_apply_error = e;
+            if (m_attributes.m_numa_node >= 0) {
+                constexpr int mpol_preferred = 1; // MPOL_PREFERRED of linux/mempolicy.h (no libnuma dependency)
+                if (m_attributes.m_numa_node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+                    m_apply_error = EINVAL;
+                } else {
+                    unsigned long mask = 1UL << m_attributes.m_numa_node;
+                    if (::syscall(SYS_set_mempolicy, mpol_preferred, &mask, sizeof(mask) * 8 + 1) != 0 && m_apply_error == 0) {
+                        m_apply_error = errno;
+                    }
+                }
+            }
+            m_applied = read_back();
+            if (m_apply_error) SML_ERROR(n + " =====> thread attribute not applied : " + std::strerror(m_apply_error));
+        }
+        /// attributes of calling thread
+        static auto read_back() noexcept -> attributes_type
+        {
+            attributes_type a;
+            try {
+                auto self = ::pthread_self();
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (::pthread_getaffinity_np(self, sizeof(set), &set) == 0) {
+                    for (int c = 0; c < CPU_SETSIZE; ++c) if (CPU_ISSET(c, &set)) a.m_cpus.push_back(c);
+                }
+                int policy = SCHED_OTHER;
+                sched_param param {};
+                if (::pthread_getschedparam(self, &policy, &param) == 0) {
+                    a.m_policy   = static_cast<SchedPolicy>(policy);
+                    a.m_priority = param.sched_priority;
+                }
+                pthread_attr_t attr;
+                if (::pthread_getattr_np(self, &attr) == 0) {
+                    ::pthread_attr_getstacksize(&attr, &a.m_stack_size);
+                    ::pthread_attr_destroy(&attr);
+                }
+                char buf[name_max + 1] = {0};
+                if (::pthread_getname_np(self, buf, sizeof(buf)) == 0) a.m_name = buf;
+                int mode = 0;
+                unsigned long mask = 0;
+                if (::syscall(SYS_get_mempolicy, &mode, &mask, sizeof(mask) * 8 + 1, nullptr, 0) == 0 && mode == 1 && mask) {
+                    a.m_numa_node = std::countr_zero(mask);
+                }
+            } catch (...) {} // bad_alloc of cpu list or name
+            return a;
+        }
+        static auto entry(void* p) noexcept -> void*
+        {
+            auto* self = static_cast<Thread*>(p);
+            self->prepare();
+            auto runnable = self->m_runnable;
+            auto arg = self->m_arg;
+            auto token = self->m_stop.get_token();
+            self->m_ready.store(true, std::memory_order_release);
+            self->m_ready.notify_one();
+            runnable->run(arg, std::move(token));
+            return nullptr;
+        }
+
+        runnable_p        m_runnable;          //!< real thread runner
+        handle_type       m_handle;            //!< thread handle
+        bool              m_started;           //!< running flag
+        void*             m_arg {nullptr};     //!< argument for run()
+        attributes_type   m_attributes {};     //!< requested attributes
+        attributes_type   m_applied {};        //!< attributes in effect (read back in thread)
+        errno_t           m_apply_error {0};   //!< error of in thread attribute setting
+        std::atomic<bool> m_ready {false};     //!< attributes applied, run() is starting
+        std::stop_source  m_stop {};           //!< stop request for running thread
     }; // class Thread
 
     /*! \class Thread
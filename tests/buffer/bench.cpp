@@ -125,4 +125,103 @@ BENCHMARK(BM_string_assign);
 BENCHMARK(BM_buffer_assign);
 BENCHMARK(BM_buffer_string_assign);
 
+/** Streaming parse .
+ *
+ * Synthetic stream of frames (2 bytes length + body) is received in 1500 bytes chunks
+ * and complete frames are parsed off the front, forever (steady state).
+ */
+static constexpr size_type STREAM_CHUNK = 1500;
+static auto make_stream() -> std::string
+{
+    std::string s;
+    std::uint32_t seed = 1;
+    while (s.size() < TEST_ROOMS) {
+        seed = seed * 1103515245 + 12345;
+        auto n = 16 + (seed >> 16) % 500;
+        s.push_back(static_cast<char>(n & 0xff));
+        s.push_back(static_cast<char>(n >> 8));
+        s.append(n, static_cast<char>(n));
+    }
+    return s;
+}
+/// frame length at p when complete in n bytes, else 0
+static auto frame_at(const char* p, size_type n) -> size_type
+{
+    if (n < 2) return 0;
+    auto len = 2 + (static_cast<size_type>(static_cast<unsigned char>(p[0])) | (static_cast<size_type>(static_cast<unsigned char>(p[1])) << 8));
+    return (n >= len) ? len : 0;
+}
+/// next chunk of stream (circular, the stream ends at a frame boundary)
+static auto next_chunk(const std::string& stream, size_type& pos) -> std::string_view
+{
+    static const auto circular = stream + stream.substr(0, STREAM_CHUNK);
+    std::string_view c(circular.data() + pos, STREAM_CHUNK);
+    pos = (pos + STREAM_CHUNK) % stream.size();
+    return c;
+}
+
+static void BM_stream_consume_compact(benchmark::State& state) {
+    static const auto stream = make_stream();
+    ByteBuffer rx(request_volume(rooms::V4K));
+    size_type pos = 0, frames = 0, max_capacity = 0;
+    for (auto _ : state) {
+        auto c = next_chunk(stream, pos);
+        auto room = rx.writable_tail(c.size()); // as ::read(fd, room.data(), room.size())
+        std::copy_n(c.data(), c.size(), room.data());
+        rx.update_tail(c.size());
+        for (auto r = rx.readable(); auto len = frame_at(r.data(), r.size()); r = rx.readable()) {
+            benchmark::DoNotOptimize(r[len - 1]);
+            rx.consume(len);
+            ++frames;
+        }
+        max_capacity = std::max(max_capacity, rx.capacity());
+    }
+    state.SetBytesProcessed(state.iterations() * STREAM_CHUNK);
+    state.counters["frames"] = static_cast<double>(frames);
+    state.counters["max_capacity"] = static_cast<double>(max_capacity);
+}
+BENCHMARK(BM_stream_consume_compact);
+
+/// previous workaround, copy out the rest after every chunk (keep partial frame)
+static void BM_stream_extract_rest(benchmark::State& state) {
+    static const auto stream = make_stream();
+    ByteBuffer rx(request_volume(rooms::V4K));
+    size_type pos = 0, frames = 0, max_capacity = 0;
+    for (auto _ : state) {
+        auto c = next_chunk(stream, pos);
+        rx.append(c.data(), c.size());
+        size_type head = 0;
+        while (auto len = frame_at(rx.const_ptr() + head, rx.size() - head)) {
+            benchmark::DoNotOptimize(rx.const_ptr()[head + len - 1]);
+            head += len;
+            ++frames;
+        }
+        rx.assign(rx.substr(head, rx.size() - head));
+        max_capacity = std::max(max_capacity, rx.capacity());
+    }
+    state.SetBytesProcessed(state.iterations() * STREAM_CHUNK);
+    state.counters["frames"] = static_cast<double>(frames);
+    state.counters["max_capacity"] = static_cast<double>(max_capacity);
+}
+BENCHMARK(BM_stream_extract_rest);
+
+/// std::string erase of every frame
+static void BM_stream_string_erase(benchmark::State& state) {
+    static const auto stream = make_stream();
+    std::string rx;
+    size_type pos = 0, frames = 0;
+    for (auto _ : state) {
+        rx.append(next_chunk(stream, pos));
+        while (auto len = frame_at(rx.data(), rx.size())) {
+            benchmark::DoNotOptimize(rx[len - 1]);
+            rx.erase(0, len);
+            ++frames;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * STREAM_CHUNK);
+    state.counters["frames"] = static_cast<double>(frames);
+    state.counters["max_capacity"] = static_cast<double>(rx.capacity());
+}
+BENCHMARK(BM_stream_string_erase);
+
 BENCHMARK_MAIN();
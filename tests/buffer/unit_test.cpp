@@ -212,3 +212,55 @@ TEST_CASE("ByteBuffer helper") {
     auto y = to_string(x);
     CHECK(y == rts);
 }
+
+TEST_CASE("consume and discard_read") {
+    auto x = from_string("HEADbody1body2");
+    CHECK(x.unread() == 14);
+    CHECK(x.consume(4) == OK);
+    CHECK(x.position() == 4);
+    CHECK(std::string(x.readable().data(), x.readable().size()) == "body1body2");
+    CHECK(x.consume(20) == OUT_OF_RANGE);
+    CHECK(x.discard_read() == 4);
+    CHECK(x.position() == 0);
+    CHECK(x == "body1body2"s);
+    CHECK(x.discard_read() == 0);
+    CHECK(x.consume(10) == OK); // all consumed, rewound without copy
+    CHECK(x.size() == 0);
+    CHECK(x.position() == 0);
+}
+
+TEST_CASE("compact only when wasted prefix is large") {
+    auto x = ByteBuffer(64);
+    x.compact_threshold(8);
+    x.append("0123456789abcdef", 16);
+    CHECK(x.consume(4) == OK); // under threshold
+    CHECK(x.position() == 4);
+    CHECK(x.consume(4) == OK); // 8 wasted, 8 unread
+    CHECK(x.position() == 0);
+    CHECK(x == "89abcdef"s);
+    x.append("0123456789abcdef", 16);
+    CHECK(x.consume(9) == OK); // 9 wasted but 15 unread
+    CHECK(x.position() == 9);
+    CHECK(x.compact_if_wasted() == false);
+    CHECK(x.consume(3) == OK); // 12 wasted, 12 unread
+    CHECK(x.position() == 0);
+    CHECK(x == "456789abcdef"s);
+}
+
+TEST_CASE("writable_tail discards prefix before growth") {
+    auto x = ByteBuffer(16);
+    auto room = x.writable_tail();
+    CHECK(room.size() == 16);
+    std::copy_n("0123456789ab", 12, room.data());
+    x.update_tail(12);
+    CHECK(x.consume(10) == OK);
+    CHECK(x.position() == 10);
+    room = x.writable_tail(8); // only 4 rooms, prefix discarded
+    CHECK(x.capacity() == 16);
+    CHECK(x.position() == 0);
+    CHECK(room.size() == 14);
+    room = x.writable_tail(32); // grown
+    CHECK(x.capacity() >= 34);
+    CHECK(room.size() >= 32);
+    CHECK(x == "ab"s);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for frame assembly, ChainBuffer (no copy) VS ByteBuffer::append (copy)
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <string>
+#include "benchmark/benchmark.h"
+
+#include "chain_buffer.hpp"
+
+using namespace Sml;
+
+static const std::string header  = "\x02" "HDR-0001";
+static const std::string trailer = "\x03" "CRC";
+
+/// 3 segments frame (header, payload, trailer) by copy into one buffer
+static void BM_append_concat(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = from_string(std::string(n, 'p'));
+    for (auto _ : state) {
+        ByteBuffer frame(64);
+        frame.append(header.data(), header.size());
+        frame.append(payload);
+        frame.append(trailer.data(), trailer.size());
+        benchmark::DoNotOptimize(frame.const_ptr());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_append_concat)->Arg(64)->Arg(1024)->Arg(65536);
+
+/// same with size reserved (best case of copy)
+static void BM_append_reserved(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = from_string(std::string(n, 'p'));
+    for (auto _ : state) {
+        ByteBuffer frame(header.size() + n + trailer.size());
+        frame.append(header.data(), header.size());
+        frame.append(payload);
+        frame.append(trailer.data(), trailer.size());
+        benchmark::DoNotOptimize(frame.const_ptr());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_append_reserved)->Arg(64)->Arg(1024)->Arg(65536);
+
+/// payload shared, header and trailer blocks shared too (prebuilt)
+static void BM_chain_shared(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = ChainBuffer::make_block(from_string(std::string(n, 'p')));
+    auto head = ChainBuffer::copy_block(header.data(), header.size());
+    auto tail = ChainBuffer::copy_block(trailer.data(), trailer.size());
+    for (auto _ : state) {
+        ChainBuffer frame(payload);
+        frame.prepend(head).append(tail);
+        benchmark::DoNotOptimize(frame.size());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_chain_shared)->Arg(64)->Arg(1024)->Arg(65536);
+
+/// payload shared, header and trailer copied into own small blocks
+static void BM_chain_copy_header(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = ChainBuffer::make_block(from_string(std::string(n, 'p')));
+    for (auto _ : state) {
+        ChainBuffer frame(payload);
+        frame.prepend(header).append(trailer);
+        benchmark::DoNotOptimize(frame.size());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_chain_copy_header)->Arg(64)->Arg(1024)->Arg(65536);
+
+/// fragmentation of payload into 256 bytes frames with header
+static void BM_chain_fragment(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = ChainBuffer::make_block(from_string(std::string(n, 'p')));
+    auto head = ChainBuffer::copy_block(header.data(), header.size());
+    for (auto _ : state) {
+        ChainBuffer rest(payload);
+        while (! rest.empty()) {
+            auto f = rest.split(256);
+            f.prepend(head);
+            benchmark::DoNotOptimize(f.size());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_chain_fragment)->Arg(65536);
+
+static void BM_substr_fragment(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto payload = from_string(std::string(n, 'p'));
+    for (auto _ : state) {
+        for (size_type pos = 0; pos < n; pos += 256) {
+            ByteBuffer f(header.size() + 256);
+            f.append(header.data(), header.size());
+            f.append(payload.const_ptr() + pos, std::min<size_type>(256, n - pos));
+            benchmark::DoNotOptimize(f.const_ptr());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_substr_fragment)->Arg(65536);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for ChainBuffer
+ *
+ * @author s3mat3
+ */
+
+#include <string>
+#include "chain_buffer.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+static auto flat(const ChainBuffer& c) -> std::string
+{
+    std::string s;
+    for (auto chunk : c) s.append(chunk);
+    return s;
+}
+
+TEST_CASE("Prepend and append segments without copy") {
+    auto payload = from_string("payload");
+    auto p = payload.const_ptr();
+    ChainBuffer frame(std::move(payload));
+    CHECK(frame.segment(0).m_block->const_ptr() == p); // moved, not copied
+    frame.prepend("HDR:"s);
+    frame.append("|CRC"s);
+    CHECK(frame.size() == 15);
+    CHECK(frame.segments() == 3);
+    CHECK(flat(frame) == "HDR:payload|CRC");
+    CHECK(frame.at(4) == 'p');
+    CHECK_THROWS_AS(frame.at(15), std::out_of_range);
+    CHECK(to_string(frame.coalesce()) == "HDR:payload|CRC");
+    ChainBuffer empty;
+    frame.append(empty).append(""s);
+    CHECK(frame.segments() == 3);
+}
+
+TEST_CASE("Shared blocks between chains") {
+    auto block = ChainBuffer::make_block(from_string("0123456789"));
+    ChainBuffer a, b;
+    a.append(block, 0, 5);
+    b.append(block, 5, 5).append(a);
+    CHECK(block.use_count() == 4);
+    CHECK(flat(b) == "5678901234");
+    a.clear();
+    CHECK(block.use_count() == 3);
+    ChainBuffer c;
+    c.prepend(b).prepend("<"s);
+    CHECK(flat(c) == "<5678901234");
+}
+
+TEST_CASE("Split and trim") {
+    auto block = ChainBuffer::make_block(from_string("abcdefghij"));
+    ChainBuffer frame;
+    frame.append(block).append("KLMNO"s).append(block, 0, 3);
+    REQUIRE(flat(frame) == "abcdefghijKLMNOabc");
+    auto head = frame.split(12); // boundary inside second segment
+    CHECK(flat(head) == "abcdefghijKL");
+    CHECK(flat(frame) == "MNOabc");
+    CHECK(head.size() + frame.size() == 18);
+    CHECK(head.segment(1).m_block == frame.segment(0).m_block); // shared, not copied
+    CHECK(frame.trim_front(2) == 2);
+    CHECK(frame.trim_back(4) == 4);
+    CHECK(flat(frame) == "");
+    CHECK(frame.empty());
+    CHECK(head.trim_back(3) == 3);
+    CHECK(head.trim_front(1) == 1);
+    CHECK(flat(head) == "bcdefghi");
+    CHECK(head.trim_front(100) == 8);
+    auto rest = head.split(10);
+    CHECK(rest.empty());
+    // fragmentation
+    ChainBuffer payload(from_string(std::string(1000, 'x')));
+    size_type fragments = 0;
+    while (! payload.empty()) {
+        auto f = payload.split(128);
+        f.prepend("#"s);
+        CHECK(f.size() == ((fragments < 7) ? 129u : 105u));
+        ++fragments;
+    }
+    CHECK(fragments == 8);
+}
+
+TEST_CASE("Export iovec and copy out") {
+    ChainBuffer frame;
+    frame.append("ab"s).append("cde"s).append("f"s);
+    auto v = frame.iovecs();
+    REQUIRE(v.size() == 3);
+    CHECK(v[1].iov_len == 3);
+    CHECK(std::string(static_cast<const char*>(v[1].iov_base), v[1].iov_len) == "cde");
+    ::iovec two[2];
+    CHECK(frame.fill_iovec(two) == 2);
+    char out[8] = {};
+    CHECK(frame.copy_to(out, 1, 4) == 4);
+    CHECK(std::string(out) == "bcde");
+    CHECK(frame.copy_to(out, 5, 10) == 1);
+}
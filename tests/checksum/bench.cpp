@@ -0,0 +1,88 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for checksum, bit loop VS slicing-by-8 VS hardware (run time dispatch)
+ *
+ * bytes_per_cycle counter is by TSC.
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <string>
+#include "benchmark/benchmark.h"
+
+#include "checksum.hpp"
+#include "profiler.hpp"
+
+using namespace Sml;
+
+static auto make_frame(size_type n) -> std::string
+{
+    std::string s(n, '\0');
+    for (size_type i = 0; i < n; ++i) s[i] = static_cast<char>((i * 131) & 0xff);
+    return s;
+}
+template <typename F>
+static void run(benchmark::State& state, F func) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto frame = make_frame(n);
+    auto p = reinterpret_cast<const std::uint8_t*>(frame.data());
+    auto begin = TscClock::now();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(func(p, n));
+        benchmark::ClobberMemory();
+    }
+    auto cycles = static_cast<double>(TscClock::now() - begin);
+    state.SetBytesProcessed(state.iterations() * n);
+    state.counters["bytes_per_cycle"] = static_cast<double>(state.iterations() * n) / cycles;
+}
+template <typename C>
+static void BM_bitwise(benchmark::State& state) {
+    using spec = typename C::spec_type;
+    run(state, [](const std::uint8_t* p, size_type n) {return Checksum::update_bitwise<spec>(spec::init, p, n);});
+}
+template <typename C>
+static void BM_slicing8(benchmark::State& state) {
+    using spec = typename C::spec_type;
+    run(state, [](const std::uint8_t* p, size_type n) {return Checksum::update_table<spec>(spec::init, p, n);});
+}
+template <typename C>
+static void BM_dispatch(benchmark::State& state) {
+    run(state, [](const std::uint8_t* p, size_type n) {return C::compute(p, n);});
+}
+/// byte loop of sum and xor as the naive reference
+static void BM_naive_lrc(benchmark::State& state) {
+    run(state, [](const std::uint8_t* p, size_type n) {
+        std::uint8_t s = 0;
+        for (size_type i = 0; i < n; ++i) {
+            s = static_cast<std::uint8_t>(s + p[i]);
+            benchmark::DoNotOptimize(s);
+        }
+        return static_cast<std::uint8_t>(-s);
+    });
+}
+static void BM_lrc(benchmark::State& state) {
+    run(state, [](const std::uint8_t* p, size_type n) {return Lrc::compute(p, n);});
+}
+static void BM_xor_sum(benchmark::State& state) {
+    run(state, [](const std::uint8_t* p, size_type n) {return XorSum::compute(p, n);});
+}
+
+#define SIZES ->Arg(16)->Arg(256)->Arg(4096)->Arg(65536)
+BENCHMARK(BM_bitwise<Crc16Modbus>) SIZES;
+BENCHMARK(BM_slicing8<Crc16Modbus>) SIZES;
+BENCHMARK(BM_slicing8<Crc16Ccitt>) SIZES;
+BENCHMARK(BM_bitwise<Crc32>) SIZES;
+BENCHMARK(BM_slicing8<Crc32>) SIZES;
+BENCHMARK(BM_dispatch<Crc32>) SIZES;
+BENCHMARK(BM_slicing8<Crc32c>) SIZES;
+BENCHMARK(BM_dispatch<Crc32c>) SIZES;
+BENCHMARK(BM_naive_lrc) SIZES;
+BENCHMARK(BM_lrc) SIZES;
+BENCHMARK(BM_xor_sum) SIZES;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,122 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for checksum (CRC, LRC, XOR sum)
+ *
+ * @author s3mat3
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+#include "byte_buffer.hpp"
+#include "checksum.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+static const std::string check_string = "123456789";
+
+/// random bytes
+static auto random_bytes(size_type n, unsigned seed = 1) -> std::string
+{
+    std::mt19937 gen(seed);
+    std::string s(n, '\0');
+    for (auto& c : s) c = static_cast<char>(gen() & 0xff);
+    return s;
+}
+template <typename C>
+static auto table_only(const std::string& s) -> typename C::value_type
+{
+    using spec = typename C::spec_type;
+    auto r = Checksum::update_table<spec>(spec::init, reinterpret_cast<const std::uint8_t*>(s.data()), s.size());
+    return static_cast<typename C::value_type>(r ^ spec::xorout);
+}
+template <typename C>
+static auto bitwise(const std::string& s) -> typename C::value_type
+{
+    using spec = typename C::spec_type;
+    auto r = Checksum::update_bitwise<spec>(spec::init, reinterpret_cast<const std::uint8_t*>(s.data()), s.size());
+    return static_cast<typename C::value_type>(r ^ spec::xorout);
+}
+
+/// computed during static initialization, before main
+static const auto static_crc32  = Crc32::compute("123456789", 9);
+static const auto static_crc32c = Crc32c::compute("123456789", 9);
+
+TEST_CASE("Check values of \"123456789\"") {
+    CHECK(Crc16Modbus::compute(check_string) == 0x4b37);
+    CHECK(Crc16Ccitt::compute(check_string)  == 0x29b1);
+    CHECK(Crc32::compute(check_string)       == 0xcbf43926);
+    CHECK(Crc32c::compute(check_string)      == 0xe3069283);
+    CHECK(Lrc::compute(check_string)         == 0x23); // sum 0x1dd
+    CHECK(XorSum::compute(check_string)      == 0x31);
+    CHECK(Crc32::compute("", 0) == 0);
+    CHECK(Crc16Modbus::compute("", 0) == 0xffff);
+}
+
+TEST_CASE("CRC from a namespace scope initializer") {
+    CHECK(static_crc32  == 0xcbf43926);
+    CHECK(static_crc32c == 0xe3069283);
+}
+
+TEST_CASE("Modbus RTU frame") {
+    // read holding registers, slave 1, address 0, count 10 => CRC c5cd (cd c5 on wire)
+    const unsigned char frame[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x0a};
+    CHECK(Crc16Modbus::compute(frame, sizeof(frame)) == 0xcdc5);
+    // Modbus ASCII ":01030000000A" LRC
+    CHECK(Lrc::compute(frame, sizeof(frame)) == 0xf2);
+}
+
+TEST_CASE("Incremental update equals one shot") {
+    auto data = random_bytes(1000);
+    for (size_type cut : {0u, 1u, 7u, 8u, 63u, 64u, 65u, 500u, 999u, 1000u}) {
+        auto head = data.substr(0, cut);
+        auto tail = data.substr(cut);
+        CHECK(Crc16Modbus().update(head).update(tail).value() == Crc16Modbus::compute(data));
+        CHECK(Crc16Ccitt().update(head).update(tail).value()  == Crc16Ccitt::compute(data));
+        CHECK(Crc32().update(head).update(tail).value()       == Crc32::compute(data));
+        CHECK(Crc32c().update(head).update(tail).value()      == Crc32c::compute(data));
+        CHECK(Lrc().update(head).update(tail).value()         == Lrc::compute(data));
+        CHECK(XorSum().update(head).update(tail).value()      == XorSum::compute(data));
+    }
+    Crc32 crc;
+    crc.update(data);
+    crc.reset();
+    CHECK(crc.update(check_string).value() == 0xcbf43926);
+}
+
+TEST_CASE("Slicing-by-8 and hardware path agree with bit loop") {
+    MESSAGE("CRC-32 accelerated: " << Crc32::accelerated() << ", CRC-32C accelerated: " << Crc32c::accelerated());
+    auto data = random_bytes(4096 + 64, 7);
+    std::mt19937 gen(3);
+    for (int i = 0; i < 300; ++i) {
+        auto offset = gen() % 64;
+        auto length = (i < 200) ? static_cast<size_type>(i) : gen() % 4096;
+        auto s = data.substr(offset, length);
+        CHECK(table_only<Crc16Modbus>(s) == bitwise<Crc16Modbus>(s));
+        CHECK(table_only<Crc16Ccitt>(s)  == bitwise<Crc16Ccitt>(s));
+        CHECK(table_only<Crc32>(s)       == bitwise<Crc32>(s));
+        CHECK(table_only<Crc32c>(s)      == bitwise<Crc32c>(s));
+        // unaligned pointer into data
+        CHECK(Crc32::compute(data.data() + offset, length)  == bitwise<Crc32>(s));
+        CHECK(Crc32c::compute(data.data() + offset, length) == bitwise<Crc32c>(s));
+    }
+}
+
+TEST_CASE("BufferBase and ranges") {
+    auto buff = from_string(check_string);
+    CHECK(Crc16Modbus::compute(buff) == 0x4b37);
+    CHECK(Crc32().update(buff).value() == 0xcbf43926);
+    std::vector<unsigned char> v(check_string.begin(), check_string.end());
+    CHECK(Crc32c::compute(v) == 0xe3069283);
+    CHECK(Crc16Ccitt::compute(std::span<const unsigned char>(v)) == 0x29b1);
+    CHECK(Lrc().update(buff).value() == 0x23);
+    CHECK(XorSum().update(std::string_view(check_string)).value() == 0x31);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for message encode / decode, Writer / Reader VS push_back / read() per byte
+ *
+ * message : u8 kind, u16 id, u32 sequence, u64 time stamp, f64 value, varint length (24 to 28 bytes)
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <bit>
+#include "benchmark/benchmark.h"
+
+#include "byte_buffer.hpp"
+#include "codec.hpp"
+
+using namespace Sml;
+
+static constexpr size_type MESSAGES = 1000;
+using Fixed = Schema<std::endian::big, std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, double>;
+
+/// previous style, big endian by shift and push_back per byte
+template <typename T>
+static auto push_be(ByteBuffer& b, T v) -> void
+{
+    auto u = std::bit_cast<Codec::bits_t<T>>(v);
+    for (int i = sizeof(T) - 1; i >= 0; --i) b.push_back(static_cast<char>(u >> (i * 8)));
+}
+template <typename T>
+static auto read_be(ByteBuffer& b) -> T
+{
+    Codec::bits_t<T> u = 0;
+    for (size_type i = 0; i < sizeof(T); ++i) u = static_cast<Codec::bits_t<T>>((u << 8) | static_cast<std::uint8_t>(b.read()));
+    return std::bit_cast<T>(u);
+}
+
+static void BM_encode_push_back(benchmark::State& state) {
+    ByteBuffer b(64);
+    for (auto _ : state) {
+        b.clear();
+        for (std::uint32_t i = 0; i < MESSAGES; ++i) {
+            push_be(b, std::uint8_t{1});
+            push_be(b, static_cast<std::uint16_t>(i));
+            push_be(b, i);
+            push_be(b, std::uint64_t{i} * 1000);
+            push_be(b, i * 0.5);
+            for (std::uint64_t v = i; ; v >>= 7) {
+                if (v < 0x80) {
+                    b.push_back(static_cast<char>(v));
+                    break;
+                }
+                b.push_back(static_cast<char>(v | 0x80));
+            }
+        }
+        benchmark::DoNotOptimize(b.const_ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_encode_push_back);
+
+/// checked write per field
+static void BM_encode_writer(benchmark::State& state) {
+    ByteBuffer b(64);
+    for (auto _ : state) {
+        b.clear();
+        Writer w(b);
+        for (std::uint32_t i = 0; i < MESSAGES; ++i) {
+            w.write(std::uint8_t{1}).write(static_cast<std::uint16_t>(i)).write(i).write(std::uint64_t{i} * 1000).write(i * 0.5).write_varint(i);
+        }
+        w.commit();
+        benchmark::DoNotOptimize(b.const_ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_encode_writer);
+
+/// one reserve per message, unchecked put (schema)
+static void BM_encode_schema(benchmark::State& state) {
+    ByteBuffer b(64);
+    for (auto _ : state) {
+        b.clear();
+        Writer w(b);
+        for (std::uint32_t i = 0; i < MESSAGES; ++i) {
+            w.reserve(Fixed::size + Codec::max_varint);
+            Fixed::encode(w, 1, static_cast<std::uint16_t>(i), i, std::uint64_t{i} * 1000, i * 0.5);
+            w.put_varint(i);
+        }
+        w.commit();
+        benchmark::DoNotOptimize(b.const_ptr());
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_encode_schema);
+
+static auto encoded() -> ByteBuffer
+{
+    ByteBuffer b(64);
+    Writer w(b);
+    for (std::uint32_t i = 0; i < MESSAGES; ++i) {
+        Fixed::encode(w, 1, static_cast<std::uint16_t>(i), i, std::uint64_t{i} * 1000, i * 0.5);
+        w.write_varint(i);
+    }
+    w.commit();
+    return ByteBuffer(std::move(b));
+}
+
+static void BM_decode_read(benchmark::State& state) {
+    auto b = encoded();
+    for (auto _ : state) {
+        b.position(0);
+        std::uint64_t sum = 0;
+        for (size_type i = 0; i < MESSAGES; ++i) {
+            sum += read_be<std::uint8_t>(b) + read_be<std::uint16_t>(b) + read_be<std::uint32_t>(b) + read_be<std::uint64_t>(b);
+            sum += static_cast<std::uint64_t>(read_be<double>(b));
+            std::uint64_t v = 0;
+            for (unsigned shift = 0; ; shift += 7) {
+                auto c = static_cast<std::uint8_t>(b.read());
+                v |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+                if ((c & 0x80) == 0) break;
+            }
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_decode_read);
+
+static void BM_decode_reader(benchmark::State& state) {
+    auto b = encoded();
+    for (auto _ : state) {
+        Reader r(b);
+        std::uint64_t sum = 0;
+        for (size_type i = 0; i < MESSAGES; ++i) {
+            std::uint8_t k {};
+            std::uint16_t id {};
+            std::uint32_t seq {};
+            std::uint64_t ts {};
+            double value {};
+            std::uint64_t v {};
+            if (Fixed::decode(r, k, id, seq, ts, value) != OK || r.read_varint(v) != OK) {
+                state.SkipWithError("decode");
+                break;
+            }
+            sum += k + id + seq + ts + static_cast<std::uint64_t>(value) + v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+BENCHMARK(BM_decode_reader);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for binary codec (Writer, Reader, Schema)
+ *
+ * @author s3mat3
+ */
+
+#include <limits>
+#include "byte_buffer.hpp"
+#include "codec.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using namespace std::literals::string_view_literals;
+
+enum class Kind : std::uint16_t {ping = 0x0102, pong = 0x0304};
+
+TEST_CASE("byteswap") {
+    static_assert(byteswap(std::uint16_t{0x1234}) == 0x3412);
+    static_assert(byteswap(std::uint32_t{0x12345678}) == 0x78563412);
+    static_assert(byteswap(std::uint64_t{0x0102030405060708}) == 0x0807060504030201);
+    static_assert(byteswap(std::uint8_t{0xab}) == 0xab);
+}
+
+TEST_CASE("Fixed width big and little endian") {
+    ByteBuffer b(4);
+    {
+        Writer w(b);
+        w.write(std::uint8_t{0x01})
+         .write(std::uint16_t{0x0203})
+         .write<std::endian::little>(std::uint32_t{0x07060504})
+         .write(std::int64_t{-2})
+         .write(Kind::pong);
+        CHECK(w.written() == 17);
+    }
+    REQUIRE(b.size() == 17); // grown from 4 and committed by destructor
+    CHECK(to_string(b).substr(0, 7) == "\x01\x02\x03\x04\x05\x06\x07"s);
+    Reader r(b);
+    std::uint8_t u8 = 0;
+    std::uint16_t u16 = 0;
+    std::uint32_t u32 = 0;
+    std::int64_t i64 = 0;
+    Kind k {};
+    CHECK(r.read(u8) == OK);
+    CHECK(r.read(u16) == OK);
+    CHECK(r.read<std::endian::little>(u32) == OK);
+    CHECK(r.read(i64) == OK);
+    CHECK(r.read(k) == OK);
+    CHECK(u8 == 0x01);
+    CHECK(u16 == 0x0203);
+    CHECK(u32 == 0x07060504);
+    CHECK(i64 == -2);
+    CHECK(k == Kind::pong);
+    CHECK(r.read(u8) == OUT_OF_RANGE);
+    CHECK(r.consumed() == 17);
+}
+
+TEST_CASE("Floating point and unchecked put after reserve") {
+    ByteBuffer b(64);
+    Writer w(b);
+    w.reserve(12).put(1.5f).put<std::endian::little>(-0.25);
+    CHECK(w.written() == 12);
+    w.commit();
+    CHECK(b.size() == 12);
+    CHECK(to_string(b).substr(0, 4) == "\x3f\xc0\x00\x00"s);
+    Reader r(b);
+    REQUIRE(r.require(12));
+    CHECK(r.get<float>() == 1.5f);
+    CHECK(r.get<double, std::endian::little>() == -0.25);
+}
+
+TEST_CASE("LEB128 varint and zigzag") {
+    ByteBuffer b(16);
+    const std::uint64_t values[] = {0, 1, 127, 128, 300, 16384, std::numeric_limits<std::uint64_t>::max()};
+    {
+        Writer w(b);
+        for (auto v : values) w.write_varint(v);
+        w.write_zigzag(-1).write_zigzag(63).write_zigzag(-64).write_zigzag(std::numeric_limits<std::int64_t>::min());
+    }
+    CHECK(to_string(b).substr(0, 6) == "\x00\x01\x7f\x80\x01\xac"s);
+    CHECK(Codec::varint_size(0) == 1);
+    CHECK(Codec::varint_size(300) == 2);
+    CHECK(Codec::varint_size(std::numeric_limits<std::uint64_t>::max()) == 10);
+    Reader r(b);
+    for (auto v : values) {
+        std::uint64_t x = 0;
+        CHECK(r.read_varint(x) == OK);
+        CHECK(x == v);
+    }
+    std::int64_t s = 0;
+    CHECK(r.read_zigzag(s) == OK);
+    CHECK(s == -1);
+    CHECK(r.read_zigzag(s) == OK);
+    CHECK(s == 63);
+    CHECK(r.read_zigzag(s) == OK);
+    CHECK(s == -64);
+    CHECK(r.read_zigzag(s) == OK);
+    CHECK(s == std::numeric_limits<std::int64_t>::min());
+    std::uint64_t x = 0;
+    CHECK(Reader("\x80\x80"sv).read_varint(x) == OUT_OF_RANGE);
+    CHECK(Reader(std::string_view("\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 11)).read_varint(x) == FAILURE);
+    CHECK(Reader(std::string_view("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02", 10)).read_varint(x) == FAILURE); // bit 64
+    CHECK(Reader(std::string_view("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x7f", 10)).read_varint(x) == FAILURE);
+    CHECK(Reader(std::string_view("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 10)).read_varint(x) == OK);
+    CHECK(x == std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST_CASE("Schema of fixed layout") {
+    using Header = Schema<std::endian::big, std::uint8_t, std::uint16_t, std::uint32_t, double>;
+    static_assert(Header::size == 15);
+    static_assert(Header::offset<0>() == 0);
+    static_assert(Header::offset<2>() == 3);
+    static_assert(Header::offset<3>() == 7);
+    ByteBuffer b(8);
+    {
+        Writer w(b);
+        Header::encode(w, 0x10, 0x1234, 0xdeadbeef, 3.5);
+        Header::encode(w, Header::tuple_type{0x20, 1, 2, -1.0});
+        w.write_bytes("tail"sv);
+    }
+    CHECK(b.size() == 34);
+    CHECK(Header::field<2>(b.const_ptr()) == 0xdeadbeef);
+    Reader r(b);
+    std::uint8_t a = 0;
+    std::uint16_t c = 0;
+    std::uint32_t d = 0;
+    double e = 0;
+    CHECK(Header::decode(r, a, c, d, e) == OK);
+    CHECK(a == 0x10);
+    CHECK(c == 0x1234);
+    CHECK(d == 0xdeadbeef);
+    CHECK(e == 3.5);
+    Header::tuple_type t;
+    CHECK(Header::decode(r, t) == OK);
+    CHECK(t == Header::tuple_type{0x20, 1, 2, -1.0});
+    CHECK(Header::decode(r, t) == OUT_OF_RANGE);
+    std::string_view tail;
+    CHECK(r.read_bytes(4, tail) == OK);
+    CHECK(tail == "tail");
+    b.consume(r.consumed());
+    CHECK(b.size() == 0);
+}
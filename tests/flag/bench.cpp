@@ -0,0 +1,56 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for FlagRegister under contention
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include "benchmark/benchmark.h"
+
+#include "flag.hpp"
+
+using namespace Sml;
+
+static FlagRegister shared_register;
+
+/// each thread sets / resets own bit
+static void BM_set_reset(benchmark::State& state) {
+    const auto bit = FlagRegister::shl(static_cast<size_t>(state.thread_index()));
+    for (auto _ : state) {
+        shared_register.set(bit);
+        shared_register.reset(bit);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_set_reset)->ThreadRange(1, 8)->UseRealTime();
+
+/// readers only
+static void BM_is_set(benchmark::State& state) {
+    const auto bit = FlagRegister::shl(static_cast<size_t>(state.thread_index()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared_register.is_set(bit));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_is_set)->ThreadRange(1, 8)->UseRealTime();
+
+/// thread 0 writes, others read
+static void BM_one_writer_many_readers(benchmark::State& state) {
+    const auto bit = FlagRegister::shl(static_cast<size_t>(state.thread_index()));
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            shared_register.set_reset(bit, FlagRegister::shl(63));
+        } else {
+            benchmark::DoNotOptimize(shared_register.is_set(bit));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_one_writer_many_readers)->ThreadRange(2, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,265 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for Fsm::dispatch throughput on SignalTower machine (examples/fsm)
+ *        and ticks of many instances, Fsm objects vs FsmPool (structure of arrays),
+ *        FsmRuntime scaling by shards (worker threads), restart by snapshot vs replay
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+#include "signal_tower.hpp"
+#include "fsm_pool.hpp"
+#include "fsm_runtime.hpp"
+#include "fsm_snapshot.hpp"
+
+using namespace Sml;
+
+/// stay event in green state (doActivity only, timer not expired)
+static void BM_dispatch_stay(benchmark::State& state) {
+    SignalTower st;
+    SignalFSM fsm(&st);
+    fsm.dispatch(SignalEvent::green); // idle -> green
+    for (auto _ : state) {
+        fsm.dispatch(SignalEvent::stay);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_dispatch_stay);
+
+/// state change every dispatch (exit, next lookup, entry, doActivity)
+static void BM_dispatch_transition(benchmark::State& state) {
+    SignalTower st;
+    SignalFSM fsm(&st);
+    for (auto _ : state) {
+        fsm.dispatch(SignalEvent::green);  // idle -> green
+        fsm.dispatch(SignalEvent::broken); // green -> idle
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_dispatch_transition);
+
+/// event driven by context (same as SignalFSM::onAnyEvent loop)
+static void BM_dispatch_context_event(benchmark::State& state) {
+    SignalTower st;
+    SignalFSM fsm(&st);
+    for (auto _ : state) {
+        fsm.dispatch(st.event());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_dispatch_context_event);
+
+/// same as BM_dispatch_stay / transition without transition trace (overhead of FsmTrace)
+static void BM_dispatch_stay_untraced(benchmark::State& state) {
+    SignalTower st;
+    SignalFSM fsm(&st);
+    fsm.trace().capacity(0);
+    fsm.dispatch(SignalEvent::green);
+    for (auto _ : state) {
+        fsm.dispatch(SignalEvent::stay);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_dispatch_stay_untraced);
+static void BM_dispatch_transition_untraced(benchmark::State& state) {
+    SignalTower st;
+    SignalFSM fsm(&st);
+    fsm.trace().capacity(0);
+    for (auto _ : state) {
+        fsm.dispatch(SignalEvent::green);
+        fsm.dispatch(SignalEvent::broken);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_dispatch_transition_untraced);
+
+/// many instances : cyclic machine a -> b -> c -> a, stays N ticks in each state
+namespace {
+    constexpr int dwell = 8;
+    struct Cycle
+    {
+        int           m_ticks {0};
+        Sml::event_id m_event {FsmEvent::stay};
+
+        auto snapshot(Writer& w) const -> void {w.write_varint(static_cast<std::uint64_t>(m_ticks));}
+        auto restore(Reader& r) -> return_code
+        {
+            std::uint64_t t = 0;
+            auto ret = r.read_varint(t);
+            m_ticks = static_cast<int>(t);
+            return ret;
+        }
+    };
+    struct CycleEvent
+    {
+        static constexpr event_id next = FsmEvent::stay + 1;
+    };
+    class cycle_state : public State<Cycle>
+    {
+    public:
+        using state_type::state_type;
+        auto entry() noexcept -> void override {m_context->m_ticks = 0;}
+        auto doActivity() noexcept -> void override
+        {
+            m_context->m_event = (++m_context->m_ticks >= dwell) ? CycleEvent::next : FsmEvent::stay;
+        }
+    };
+    class CycleFSM : public Fsm<Cycle>
+    {
+    public:
+        CycleFSM(context_ptr context)
+            : Fsm<Cycle>(context)
+            , m_a {std::make_shared<cycle_state>(1, "a", context)}
+            , m_b {std::make_shared<cycle_state>(2, "b", context)}
+            , m_c {std::make_shared<cycle_state>(3, "c", context)}
+        {
+            addTransition(m_a, CycleEvent::next, m_b);
+            addTransition(m_b, CycleEvent::next, m_c);
+            addTransition(m_c, CycleEvent::next, m_a);
+            initial(m_a);
+        }
+    private:
+        state_ptr m_a {nullptr};
+        state_ptr m_b {nullptr};
+        state_ptr m_c {nullptr};
+    };
+    using CyclePool = FsmPool<Cycle>;
+    auto build(CyclePool& p) -> void
+    {
+        auto entry = [](CyclePool& p, CyclePool::instance_id id) noexcept {p.context(id).m_ticks = 0;};
+        auto act   = [](CyclePool& p, CyclePool::instance_id id) noexcept {
+            if (++p.context(id).m_ticks >= dwell) p.post(id, CycleEvent::next);
+        };
+        auto a = p.add_state("a", entry, act, nullptr);
+        auto b = p.add_state("b", entry, act, nullptr);
+        auto c = p.add_state("c", entry, act, nullptr);
+        p.add_transition(a, CycleEvent::next, b);
+        p.add_transition(b, CycleEvent::next, c);
+        p.add_transition(c, CycleEvent::next, a);
+    }
+} // namespace
+
+/// one tick of N individual Fsm objects (each dispatches event of own context)
+static void BM_instances_fsm(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    std::vector<Cycle> contexts(n);
+    std::vector<std::unique_ptr<CycleFSM>> machines;
+    for (auto& c : contexts) machines.push_back(std::make_unique<CycleFSM>(&c));
+    for (auto _ : state) {
+        for (size_type i = 0; i < n; ++i) machines[i]->dispatch(contexts[i].m_event);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["ticks/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_instances_fsm)->Arg(10000);
+
+/// one tick of N instances in FsmPool (arg 1 : worker threads)
+static void BM_instances_pool(benchmark::State& state) {
+    CyclePool pool(static_cast<size_type>(state.range(0)));
+    build(pool);
+    pool.workers(static_cast<size_type>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.step(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["ticks/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_instances_pool)->Args({10000, 0})->Args({10000, 1})->Args({10000, 3})->Args({100000, 0})->Args({100000, 3})->UseRealTime();
+
+/// events routed to 10k CycleFSM on 1 .. N shards (arg : shards), posted by one producer
+static void BM_runtime_shards(benchmark::State& state) {
+    constexpr size_type n = 10000;
+    constexpr size_type burst = 50000;
+    std::vector<Cycle> contexts(n);
+    FsmRuntime<CycleFSM> rt(static_cast<size_type>(state.range(0)), 16384);
+    for (auto& c : contexts) rt.add(std::make_unique<CycleFSM>(&c));
+    rt.start(true);
+    FsmRuntime<CycleFSM>::instance_id id = 0;
+    for (auto _ : state) {
+        for (size_type k = 0; k < burst; ++k) {
+            while (rt.post(id, FsmEvent::stay) != OK) std::this_thread::yield();
+            if (++id == n) id = 0;
+        }
+        rt.drain();
+    }
+    rt.stop();
+    auto total = rt.stats();
+    state.SetItemsProcessed(static_cast<std::int64_t>(total.m_dispatched));
+    state.counters["max_depth"] = static_cast<double>(total.m_max_depth);
+    state.counters["parks"] = static_cast<double>(total.m_parks);
+}
+BENCHMARK(BM_runtime_shards)->DenseRange(1, static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)))->UseRealTime();
+
+/// restart of 10k CycleFSM : construct and reach state by replaying event log (arg : events per machine, 0 : construct only)
+namespace {
+    constexpr size_type restart_machines = 10000;
+    struct Machines
+    {
+        std::vector<Cycle>                     m_contexts {};
+        std::vector<std::unique_ptr<CycleFSM>> m_fsm      {};
+        Machines() : m_contexts(restart_machines)
+        {
+            m_fsm.reserve(restart_machines);
+            for (auto& c : m_contexts) m_fsm.push_back(std::make_unique<CycleFSM>(&c));
+        }
+    };
+    auto snapshot_path() -> std::string
+    {
+        return (std::filesystem::temp_directory_path() / "sml_fsm_bench.snap").string();
+    }
+} // namespace
+static void BM_restart_replay(benchmark::State& state) {
+    auto events = state.range(0);
+    for (auto _ : state) {
+        Machines m;
+        for (size_type i = 0; i < restart_machines; ++i) {
+            for (std::int64_t k = 0; k < events; ++k) m.m_fsm[i]->dispatch(m.m_contexts[i].m_event);
+        }
+        benchmark::DoNotOptimize(m.m_contexts.back().m_ticks);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(restart_machines));
+}
+BENCHMARK(BM_restart_replay)->Arg(0)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+/// restart of 10k CycleFSM : construct and restore from memory mapped snapshot file
+static void BM_restart_snapshot(benchmark::State& state) {
+    {
+        Machines m;
+        for (size_type i = 0; i < restart_machines; ++i) {
+            for (size_type k = 0; k < i % 64; ++k) m.m_fsm[i]->dispatch(m.m_contexts[i].m_event);
+        }
+        if (FsmSnapshotFile::save(snapshot_path(), m.m_fsm) != OK) state.SkipWithError("save");
+    }
+    for (auto _ : state) {
+        Machines m;
+        FsmSnapshotFile f;
+        if (f.open(snapshot_path()) != OK || f.restore(m.m_fsm) != OK) state.SkipWithError("restore");
+        benchmark::DoNotOptimize(m.m_contexts.back().m_ticks);
+    }
+    std::filesystem::remove(snapshot_path());
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(restart_machines));
+}
+BENCHMARK(BM_restart_snapshot)->Unit(benchmark::kMillisecond);
+
+/// bulk snapshot of 10k CycleFSM to file (arg : durable)
+static void BM_snapshot_save(benchmark::State& state) {
+    Machines m;
+    for (auto _ : state) {
+        if (FsmSnapshotFile::save(snapshot_path(), m.m_fsm, state.range(0) != 0) != OK) state.SkipWithError("save");
+    }
+    std::filesystem::remove(snapshot_path());
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(restart_machines));
+}
+BENCHMARK(BM_snapshot_save)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,526 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for Fsm transition trace, FsmPool (structure of arrays state machine instances)
+ *        FsmRuntime (sharded worker threads) and snapshot / restore
+ *
+ * @author s3mat3
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fsm_pool.hpp"
+#include "fsm_runtime.hpp"
+#include "fsm_snapshot.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+namespace {
+    struct Ev
+    {
+        static constexpr event_id start   = FsmEvent::stay + 1;
+        static constexpr event_id stop    = FsmEvent::stay + 2;
+        static constexpr event_id timeout = FsmEvent::stay + 3;
+    };
+    struct Counter
+    {
+        int m_entry {0};
+        int m_do    {0};
+        int m_exit  {0};
+        int m_fired {0};
+
+        auto snapshot(Writer& w) const -> void {w.write_zigzag(m_do).write_zigzag(m_fired);}
+        auto restore(Reader& r) -> return_code
+        {
+            std::int64_t d = 0, f = 0;
+            if (auto ret = r.read_zigzag(d); ret != OK) return ret;
+            m_do = static_cast<int>(d); // partially restored when m_fired is missing
+            if (auto ret = r.read_zigzag(f); ret != OK) return ret;
+            m_fired = static_cast<int>(f);
+            return OK;
+        }
+    };
+    using Pool = FsmPool<Counter>;
+
+    /// idle -(start)-> run -(stop)-> idle, run -(timeout)-> run (re-arm 10ms)
+    auto build(Pool& p) -> void
+    {
+        auto idle = p.add_state("idle", nullptr, nullptr, nullptr);
+        auto run  = p.add_state("run",
+                                [](Pool& p, Pool::instance_id id) noexcept {++p.context(id).m_entry; p.arm(id, 10);},
+                                [](Pool& p, Pool::instance_id id) noexcept {++p.context(id).m_do;},
+                                [](Pool& p, Pool::instance_id id) noexcept {++p.context(id).m_exit; p.disarm(id);});
+        p.add_transition(idle, Ev::start, run);
+        p.add_transition(run, Ev::stop, idle);
+        p.add_transition(run, Ev::timeout, run);
+        p.timeout_event(Ev::timeout);
+    }
+    constexpr Pool::tick_type ms = 1000000;
+
+    /// State based machine for trace
+    class counting_state : public State<Counter>
+    {
+    public:
+        using state_type::state_type;
+        auto entry() noexcept -> void override {++m_context->m_entry;}
+        auto doActivity() noexcept -> void override {++m_context->m_do;}
+        auto exit() noexcept -> void override {++m_context->m_exit;}
+    };
+    class TracedFSM : public Fsm<Counter>
+    {
+    public:
+        TracedFSM(context_ptr context)
+            : Fsm<Counter>(context)
+            , m_idle {std::make_shared<counting_state>(1, "idle", context)}
+            , m_run  {std::make_shared<counting_state>(2, "run", context)}
+        {
+            addTransition(m_idle, Ev::start, m_run);
+            addTransition(m_idle, Ev::stop, m_idle);
+            addTransition(m_run, Ev::stop, m_idle);
+            initial(m_idle);
+        }
+    private:
+        state_ptr m_idle {nullptr};
+        state_ptr m_run  {nullptr};
+    };
+} // namespace
+
+TEST_CASE("Fsm trace records transitions and state statistics") {
+    Counter c;
+    TracedFSM fsm(&c);
+    CHECK(fsm.trace().enabled());
+    CHECK(fsm.trace().capacity() == FsmTrace::default_capacity);
+    CHECK_FALSE(fsm.trace().allocated()); // ring is allocated by first dispatch
+    fsm.dispatch(FsmEvent::stay);       // idle
+    CHECK(fsm.trace().allocated());
+    fsm.dispatch(Ev::start);            // idle -> run
+    fsm.dispatch(FsmEvent::stay);
+    fsm.dispatch(FsmEvent::stay);
+    fsm.dispatch(Ev::stop);             // run -> idle
+    fsm.dispatch(Ev::stop);             // idle -> idle (self transition)
+    fsm.dispatch(FsmEvent::void_event); // ignored
+    auto& t = fsm.trace();
+    CHECK(t.recorded() == 3);
+    auto rs = t.records();
+    REQUIRE(rs.size() == 3);
+    CHECK(rs[0].m_from == 1);
+    CHECK(rs[0].m_event == Ev::start);
+    CHECK(rs[0].m_to == 2);
+    CHECK(rs[1].m_from == 2);
+    CHECK(rs[1].m_to == 1);
+    CHECK(rs[2].m_from == 1);
+    CHECK(rs[2].m_to == 1);
+    CHECK(rs[0].m_tick <= rs[1].m_tick);
+    CHECK(rs[1].m_tick <= rs[2].m_tick);
+    auto& st = t.stats();
+    REQUIRE(st.size() == 2);
+    CHECK(st[0].m_name == "idle");
+    CHECK(st[0].m_stays == 1);
+    CHECK(st[0].m_entries == 2);
+    CHECK(st[0].m_visits == 1);      // first visit (initial) has no entry time
+    CHECK(st[1].m_name == "run");
+    CHECK(st[1].m_entries == 1);
+    CHECK(st[1].m_stays == 2);
+    CHECK(st[1].m_visits == 1);
+    CHECK(st[1].m_dwell == rs[1].m_tick - rs[0].m_tick);
+    CHECK(st[1].m_dwell_max == st[1].m_dwell);
+    CHECK_FALSE(t.timing());         // doActivity is not measured by default
+    CHECK(rs[0].m_do == 0);
+    CHECK(st[1].m_do == 0);
+    std::ostringstream os;
+    t.dump(os);
+    CHECK(os.str().find("# fsm trace 3 of 3") == 0);
+    CHECK(os.str().find("1 -(1)-> 2") != std::string::npos);
+    CHECK(os.str().find("\n2 run 1 2 ") != std::string::npos);
+}
+
+TEST_CASE("Fsm trace ring keeps last records") {
+    Counter c;
+    TracedFSM fsm(&c);
+    fsm.trace().capacity(3);            // rounded up to 4
+    CHECK(fsm.trace().capacity() == 4);
+    for (int i = 0; i < 5; ++i) {
+        fsm.dispatch(Ev::start);
+        fsm.dispatch(Ev::stop);
+    }
+    CHECK(fsm.trace().recorded() == 10);
+    auto rs = fsm.trace().records();
+    REQUIRE(rs.size() == 4);
+    CHECK(rs.front().m_event == Ev::start);
+    CHECK(rs.back().m_event == Ev::stop);
+    CHECK(fsm.trace().stats()[1].m_entries == 5);
+    fsm.trace().capacity(0);            // disabled
+    fsm.dispatch(Ev::start);
+    CHECK_FALSE(fsm.trace().enabled());
+    CHECK(fsm.trace().recorded() == 0);
+    CHECK(fsm.trace().records().empty());
+    CHECK_FALSE(fsm.trace().allocated());
+    CHECK(c.m_entry == 11);             // dispatch is not affected
+    fsm.trace().capacity(8);            // enabled again, slots cached in states are stale
+    fsm.dispatch(Ev::stop);
+    fsm.dispatch(Ev::start);
+    CHECK(fsm.trace().recorded() == 2);
+    REQUIRE(fsm.trace().stats().size() == 2);
+    CHECK(fsm.trace().stats()[0].m_id == 2);
+    CHECK(fsm.trace().stats()[1].m_entries == 1);
+}
+
+TEST_CASE("Fsm trace statistics are keyed on state id") {
+    Counter c;
+    Fsm<Counter> fsm(&c);
+    fsm.trace().timing(true);
+    auto idle = std::make_shared<counting_state>(1, "idle", &c);
+    auto run  = std::make_shared<counting_state>(2, "run", &c);
+    fsm.addTransition(idle, Ev::start, run);
+    fsm.addTransition(run, Ev::stop, idle);
+    fsm.initial(idle);
+    fsm.dispatch(Ev::start);
+    fsm.dispatch(Ev::stop);
+    run.reset();                        // freed, the next state may reuse its address
+    auto other = std::make_shared<counting_state>(3, "other", &c);
+    fsm.addTransition(idle, Ev::start, other);
+    fsm.dispatch(Ev::start);
+    auto& st = fsm.trace().stats();
+    REQUIRE(st.size() == 3);
+    CHECK(st[1].m_id == 2);
+    CHECK(st[1].m_entries == 1);
+    CHECK(st[2].m_id == 3);
+    CHECK(st[2].m_name == "other");
+    CHECK(st[2].m_entries == 1);
+    CHECK(fsm.trace().records().back().m_to == 3);
+}
+
+TEST_CASE("FsmPool definition") {
+    Pool p(4);
+    build(p);
+    CHECK(p.size() == 4);
+    CHECK(p.states() == 2);
+    CHECK(p.next(0, Ev::start) == 1);
+    CHECK(p.next(0, Ev::stop) == Pool::no_state);
+    CHECK(p.next(1, 99) == Pool::no_state);
+    CHECK(p.next(1, -1) == Pool::no_state);
+    CHECK(p.add_transition(0, -1, 1) == OUT_OF_RANGE);
+    CHECK(p.add_transition(0, 1, 7) == OUT_OF_RANGE);
+    CHECK(p.state_name(3) == "idle");
+    // widening the table keeps existing transitions
+    CHECK(p.add_transition(1, 20, 0) == OK);
+    CHECK(p.next(0, Ev::start) == 1);
+    CHECK(p.next(1, Ev::timeout) == 1);
+    CHECK(p.next(1, 20) == 0);
+}
+
+TEST_CASE("FsmPool rejects states over state_index") {
+    Pool p;
+    for (size_type i = 0; i < Pool::no_state; ++i) REQUIRE(p.add_state("s", nullptr, nullptr, nullptr) == static_cast<Pool::state_index>(i));
+    CHECK(p.add_state("over", nullptr, nullptr, nullptr) == Pool::no_state);
+    CHECK(p.states() == Pool::no_state);
+    CHECK(p.add_transition(0, Ev::start, Pool::no_state) == OUT_OF_RANGE);
+}
+
+TEST_CASE("FsmPool dispatch same as Fsm") {
+    Pool p(2);
+    build(p);
+    p.dispatch(0, Ev::start);
+    CHECK(p.state(0) == 1);
+    CHECK(p.state(1) == 0);
+    CHECK(p.context(0).m_entry == 1);
+    CHECK(p.context(0).m_do == 1);
+    p.dispatch(0, FsmEvent::stay);  // doActivity only
+    CHECK(p.context(0).m_do == 2);
+    CHECK(p.context(0).m_exit == 0);
+    p.dispatch(0, Ev::start);       // not assigned, stays (exit, entry, do)
+    CHECK(p.state(0) == 1);
+    CHECK(p.context(0).m_exit == 1);
+    CHECK(p.context(0).m_entry == 2);
+    p.dispatch(0, FsmEvent::void_event); // ignored
+    CHECK(p.context(0).m_do == 3);
+    p.dispatch(0, Ev::stop);
+    CHECK(p.state_name(0) == "idle");
+}
+
+TEST_CASE("FsmPool step posted events and timers") {
+    Pool p(3);
+    build(p);
+    p.idle_event(FsmEvent::void_event);
+    p.resize(3);
+    CHECK(p.step(0) == 3);          // created before idle_event(), pending stay
+    CHECK(p.step(0) == 0);          // nothing pending
+    p.post(1, Ev::start);
+    CHECK(p.step(1 * ms) == 1);
+    CHECK(p.state(1) == 1);
+    CHECK(p.deadline(1) == 11 * ms);
+    CHECK(p.step(5 * ms) == 0);
+    CHECK(p.step(11 * ms) == 1);    // timeout
+    CHECK(p.context(1).m_entry == 2);
+    CHECK(p.deadline(1) == 21 * ms);
+    // posted event and expired timer at once : posted first, timeout by next step
+    p.post(1, Ev::start);
+    CHECK(p.step(30 * ms) == 1);
+    CHECK(p.pending(1) == Ev::timeout);
+    CHECK(p.step(30 * ms) == 1);
+    CHECK(p.pending(1) == FsmEvent::void_event);
+    p.post(1, Ev::stop);
+    CHECK(p.step(31 * ms) == 1);
+    CHECK(p.state(1) == 0);
+    CHECK(p.deadline(1) == Pool::disarmed);
+    CHECK(p.step(100 * ms) == 0);
+}
+
+TEST_CASE("FsmPool stay runs doActivity every step") {
+    Pool p(5);
+    build(p);
+    for (Pool::instance_id i = 0; i < 5; ++i) p.dispatch(i, Ev::start);
+    for (int k = 0; k < 3; ++k) CHECK(p.step(0) == 5);
+    for (Pool::instance_id i = 0; i < 5; ++i) CHECK(p.context(i).m_do == 4);
+}
+
+TEST_CASE("FsmPool workers step same as single thread") {
+    constexpr size_type n = 1000;
+    Pool single(n), multi(n);
+    build(single);
+    build(multi);
+    multi.workers(3);
+    CHECK(multi.workers() == 3);
+    for (Pool::instance_id i = 0; i < n; i += 3) {
+        single.post(i, Ev::start);
+        multi.post(i, Ev::start);
+    }
+    for (Pool::tick_type t = 0; t < 50; ++t) {
+        if (t == 25) {
+            for (Pool::instance_id i = 0; i < n; i += 6) {
+                single.post(i, Ev::stop);
+                multi.post(i, Ev::stop);
+            }
+        }
+        CHECK(single.step(t * ms) == multi.step(t * ms));
+    }
+    for (Pool::instance_id i = 0; i < n; ++i) {
+        CHECK(single.state(i) == multi.state(i));
+        CHECK(single.context(i).m_entry == multi.context(i).m_entry);
+        CHECK(single.context(i).m_do == multi.context(i).m_do);
+    }
+    multi.workers(1);               // restart with other count
+    CHECK(multi.step(100 * ms) == single.step(100 * ms));
+    multi.workers(0);
+    CHECK(multi.workers() == 0);
+    CHECK(multi.step(101 * ms) == single.step(101 * ms));
+}
+
+namespace {
+    /// records events and dispatching thread
+    struct Journal
+    {
+        std::vector<event_id> m_events {};
+        std::thread::id       m_thread {};
+        bool                  m_moved  {false}; //!< dispatched by more than one thread
+    };
+    class JournalFSM
+    {
+    public:
+        auto dispatch(event_id e) noexcept -> void
+        {
+            auto self = std::this_thread::get_id();
+            if (m_journal.m_thread != std::thread::id{} && m_journal.m_thread != self) m_journal.m_moved = true;
+            m_journal.m_thread = self;
+            m_journal.m_events.push_back(e);
+        }
+        Journal m_journal {};
+    };
+    using Runtime = FsmRuntime<JournalFSM>;
+} // namespace
+
+TEST_CASE("FsmInbox bounded MPSC order") {
+    FsmInbox q(3);                  // rounded up to 4
+    CHECK(q.capacity() == 4);
+    CHECK(q.empty());
+    for (std::uint32_t i = 0; i < 4; ++i) CHECK(q.push({i, static_cast<event_id>(i + 10)}));
+    CHECK_FALSE(q.push({9, 9}));
+    CHECK(q.depth() == 4);
+    FsmInbox::Item it;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        REQUIRE(q.pop(it));
+        CHECK(it.m_local == i);
+        CHECK(it.m_event == i + 10);
+    }
+    CHECK_FALSE(q.pop(it));
+    CHECK(q.push({1, 1}));          // wrapped
+    CHECK(q.depth() == 1);
+}
+
+TEST_CASE("FsmRuntime routes events to owning shard in order") {
+    constexpr size_type machines = 64;
+    constexpr int producers = 4;
+    constexpr int per_producer = 500;
+    Runtime rt(3, 1024);
+    CHECK(rt.shards() == 3);
+    for (size_type i = 0; i < machines; ++i) CHECK(rt.add(std::make_unique<JournalFSM>()) == i);
+    CHECK(rt.shard_of(4) == 1);
+    CHECK(rt.post(machines, 1) == OUT_OF_RANGE);
+    REQUIRE(rt.start() == OK);
+    CHECK(rt.start() == FAILURE);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&rt, p] {
+            for (int k = 0; k < per_producer; ++k) {
+                auto id = static_cast<Runtime::instance_id>(k % machines);
+                auto e = static_cast<event_id>(p * 100000 + k);
+                while (rt.post(id, e) != OK) std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    rt.drain();
+    auto total = rt.stats();
+    CHECK(total.m_dispatched == static_cast<count_type>(producers * per_producer));
+    CHECK(total.m_depth == 0);
+    CHECK(total.m_machines == machines);
+    rt.stop();
+    CHECK_FALSE(rt.running());
+    size_type events = 0;
+    for (Runtime::instance_id id = 0; id < machines; ++id) {
+        auto& j = rt.machine(id).m_journal;
+        CHECK_FALSE(j.m_moved);
+        events += j.m_events.size();
+        std::vector<event_id> last(producers, -1);
+        for (auto e : j.m_events) {         // per producer order is kept
+            auto p = static_cast<size_type>(e / 100000);
+            CHECK(e > last[p]);
+            last[p] = e;
+        }
+    }
+    CHECK(events == static_cast<size_type>(producers * per_producer));
+    // machines of other shards are dispatched by other threads
+    CHECK(rt.machine(0).m_journal.m_thread != rt.machine(1).m_journal.m_thread);
+    CHECK(rt.machine(0).m_journal.m_thread == rt.machine(3).m_journal.m_thread);
+}
+
+TEST_CASE("FsmRuntime rejects when inbox full and dispatches queued on start") {
+    Runtime rt(2, 4);
+    rt.add(std::make_unique<JournalFSM>());
+    rt.add(std::make_unique<JournalFSM>());
+    for (int k = 0; k < 4; ++k) CHECK(rt.post(0, k + 1) == OK);
+    CHECK(rt.post(0, 5) == NO_RESOURCE);
+    CHECK(rt.post(1, 1) == OK);     // other shard
+    CHECK(rt.stats(0).m_depth == 4);
+    CHECK(rt.stats(0).m_rejected == 1);
+    rt.start();
+    rt.drain();
+    CHECK(rt.stats(0).m_dispatched == 4);
+    CHECK(rt.stats(0).m_max_depth == 4);
+    CHECK(rt.stats(1).m_dispatched == 1);
+    rt.stop();
+    CHECK(rt.machine(0).m_journal.m_events == std::vector<event_id>{1, 2, 3, 4});
+    rt.start();                     // restart after stop
+    CHECK(rt.post(1, 7) == OK);
+    rt.drain();
+    rt.stop();
+    CHECK(rt.machine(1).m_journal.m_events.back() == 7);
+}
+
+TEST_CASE("FsmRuntime start fails when pinning fails") {
+    Runtime rt(2, 16);
+    rt.add(std::make_unique<JournalFSM>());
+    rt.add(std::make_unique<JournalFSM>());
+    CHECK(rt.start(ThreadAttributes::cpu_list{0, -1}) == FAIL_LUNCH); // worker of shard 1 is not started
+    CHECK_FALSE(rt.running());
+    REQUIRE(rt.start(true) == OK);  // pinned to allowed cpus
+    CHECK(rt.post(0, 3) == OK);
+    CHECK(rt.post(1, 4) == OK);
+    rt.drain();
+    rt.stop();
+    CHECK(rt.machine(0).m_journal.m_events == std::vector<event_id>{3});
+    CHECK(rt.machine(1).m_journal.m_events == std::vector<event_id>{4});
+}
+
+TEST_CASE("Fsm snapshot and restore without entry") {
+    Counter c;
+    TracedFSM fsm(&c);
+    fsm.dispatch(Ev::start);        // idle -> run
+    fsm.dispatch(FsmEvent::stay);
+    c.m_fired = 7;
+    ByteBuffer blob(16);
+    REQUIRE(fsm_snapshot(fsm, blob) == OK);
+    CHECK(blob.size() == 3);        // state id, m_do, m_fired (1 byte varints)
+
+    Counter c2;
+    TracedFSM restored(&c2);        // initial state idle
+    REQUIRE(fsm_restore(restored, blob.readable()) == OK);
+    CHECK(restored.current()->id() == 2);
+    CHECK(restored.current()->name() == "run");
+    CHECK(c2.m_entry == 0);         // entry() bypassed
+    CHECK(c2.m_do == 2);
+    CHECK(c2.m_fired == 7);
+    restored.dispatch(Ev::stop);    // continues from restored state
+    CHECK(restored.current()->name() == "idle");
+    CHECK(c2.m_exit == 1);
+
+    Counter c3;
+    TracedFSM other(&c3);
+    CHECK(fsm_restore(other, std::span<const char>()) == OUT_OF_RANGE);
+    const char unknown[] = {9, 0, 0};
+    CHECK(fsm_restore(other, std::span<const char>(unknown, 3)) == NO_DATA);
+    c3.m_do = 5;
+    const char truncated[] = {2, 4};
+    CHECK(fsm_restore(other, std::span<const char>(truncated, 2)) == OUT_OF_RANGE);
+    CHECK(other.current()->name() == "idle"); // unchanged by failed restore
+    CHECK(c3.m_do == 5);                      // context restored into copy
+    Fsm<Counter> empty;
+    CHECK(fsm_snapshot(empty, blob) == NO_DATA);
+}
+
+TEST_CASE("FsmSnapshotFile bulk save and restore") {
+    constexpr size_type n = 100;
+    auto path = (std::filesystem::temp_directory_path() / ("fsm_snapshot_test_" + std::to_string(::getpid()))).string();
+    std::vector<Counter> contexts(n);
+    std::vector<std::unique_ptr<TracedFSM>> machines;
+    for (auto& c : contexts) machines.push_back(std::make_unique<TracedFSM>(&c));
+    for (size_type i = 0; i < n; i += 2) machines[i]->dispatch(Ev::start);
+    for (size_type i = 0; i < n; ++i) contexts[i].m_fired = static_cast<int>(i);
+    REQUIRE(FsmSnapshotFile::save(path, machines, true) == OK);
+    CHECK_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    std::vector<Counter> contexts2(n);
+    std::vector<std::unique_ptr<TracedFSM>> machines2;
+    for (auto& c : contexts2) machines2.push_back(std::make_unique<TracedFSM>(&c));
+    FsmSnapshotFile f;
+    REQUIRE(f.open(path) == OK);
+    CHECK(f.open(path) == FAILURE); // already opened
+    CHECK(f.size() == n);
+    CHECK(f.record(0).size() == 3);
+    CHECK(f.record(n).empty());
+    REQUIRE(f.restore(machines2) == OK);
+    for (size_type i = 0; i < n; ++i) {
+        CHECK(machines2[i]->current()->id() == machines[i]->current()->id());
+        CHECK(contexts2[i].m_fired == static_cast<int>(i));
+        CHECK(contexts2[i].m_entry == 0);
+    }
+    machines2.pop_back();
+    CHECK(f.restore(machines2) == OUT_OF_RANGE);
+    f.close();
+    CHECK_FALSE(f.is_open());
+
+    {   // broken file
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        os << std::string(80, 'x');
+    }
+    CHECK(f.open(path) == FAILURE);
+    CHECK(f.open(path + ".none") == FAILURE);
+    std::remove(path.c_str());
+    // failed rename (target is a non empty directory) removes the temporary file
+    std::filesystem::create_directories(path + "/keep");
+    CHECK(FsmSnapshotFile::save(path, machines) == FAILURE);
+    CHECK_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove_all(path);
+}
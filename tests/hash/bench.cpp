@@ -0,0 +1,111 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for hash of bytes and SeenCache lookup
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "benchmark/benchmark.h"
+
+#include "seen_cache.hpp"
+
+using namespace Sml;
+
+static auto make_bytes(size_type n) -> std::string
+{
+    std::string s(n, '\0');
+    for (size_type i = 0; i < n; ++i) s[i] = static_cast<char>(i * 131);
+    return s;
+}
+
+static void BM_hash_bytes(benchmark::State& state) {
+    auto s = make_bytes(static_cast<size_type>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(hash_bytes(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_hash_bytes)->Arg(8)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_std_hash_string_view(benchmark::State& state) {
+    auto s = make_bytes(static_cast<size_type>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(std::hash<std::string_view>{}(s));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_std_hash_string_view)->Arg(8)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_equal_memcmp(benchmark::State& state) {
+    auto a = from_string(make_bytes(static_cast<size_type>(state.range(0))));
+    auto b = from_string(make_bytes(static_cast<size_type>(state.range(0))));
+    for (auto _ : state) benchmark::DoNotOptimize(a == b);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_equal_memcmp)->Arg(64)->Arg(1024);
+
+/// previous, through temporary std::string
+static void BM_equal_to_string(benchmark::State& state) {
+    auto a = from_string(make_bytes(static_cast<size_type>(state.range(0))));
+    auto b = make_bytes(static_cast<size_type>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(to_string(a) == b);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_equal_to_string)->Arg(64)->Arg(1024);
+
+/// frames of two redundant links (every frame arrives twice)
+static auto link_frames() -> std::vector<std::string>
+{
+    std::vector<std::string> frames;
+    for (int i = 0; i < 8192; ++i) {
+        auto f = make_bytes(64);
+        std::memcpy(f.data(), &i, sizeof(i));
+        frames.push_back(f);
+        frames.push_back(f);
+    }
+    return frames;
+}
+
+static void BM_seen_cache(benchmark::State& state) {
+    auto frames = link_frames();
+    SeenCache seen(4096, static_cast<size_type>(state.range(0)));
+    size_type i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(seen.check_and_insert(frames[i]));
+        if (++i == frames.size()) i = 0;
+    }
+    state.counters["hit_rate"] = seen.stats().hit_rate();
+}
+BENCHMARK(BM_seen_cache)->Arg(1)->Arg(8);
+
+/// std::list + std::unordered_map LRU keyed by copy of frame
+static void BM_naive_lru(benchmark::State& state) {
+    auto frames = link_frames();
+    std::list<std::string> lru;
+    std::unordered_map<std::string, std::list<std::string>::iterator> index;
+    size_type i = 0, hits = 0, lookups = 0;
+    for (auto _ : state) {
+        const auto& f = frames[i];
+        ++lookups;
+        if (auto it = index.find(f); it != index.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+            ++hits;
+        } else {
+            if (lru.size() == 4096) {
+                index.erase(lru.back());
+                lru.pop_back();
+            }
+            lru.push_front(f);
+            index.emplace(f, lru.begin());
+        }
+        if (++i == frames.size()) i = 0;
+    }
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(lookups);
+}
+BENCHMARK(BM_naive_lru);
+
+BENCHMARK_MAIN();
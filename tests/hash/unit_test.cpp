@@ -0,0 +1,140 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for hash of bytes, ByteBuffer equality and SeenCache
+ *
+ * @author s3mat3
+ */
+
+#include <cmath>
+#include <set>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "seen_cache.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+TEST_CASE("ByteBuffer equality without temporary") {
+    auto a = from_string("frame");
+    auto b = ByteBuffer(64);
+    b.append("frame", 5);
+    CHECK(a == b); // capacity differs
+    b.push_back('!');
+    CHECK_FALSE(a == b);
+    CHECK(a == "frame"s);
+    CHECK("frame"s == a);
+    CHECK(a == std::string_view("frame"));
+    CHECK_FALSE(a == "fram"s);
+    CHECK(ByteBuffer(4) == ByteBuffer(8));
+    BufferBase<int> x {1, 2, 3}, y {1, 2, 3};
+    CHECK(x == y);
+}
+
+TEST_CASE("BufferBase equality of floating point contents") {
+    BufferBase<double> a(4), b(4);
+    double x[] = {0.0, 1.5};
+    double y[] = {-0.0, 1.5};
+    a.assign(x, 2);
+    b.assign(y, 2);
+    CHECK(a == b); // -0.0 == 0.0, bytes differ
+    double nan[] = {std::nan("")};
+    a.assign(nan, 1);
+    CHECK_FALSE(a == a);
+}
+
+TEST_CASE("hash of bytes") {
+    // every length path (0, 1..3, 4..16, 17..48, over 48) and every byte affects the hash
+    std::string s(200, '\0');
+    for (size_type i = 0; i < s.size(); ++i) s[i] = static_cast<char>(i * 7);
+    std::set<std::uint64_t> seen;
+    for (size_type n = 0; n <= s.size(); ++n) seen.insert(hash_bytes(s.data(), n));
+    CHECK(seen.size() == s.size() + 1);
+    for (size_type i : {0u, 3u, 15u, 16u, 47u, 48u, 100u, 199u}) {
+        auto t = s;
+        t[i] ^= 1;
+        CHECK(hash_bytes(t) != hash_bytes(s));
+    }
+    CHECK(hash_bytes(s, 1) != hash_bytes(s, 2));
+    auto b = from_string(s);
+    CHECK(hash_bytes(b) == hash_bytes(s));
+    CHECK(std::hash<ByteBuffer>{}(b) == BufferHash{}(std::string_view(s)));
+    // well mixed, low bits are used by hash tables
+    std::set<std::uint64_t> low;
+    for (std::uint32_t i = 0; i < 4096; ++i) low.insert(hash_bytes(&i, sizeof(i)) & 0xfff);
+    CHECK(low.size() > 2400); // about 2590 expected
+}
+
+TEST_CASE("ByteBuffer as key of unordered set") {
+    std::unordered_set<ByteBuffer, BufferHash, BufferEqual> set;
+    set.insert(from_string("abc"));
+    set.insert(from_string("def"));
+    set.insert(from_string("abc"));
+    CHECK(set.size() == 2);
+    CHECK(set.find(std::string_view("def")) != set.end()); // transparent lookup
+    CHECK(set.find(std::string_view("xyz")) == set.end());
+}
+
+TEST_CASE("SeenCache suppresses duplicates in LRU order") {
+    SeenCache seen(4, 1);
+    CHECK(seen.capacity() == 4);
+    CHECK(seen.check_and_insert("a"s) == false);
+    CHECK(seen.check_and_insert("b"s) == false);
+    CHECK(seen.check_and_insert("a"s) == true);
+    CHECK(seen.check_and_insert("c"s) == false);
+    CHECK(seen.check_and_insert("d"s) == false);
+    CHECK(seen.size() == 4);
+    CHECK(seen.check_and_insert("e"s) == false); // evicts b (least recently seen)
+    CHECK(seen.contains("b"s) == false);
+    CHECK(seen.contains("a"s) == true);
+    CHECK(seen.check_and_insert(from_string("c")) == true);
+    auto s = seen.stats();
+    CHECK(s.m_lookups == 9);
+    CHECK(s.m_hits == 3);
+    CHECK(s.m_inserts == 5);
+    CHECK(s.m_evictions == 1);
+    CHECK(std::abs(s.hit_rate() - 3.0 / 9.0) < 1e-12);
+    seen.clear();
+    CHECK(seen.size() == 0);
+    CHECK(seen.check_and_insert("a"s) == false);
+    seen.reset_stats();
+    CHECK(seen.stats().m_lookups == 0);
+}
+
+TEST_CASE("SeenCache index stays consistent under eviction churn") {
+    SeenCache seen(64, 4);
+    CHECK(seen.shards() == 4);
+    // keys colliding in low bits stress linear probing and backward shift deletion
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t i = 0; i < 2000; ++i) keys.push_back((i << 48) | ((i % 3) << 2));
+    for (auto k : keys) CHECK_FALSE(seen.check_and_insert(k));
+    CHECK(seen.size() <= 64);
+    // most recent 16 of each shard are still there
+    size_type found = 0;
+    for (size_type i = keys.size() - 16; i < keys.size(); ++i) found += seen.contains(keys[i]);
+    CHECK(found == 16);
+    CHECK(seen.stats().m_evictions == 2000 - seen.size());
+}
+
+TEST_CASE("SeenCache from two links") {
+    SeenCache seen(1024);
+    std::atomic<int> delivered {0};
+    auto link = [&seen, &delivered] {
+        for (int i = 0; i < 500; ++i) {
+            auto frame = "frame-" + std::to_string(i);
+            if (! seen.check_and_insert(frame)) ++delivered;
+        }
+    };
+    std::thread a(link), b(link);
+    a.join();
+    b.join();
+    CHECK(delivered == 500);
+    CHECK(seen.stats().m_hits == 500);
+}
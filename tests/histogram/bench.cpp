@@ -0,0 +1,72 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for histogram record / percentile / merge
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include "benchmark/benchmark.h"
+
+#include "histogram.hpp"
+
+using namespace Sml;
+
+/// pseudo latency values (spread over many buckets)
+static auto next(std::uint64_t v) noexcept -> std::uint64_t {return (v * 6364136223846793005ULL + 1442695040888963407ULL);}
+
+static void BM_record(benchmark::State& state) {
+    Histogram<> h;
+    std::uint64_t v = 1;
+    for (auto _ : state) {
+        h.record(v >> 44);
+        v = next(v);
+    }
+    benchmark::DoNotOptimize(h.count());
+}
+BENCHMARK(BM_record);
+
+static void BM_atomic_record(benchmark::State& state) {
+    static AtomicHistogram<> h;
+    std::uint64_t v = static_cast<std::uint64_t>(state.thread_index()) + 1;
+    for (auto _ : state) {
+        h.record(v >> 44);
+        v = next(v);
+    }
+}
+BENCHMARK(BM_atomic_record)->Threads(1)->Threads(4);
+
+static void BM_scoped_recorder(benchmark::State& state) {
+    Histogram<> h;
+    for (auto _ : state) {
+        ScopedRecorder r(h);
+    }
+    benchmark::DoNotOptimize(h.count());
+}
+BENCHMARK(BM_scoped_recorder);
+
+static void BM_percentile(benchmark::State& state) {
+    Histogram<> h;
+    std::uint64_t v = 1;
+    for (int i = 0; i < 100000; ++i) {h.record(v >> 44); v = next(v);}
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(h.p99());
+    }
+}
+BENCHMARK(BM_percentile);
+
+static void BM_merge(benchmark::State& state) {
+    Histogram<> a, b;
+    b.record(12345);
+    for (auto _ : state) {
+        a.merge(b);
+    }
+    benchmark::DoNotOptimize(a.count());
+}
+BENCHMARK(BM_merge);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for log linear histogram
+ *
+ * @author s3mat3
+ */
+
+#include <thread>
+#include <vector>
+#include "histogram.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using scale = LogLinearScale<>;
+
+TEST_CASE("Scale index and bucket bounds") {
+    CHECK(scale::index(0) == 0);
+    CHECK(scale::index(15) == 15);
+    CHECK(scale::index(16) == 16);
+    CHECK(scale::index(31) == 31);
+    CHECK(scale::index(32) == 32);
+    CHECK(scale::index(33) == 32);
+    CHECK(scale::index(scale::max_value) == scale::bucket_count - 1);
+    CHECK(scale::index(scale::max_value + 100) == scale::bucket_count - 1);
+    for (std::uint64_t v : {1ULL, 17ULL, 100ULL, 1000ULL, 123456ULL, 987654321ULL}) {
+        auto i = scale::index(v);
+        CHECK(scale::lower(i) <= v);
+        CHECK(v <= scale::upper(i));
+        CHECK(scale::upper(i) - scale::lower(i) <= v / scale::sub_count); // relative error
+    }
+    for (size_type i = 1; i < scale::bucket_count; ++i) {
+        REQUIRE(scale::lower(i) == scale::upper(i - 1) + 1); // contiguous
+    }
+}
+
+TEST_CASE("Percentiles") {
+    Histogram<> h;
+    CHECK(h.p50() == 0);
+    for (std::uint64_t v = 1; v <= 1000; ++v) h.record(v);
+    CHECK(h.count() == 1000);
+    CHECK(h.max() == 1000);
+    CHECK(h.p50() >= 500);
+    CHECK(h.p50() <= 500 + 500 / 16);
+    CHECK(h.p99() >= 990);
+    CHECK(h.p99() <= 1000);
+    CHECK(h.p999() <= 1000);
+    CHECK(h.percentile(1.0) == 1000);
+}
+
+TEST_CASE("Percentile is nearest rank") {
+    Histogram<> h;
+    for (std::uint64_t v = 1; v <= 10; ++v) h.record(v); // exact buckets
+    CHECK(h.percentile(0.0) == 1);
+    CHECK(h.percentile(0.05) == 1);
+    CHECK(h.percentile(0.15) == 2);  // rank ceil(1.5)
+    CHECK(h.percentile(0.5) == 5);
+    CHECK(h.percentile(0.95) == 10); // rank ceil(9.5)
+}
+
+TEST_CASE("Merge per thread histograms") {
+    std::vector<Histogram<>> local(4);
+    std::vector<std::thread> th;
+    for (size_type t = 0; t < local.size(); ++t) {
+        th.emplace_back([&h = local[t], t] {for (std::uint64_t v = 0; v < 1000; ++v) h.record(v + t * 1000);});
+    }
+    for (auto& t : th) t.join();
+    Histogram<> all;
+    for (const auto& h : local) all += h;
+    CHECK(all.count() == 4000);
+    CHECK(all.max() == 3999);
+    CHECK(all.p50() >= 2000);
+    CHECK(all.p50() <= 2000 + 2000 / 16);
+}
+
+TEST_CASE("AtomicHistogram from many threads") {
+    AtomicHistogram<> h;
+    std::vector<std::thread> th;
+    for (int t = 0; t < 4; ++t) {
+        th.emplace_back([&h] {for (std::uint64_t v = 0; v < 10000; ++v) h.record(v);});
+    }
+    for (auto& t : th) t.join();
+    auto s = h.snapshot();
+    CHECK(s.count() == 40000);
+    CHECK(s.max() == 9999);
+}
+
+TEST_CASE("Serialize and deserialize") {
+    Histogram<> h;
+    for (std::uint64_t v = 0; v < 100000; v += 7) h.record(v);
+    h.record(1ULL << 38);
+    auto data = h.serialize();
+    CHECK(data.size() < 1024);
+    Histogram<> r;
+    CHECK(r.deserialize(data) == OK);
+    CHECK(r.count() == h.count());
+    CHECK(r.max() == h.max());
+    CHECK(r.counts() == h.counts());
+    CHECK(r.deserialize(data.substr(0, data.size() - 1)) == FAILURE);
+    CHECK(r.count() == h.count()); // not changed
+    Histogram<LogLinearScale<3, 32>> other;
+    CHECK(other.deserialize(data) == FAILURE);
+    Histogram<> empty;
+    CHECK(r.deserialize(empty.serialize()) == OK);
+    CHECK(r.count() == 0);
+}
+
+TEST_CASE("ScopedRecorder with MeasureTime") {
+    Histogram<> h;
+    {
+        ScopedRecorder r(h);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(h.count() == 1);
+    CHECK(h.max() >= 2000000);
+    AtomicHistogram<> a;
+    {
+        ScopedRecorder r(a);
+    }
+    CHECK(a.snapshot().count() == 1);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for round trip latency over pty, coroutine (epoll) VS thread (isReady polling)
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <atomic>
+#include <thread>
+#include "benchmark/benchmark.h"
+
+#include "io/async.hpp"
+#include "../pty.hpp"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+static IoTask read_frame(ChannelBase& ch, std::string& buf, size_type length)
+{
+    size_type got = 0;
+    std::string tmp(length, 0);
+    while (got < length) {
+        auto ret = co_await ch.async_read(tmp, 1000);
+        if (ret < 0) co_return ret;
+        buf.replace(got, static_cast<size_type>(ret), tmp.data(), static_cast<size_type>(ret));
+        got += static_cast<size_type>(ret);
+    }
+    co_return static_cast<return_code>(got);
+}
+
+static IoTask ping(ChannelBase& ch, const std::string& frame, std::string& buf)
+{
+    auto ret = co_await ch.async_write(frame, 1000);
+    if (ret < 0) co_return ret;
+    co_return co_await read_frame(ch, buf, frame.size());
+}
+
+static IoTask pong(ChannelBase& ch, std::string& buf)
+{
+    auto ret = co_await read_frame(ch, buf, buf.size());
+    if (ret < 0) co_return ret;
+    co_return co_await ch.async_write(buf, 1000);
+}
+
+static void BM_async_round_trip(benchmark::State& state) {
+    Test::PtyMaster master;
+    Serial::Port port(master.slave_name());
+    if (port.connect() != OK) {state.SkipWithError("pty open failed"); return;}
+    IoScheduler sched;
+    master.scheduler(&sched);
+    port.scheduler(&sched);
+    const std::string frame(static_cast<size_type>(state.range(0)), 'F');
+    std::string echo(frame.size(), 0);
+    std::string back(frame.size(), 0);
+    for (auto _ : state) {
+        auto b = pong(port, echo);
+        auto a = ping(master, frame, back);
+        sched.run();
+        if (a.result() < 0 || b.result() < 0) {state.SkipWithError("io error"); break;}
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_async_round_trip)->Arg(16)->Arg(256)->UseRealTime();
+
+/// read exactly length bytes by isReady polling (today's thread style)
+static auto poll_read(ChannelBase& ch, std::string& buf, size_type length, const std::atomic<bool>& run) -> bool
+{
+    size_type got = 0;
+    std::string tmp(length, 0);
+    while (got < length && run.load(std::memory_order_relaxed)) {
+        if (ch.isReady(direction::in) != IO_OK) continue;
+        auto ret = ch.read(tmp);
+        if (ret > 0) {
+            buf.replace(got, static_cast<size_type>(ret), tmp.data(), static_cast<size_type>(ret));
+            got += static_cast<size_type>(ret);
+        }
+    }
+    return got == length;
+}
+
+static void BM_thread_round_trip(benchmark::State& state) {
+    Test::PtyMaster master;
+    Serial::Port port(master.slave_name());
+    if (port.connect() != OK) {state.SkipWithError("pty open failed"); return;}
+    const std::string frame(static_cast<size_type>(state.range(0)), 'F');
+    std::atomic<bool> run {true};
+    std::thread echo_thread([&] {
+        std::string echo(frame.size(), 0);
+        while (run.load(std::memory_order_relaxed)) {
+            if (poll_read(port, echo, frame.size(), run)) port.write(echo);
+        }
+    });
+    std::string back(frame.size(), 0);
+    for (auto _ : state) {
+        master.write(frame);
+        poll_read(master, back, frame.size(), run);
+    }
+    run = false;
+    echo_thread.join();
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_thread_round_trip)->Arg(16)->Arg(256)->UseRealTime();
+
+BENCHMARK_MAIN();
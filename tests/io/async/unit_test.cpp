@@ -0,0 +1,159 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for coroutine IO (IoScheduler, async_read, async_write)
+ *
+ * @author s3mat3
+ */
+
+#include <optional>
+
+#include "io/async.hpp"
+#include "../pty.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+static IoTask writer(ChannelBase& ch, const std::string& data)
+{
+    co_return co_await ch.async_write(data, 1000);
+}
+
+static IoTask reader(ChannelBase& ch, std::string& received, size_type length)
+{
+    std::string buf(256, 0);
+    while (received.size() < length) {
+        auto ret = co_await ch.async_read(buf, 1000);
+        if (ret < 0) co_return ret;
+        received.append(buf.data(), static_cast<size_type>(ret));
+    }
+    co_return static_cast<return_code>(received.size());
+}
+
+static IoTask request(ChannelBase& ch, std::string& received)
+{
+    static const std::string enq = "\x05"s;
+    auto ret = co_await writer(ch, enq);
+    if (ret < 0) co_return ret;
+    co_return co_await reader(ch, received, 3);
+}
+
+static IoTask dropper(ChannelBase& ch, std::optional<IoTask>& other)
+{
+    std::string buf(16, 0);
+    auto ret = co_await ch.async_read(buf, 0);
+    other.reset(); // destroy other task (suspended, or completed in same run_once)
+    co_return ret;
+}
+
+TEST_CASE("async write and read over pty") {
+    Test::PtyMaster master;
+    REQUIRE(is_fd(master.fd()));
+    Serial::Port port(master.slave_name());
+    REQUIRE(port.connect() == OK);
+    IoScheduler sched;
+    REQUIRE((sched));
+    master.scheduler(&sched);
+    port.scheduler(&sched);
+
+    const std::string data = "\x02" "DEADBEEF" "\x03";
+    std::string received;
+    auto rd = reader(port, received, data.size());
+    auto wr = writer(master, data);
+    sched.run();
+    REQUIRE(rd.done());
+    REQUIRE(wr.done());
+    CHECK(wr.result() == static_cast<return_code>(data.size()));
+    CHECK(rd.result() == static_cast<return_code>(data.size()));
+    CHECK(received == data);
+    CHECK(sched.pending() == 0);
+}
+
+TEST_CASE("async read timeout") {
+    Test::PtyMaster master;
+    Serial::Port port(master.slave_name());
+    REQUIRE(port.connect() == OK);
+    IoScheduler sched;
+    port.scheduler(&sched);
+    std::string received;
+    auto rd = reader(port, received, 1);
+    CHECK(rd.done() == false);
+    sched.run();
+    REQUIRE(rd.done());
+    CHECK(rd.result() == IO_TIMEOUT);
+    CHECK(port.status().is_set(StatusFlag::timeouted));
+}
+
+TEST_CASE("async nested task") {
+    Test::PtyMaster master;
+    Serial::Port port(master.slave_name());
+    REQUIRE(port.connect() == OK);
+    IoScheduler sched;
+    master.scheduler(&sched);
+    port.scheduler(&sched);
+    std::string received;
+    auto req = request(master, received);
+    std::string enq;
+    auto rd = reader(port, enq, 1);
+    sched.run_once(100);
+    REQUIRE(rd.done());
+    CHECK(enq == "\x05");
+    auto ack = writer(port, "ACK"s);
+    sched.run();
+    REQUIRE(req.done());
+    CHECK(req.result() == 3);
+    CHECK(received == "ACK");
+}
+
+TEST_CASE("async without scheduler") {
+    Test::PtyMaster master;
+    std::string received;
+    auto rd = reader(master, received, 1);
+    REQUIRE(rd.done());
+    CHECK(rd.result() == IO_NOT_OPEN);
+}
+
+TEST_CASE("async destroy suspended task") {
+    Test::PtyMaster master;
+    Serial::Port port(master.slave_name());
+    REQUIRE(port.connect() == OK);
+    IoScheduler sched;
+    port.scheduler(&sched);
+    std::string received;
+    {
+        auto rd = reader(port, received, 1);
+        REQUIRE(rd.done() == false);
+        CHECK(sched.pending() == 1);
+    }
+    CHECK(sched.pending() == 0);
+    CHECK(master.write("X"s) == 1);
+    CHECK(sched.run_once(10) == 0);
+    CHECK(received.empty());
+}
+
+TEST_CASE("async task destroyed by task resumed in same pass") {
+    Test::PtyMaster master0, master1;
+    Serial::Port port0(master0.slave_name()), port1(master1.slave_name());
+    REQUIRE(port0.connect() == OK);
+    REQUIRE(port1.connect() == OK);
+    IoScheduler sched;
+    port0.scheduler(&sched);
+    port1.scheduler(&sched);
+    std::optional<IoTask> task[2];
+    task[0].emplace(dropper(port0, task[1]));
+    task[1].emplace(dropper(port1, task[0]));
+    REQUIRE(sched.pending() == 2);
+    CHECK(sched.run_once(100) == 1); // both timed out, the first resumed drops the other
+    CHECK(sched.pending() == 0);
+    CHECK(task[0].has_value() != task[1].has_value());
+    auto& survivor = (task[0]) ? *task[0] : *task[1];
+    REQUIRE(survivor.done());
+    CHECK(survivor.result() == IO_TIMEOUT);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for capture append, mmap writer VS std::ofstream (write and flush) and reader scan
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <fstream>
+#include "benchmark/benchmark.h"
+
+#include "io/capture.hpp"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+static auto bench_path() -> std::string {return "/tmp/sml-capture-bench-" + std::to_string(::getpid()) + ".cap";}
+
+static void BM_capture_writer_append(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    std::string frame(n, 'x');
+    auto path = bench_path();
+    CaptureWriter w;
+    w.open(path);
+    count_type appended = 0;
+    for (auto _ : state) {
+        w.append(0, direction::in, frame);
+        if (++appended % 100000 == 0) { // keep file size bounded
+            state.PauseTiming();
+            w.close();
+            w.open(path);
+            state.ResumeTiming();
+        }
+    }
+    w.close();
+    ::unlink(path.c_str());
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_capture_writer_append)->Arg(16)->Arg(256)->Arg(4096);
+
+/// today's way, copy into stream buffer and flush every record
+static void BM_ofstream_append_flush(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    std::string frame(n, 'x');
+    auto path = bench_path();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    count_type appended = 0;
+    for (auto _ : state) {
+        CaptureRecord rec {capture_clock(), static_cast<std::uint32_t>(n), 0, 0, CaptureRecord::marker};
+        out.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        out.write(frame.data(), static_cast<std::streamsize>(n));
+        out.flush();
+        if (++appended % 100000 == 0) {
+            state.PauseTiming();
+            out.close();
+            out.open(path, std::ios::binary | std::ios::trunc);
+            state.ResumeTiming();
+        }
+    }
+    out.close();
+    ::unlink(path.c_str());
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ofstream_append_flush)->Arg(16)->Arg(256)->Arg(4096);
+
+/// zero copy scan of 100000 records
+static void BM_capture_reader_scan(benchmark::State& state) {
+    auto path = bench_path();
+    {
+        CaptureWriter w;
+        w.open(path);
+        std::string frame(64, 'x');
+        for (int i = 0; i < 100000; ++i) w.append(0, direction::in, frame);
+    }
+    CaptureReader r;
+    r.open(path);
+    for (auto _ : state) {
+        r.rewind();
+        CaptureView v;
+        size_type bytes = 0;
+        while (r.next(v) == IO_OK) bytes += v.m_data.size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    r.close();
+    ::unlink(path.c_str());
+    state.SetItemsProcessed(state.iterations() * 100000);
+}
+BENCHMARK(BM_capture_reader_scan);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,175 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for capture file and replay channel
+ *
+ * @author s3mat3
+ */
+
+#include <thread>
+#include <sys/wait.h>
+#include "io/replay.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+static auto capture_path(const char* name) -> std::string
+{
+    return "/tmp/sml-capture-" + std::to_string(::getpid()) + "-" + name + ".cap";
+}
+static auto file_size(const std::string& path) -> size_type
+{
+    struct stat st {};
+    ::stat(path.c_str(), &st);
+    return static_cast<size_type>(st.st_size);
+}
+
+TEST_CASE("Write with segment growth and read views") {
+    auto path = capture_path("growth");
+    CaptureWriter w;
+    REQUIRE(w.open(path, 4096) == IO_OK);
+    CHECK(w.mapped() == 4096);
+    std::string frame(300, '\0');
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        frame.assign(1 + i * 3, static_cast<char>('a' + i % 26));
+        auto d = (i % 2) ? direction::out : direction::in;
+        REQUIRE(w.append(static_cast<channel_id>(i % 3), d, frame, 1000 + i) == IO_OK);
+    }
+    CHECK(w.records() == 100);
+    CHECK(w.mapped() > 4096); // grown by fallocate
+    CHECK(w.mapped() % 4096 == 0);
+    auto used = w.used();
+    w.close();
+    CHECK(file_size(path) == sizeof(CaptureFileHeader) + used); // preallocation truncated
+
+    CaptureReader r;
+    REQUIRE(r.open(path) == IO_OK);
+    CHECK(r.records() == 100);
+    CaptureView v;
+    std::uint32_t n = 0;
+    while (r.next(v) == IO_OK) {
+        CHECK(v.m_timestamp == 1000 + n);
+        CHECK(v.m_channel == n % 3);
+        CHECK(v.m_direction == ((n % 2) ? direction::out : direction::in));
+        CHECK(v.m_data == std::string(1 + n * 3, static_cast<char>('a' + n % 26)));
+        ++n;
+    }
+    CHECK(n == 100);
+    CHECK(r.next(v) == NO_DATA);
+    r.rewind();
+    REQUIRE(r.next(v) == IO_OK);
+    CHECK(v.m_data == "a");
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("Payload over 32 bits length is rejected") {
+    auto path = capture_path("large");
+    CaptureWriter w;
+    REQUIRE(w.open(path, 4096) == IO_OK);
+    REQUIRE(w.append(0, direction::in, std::string_view("ok")) == IO_OK);
+    auto used = w.used();
+    const char byte = 'x'; // not read, rejected by length
+    CHECK(w.append(0, direction::in, &byte, (size_type {1} << 32) + 1) == IO_FAILURE);
+    CHECK(w.records() == 1);
+    CHECK(w.used() == used);
+    CHECK(w.mapped() == 4096);
+    w.close();
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("Readable after crash of writer") {
+    auto path = capture_path("crash");
+    auto pid = ::fork();
+    if (pid == 0) {
+        CaptureWriter w;
+        if (w.open(path, 4096) != IO_OK) ::_exit(1);
+        for (int i = 0; i < 10; ++i) w.append(1, direction::in, std::string_view("frame"));
+        ::_exit(0); // no close
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WEXITSTATUS(status) == 0);
+    CHECK(file_size(path) == 4096); // still preallocated
+    CaptureReader r;
+    REQUIRE(r.open(path) == IO_OK);
+    CaptureView v;
+    count_type n = 0;
+    while (r.next(v) == IO_OK) ++n;
+    CHECK(n == 10);
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("Not a capture file") {
+    CaptureReader r;
+    CHECK(r.open("/nonexistent/file.cap") == IO_FAILURE);
+    CHECK(r.open("/proc/self/exe") == IO_FAILURE);
+    CaptureView v;
+    CHECK(r.next(v) == IO_NOT_OPEN);
+    CaptureWriter w;
+    CHECK(w.append(0, direction::in, std::string_view("x")) == IO_NOT_OPEN);
+}
+
+TEST_CASE("Replay through fake channel at accelerated speed") {
+    auto path = capture_path("replay");
+    {
+        CaptureWriter w;
+        REQUIRE(w.open(path) == IO_OK);
+        std::uint64_t t = 1000000000;
+        for (int i = 0; i < 5; ++i, t += 100000000) { // every 100[ms]
+            w.append(0, direction::in, "rx" + std::to_string(i), t);
+            w.append(0, direction::out, std::string_view("tx"), t + 1000);
+            w.append(1, direction::in, std::string_view("other"), t + 2000);
+        }
+    }
+    CaptureReader cap;
+    REQUIRE(cap.open(path) == IO_OK);
+    ReplayChannel ch;
+    REQUIRE(ch.status().is_set(StatusFlag::opened));
+    auto start = std::chrono::steady_clock::now();
+    std::jthread feeder([&](std::stop_token st) {ch.replay(cap, 10.0, st, 0);}); // 400[ms] capture in 40[ms]
+    std::string received;
+    ChannelBase::byte_buffer buff(64, '\0');
+    while (received.size() < 15 && ch.isReady(direction::in, feeder.get_stop_token(), 1000) == IO_OK) {
+        auto n = ch.read(buff);
+        if (n > 0) received.append(buff.data(), static_cast<size_type>(n));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    feeder.join();
+    CHECK(received == "rx0rx1rx2rx3rx4");
+    CHECK(ch.fed() == 5);
+    CHECK(elapsed >= std::chrono::milliseconds(40));
+    CHECK(elapsed < std::chrono::milliseconds(400));
+    CHECK(ch.write("ack") == 3);
+    CHECK(ch.written() == "ack");
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("Replay without wait and stop") {
+    auto path = capture_path("nowait");
+    {
+        CaptureWriter w;
+        REQUIRE(w.open(path) == IO_OK);
+        for (std::uint64_t i = 0; i < 3; ++i) w.append(0, direction::in, std::string_view("abc"), i * 1000000000ULL);
+    }
+    CaptureReader cap;
+    REQUIRE(cap.open(path) == IO_OK);
+    ReplayChannel ch;
+    CHECK(ch.replay(cap, 0) == 3); // 2[s] capture without wait
+    cap.rewind();
+    std::stop_source stop;
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop.request_stop();
+    });
+    CHECK(ch.replay(cap, 1.0, stop.get_token()) == 1); // first only, stopped while waiting 1[s]
+    stopper.join();
+    CHECK(ch.fed() == 4);
+    ::unlink(path.c_str());
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for ChannelStats recording overhead
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <fcntl.h>
+#include "benchmark/benchmark.h"
+
+#include "io/channel.hpp"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+/// counters and histogram only (time stamp taken outside of loop)
+static void BM_stats_on_write(benchmark::State& state) {
+    ChannelStats stats;
+    auto start = ChannelStats::now();
+    for (auto _ : state) {
+        stats.on_write(64, 64, start);
+    }
+    benchmark::DoNotOptimize(stats.snapshot().m_writes);
+}
+BENCHMARK(BM_stats_on_write);
+
+static void BM_stats_on_read(benchmark::State& state) {
+    ChannelStats stats;
+    for (auto _ : state) {
+        stats.on_read(64);
+    }
+    benchmark::DoNotOptimize(stats.snapshot().m_reads);
+}
+BENCHMARK(BM_stats_on_read);
+
+static void BM_histogram_record(benchmark::State& state) {
+    latency_histogram h;
+    std::uint64_t v = 1;
+    for (auto _ : state) {
+        h.record(v);
+        v = (v * 7 + 13) & 0xfffff;
+    }
+    benchmark::DoNotOptimize(h.snapshot().count());
+}
+BENCHMARK(BM_histogram_record);
+
+static void BM_histogram_record_exclusive(benchmark::State& state) {
+    latency_histogram h;
+    std::uint64_t v = 1;
+    for (auto _ : state) {
+        h.record_exclusive(v);
+        v = (v * 7 + 13) & 0xfffff;
+    }
+    benchmark::DoNotOptimize(h.snapshot().count());
+}
+BENCHMARK(BM_histogram_record_exclusive);
+
+/// reference: cost of one time stamp
+static void BM_clock_now(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ChannelStats::now());
+    }
+}
+BENCHMARK(BM_clock_now);
+
+/// write to /dev/null through write_some (system call + statistics)
+class NullChannel : public ChannelBase
+{
+public:
+    NullChannel() {m_fd = ::open("/dev/null", O_WRONLY);}
+    ~NullChannel() {if (is_fd(m_fd)) ::close(m_fd);}
+    auto read(byte_buffer&) noexcept -> return_code override {return IO_FAILURE;}
+    auto write(const byte_buffer& forSend) noexcept -> return_code override {return write_some(forSend.data(), forSend.size());}
+};
+
+static void BM_write_with_stats(benchmark::State& state) {
+    NullChannel ch;
+    const std::string data(64, 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ch.write(data));
+    }
+}
+BENCHMARK(BM_write_with_stats);
+
+static void BM_write_raw(benchmark::State& state) {
+    auto fd = ::open("/dev/null", O_WRONLY);
+    const std::string data(64, 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(::write(fd, data.data(), data.size()));
+    }
+    ::close(fd);
+}
+BENCHMARK(BM_write_raw);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,251 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for ChannelBase (output queue)
+ *
+ * @author s3mat3
+ */
+
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <thread>
+#include "io/channel.hpp"
+#include "io/writev.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using namespace Sml::IO;
+/*! Channel over pipe(2) .
+ *
+ * m_fd is write side, reader() is read side
+ */
+class PipeChannel : public ChannelBase
+{
+public:
+    PipeChannel()
+    {
+        int fds[2] = {-1, -1};
+        if (::pipe2(fds, O_NONBLOCK) == 0) {
+            m_reader = fds[0];
+            m_fd     = fds[1];
+        }
+    }
+    ~PipeChannel()
+    {
+        if (is_fd(m_reader)) ::close(m_reader);
+        if (is_fd(m_fd)) ::close(m_fd);
+    }
+    auto read(byte_buffer& readed) noexcept -> return_code override
+    {
+        readed.resize(65536);
+        auto ret = ::read(m_reader, readed.data(), readed.size());
+        readed.resize((ret > 0) ? ret : 0);
+        return static_cast<return_code>(ret);
+    }
+    auto write(const byte_buffer& forSend) noexcept -> return_code override
+    {
+        return static_cast<return_code>(::write(m_fd, forSend.data(), forSend.size()));
+    }
+    auto reader() const noexcept {return m_reader;}
+private:
+    fd_type m_reader {void_fd()};
+};
+
+TEST_CASE("OutputQueue coalesce by size threshold") {
+    PipeChannel ch;
+    ch.output().policy(CoalescePolicy{.m_threshold = 16, .m_deadline = 1000});
+    std::string buf;
+    for (int i = 0; i < 15; ++i) {
+        CHECK(ch.post("x"s) == IO_OK);
+    }
+    CHECK(ch.output().pending() == 15);
+    CHECK(ch.read(buf) < 0); // nothing written yet
+    CHECK(ch.post("y"s) == IO_OK); // hit threshold
+    CHECK(ch.output().pending() == 0);
+    CHECK(ch.read(buf) == 16);
+    CHECK(buf == "xxxxxxxxxxxxxxxy");
+    const auto& c = ch.output().counters();
+    CHECK(c.m_posted == 16);
+    CHECK(c.m_syscalls == 1);
+    CHECK(c.m_flushes == 1);
+    CHECK(c.saved() == 15);
+}
+
+TEST_CASE("OutputQueue explicit flush and deadline") {
+    PipeChannel ch;
+    ch.output().policy(CoalescePolicy{.m_threshold = 1024, .m_deadline = 1});
+    std::string buf;
+    CHECK(ch.post("abc"s) == IO_OK);
+    CHECK(ch.flush_if_due() == IO_OK);
+    ::usleep(3000);
+    CHECK(ch.output().due() == true);
+    CHECK(ch.flush_if_due() == IO_OK);
+    CHECK(ch.output().pending() == 0);
+    CHECK(ch.post("def"s) == IO_OK);
+    CHECK(ch.flush() == IO_OK);
+    CHECK(ch.read(buf) == 6);
+    CHECK(buf == "abcdef");
+}
+
+TEST_CASE("OutputQueue keeps remaining data on EAGAIN") {
+    PipeChannel ch;
+    auto size = ::fcntl(ch.reader(), F_GETPIPE_SZ);
+    REQUIRE(size > 0);
+    ch.output().policy(CoalescePolicy{.m_threshold = static_cast<size_type>(size) * 2, .m_deadline = 1000});
+    std::string big(static_cast<size_type>(size) + 100, 'z');
+    CHECK(ch.post(big) == IO_OK);
+    CHECK(ch.flush() == IO_TIMEOUT);
+    CHECK(ch.output().pending() == 100);
+    CHECK(ch.output().counters().m_partial == 1);
+    CHECK(ch.output().counters().m_again == 1);
+    CHECK(ch.status().is_set(StatusFlag::timeouted));
+    std::string buf;
+    size_type total = 0;
+    while (total < static_cast<size_type>(size)) {
+        auto n = ch.read(buf);
+        REQUIRE(n > 0);
+        total += static_cast<size_type>(n);
+    }
+    CHECK(ch.flush() == IO_OK);
+    CHECK(ch.output().pending() == 0);
+    CHECK(ch.read(buf) == 100);
+}
+
+TEST_CASE("OutputQueue without fd") {
+    OutputQueue q;
+    q.push("abc", 3);
+    auto ret = q.flush([](const char*, size_type) -> ssize_t {errno = EBADF; return -1;});
+    CHECK(ret == IO_FAILURE);
+    CHECK(q.pending() == 3);
+}
+
+TEST_CASE("ChannelStats counts write system calls") {
+    PipeChannel ch;
+    ch.output().policy(CoalescePolicy{.m_threshold = 0, .m_deadline = 0});
+    CHECK(ch.post("abc"s) == IO_OK);
+    CHECK(ch.post("defgh"s) == IO_OK);
+    auto s = ch.stats().snapshot();
+    CHECK(s.m_writes == 2);
+    CHECK(s.m_bytes_out == 8);
+    CHECK(s.m_partial == 0);
+    CHECK(s.m_write_time.count() == 2);
+    CHECK(s.m_write_time.percentile(0.5) > 0);
+    CHECK(s.m_write_time.percentile(1.0) == s.m_write_time.max());
+    ch.stats().reset();
+    CHECK(ch.stats().snapshot().m_writes == 0);
+    CHECK(ch.stats().snapshot().m_write_time.count() == 0);
+}
+
+TEST_CASE("ChannelStats counts partial write and EAGAIN") {
+    PipeChannel ch;
+    auto size = ::fcntl(ch.reader(), F_GETPIPE_SZ);
+    REQUIRE(size > 0);
+    ch.output().policy(CoalescePolicy{.m_threshold = static_cast<size_type>(size) * 2, .m_deadline = 1000});
+    CHECK(ch.post(std::string(static_cast<size_type>(size) + 100, 'z')) == IO_OK);
+    CHECK(ch.flush() == IO_TIMEOUT);
+    auto s = ch.stats().snapshot();
+    CHECK(s.m_writes == 2);
+    CHECK(s.m_partial == 1);
+    CHECK(s.m_again == 1);
+    CHECK(s.m_bytes_out == static_cast<count_type>(size));
+}
+
+TEST_CASE("Gather write of ChainBuffer") {
+    PipeChannel ch;
+    ChainBuffer frame(from_string("payload"));
+    frame.prepend("[hdr]"s).append("#"s);
+    CHECK(ch.writev(frame) == 13);
+    std::string got;
+    CHECK(ch.read(got) == 13);
+    CHECK(got == "[hdr]payload#");
+    CHECK(ch.stats().snapshot().m_writes == 1);
+    CHECK(ch.stats().snapshot().m_bytes_out == 13);
+    // more segments than max_iovec, written partially then rest
+    ChainBuffer many;
+    for (size_type i = 0; i < ChannelBase::max_iovec + 10; ++i) many.append("ab"s);
+    auto ret = ch.writev(many);
+    CHECK(ret == static_cast<return_code>(ChannelBase::max_iovec * 2));
+    many.trim_front(static_cast<size_type>(ret));
+    CHECK(ch.writev(many) == 20);
+    CHECK(ch.read(got) == static_cast<return_code>((ChannelBase::max_iovec + 10) * 2));
+}
+
+TEST_CASE("Gather write would block sets timeouted") {
+    PipeChannel ch;
+    auto size = ::fcntl(ch.reader(), F_GETPIPE_SZ);
+    REQUIRE(size > 0);
+    ChainBuffer fill(from_string(std::string(static_cast<size_type>(size), 'f')));
+    CHECK(ch.writev(fill) == static_cast<return_code>(size));
+    ChainBuffer more(from_string("more"s));
+    CHECK(ch.writev(more) == IO_TIMEOUT);
+    CHECK(ch.status().is_set(StatusFlag::timeouted));
+    CHECK_FALSE(ch.status().is_set(StatusFlag::failure));
+}
+
+TEST_CASE("ChannelStats counts isReady timeout") {
+    PipeChannel ch;
+    CHECK(ch.isReady(direction::out) == IO_OK);
+    auto s = ch.stats().snapshot();
+    CHECK(s.m_ready_wait.count() == 1);
+    CHECK(s.m_timeouts == 0);
+}
+
+TEST_CASE("ChannelStats counters of both directions from reader and writer thread") {
+    ChannelStats stats;
+    constexpr count_type n = 100000;
+    auto direction_loop = [&stats] {
+        for (count_type i = 0; i < n; ++i) {
+            stats.on_ready(IO_TIMEOUT, ChannelStats::now());
+            errno = EAGAIN;
+            stats.on_read(-1);
+        }
+    };
+    std::thread other(direction_loop);
+    direction_loop();
+    other.join();
+    auto s = stats.snapshot();
+    CHECK(s.m_timeouts == 2 * n);
+    CHECK(s.m_again == 2 * n);
+    CHECK(s.m_ready_wait.count() == 2 * n);
+}
+
+TEST_CASE("isReady with stop token") {
+    PipeChannel ch;
+    std::stop_source src;
+    CHECK(ch.isReady(direction::out, src.get_token(), 100) == IO_OK);
+    CHECK(ch.isReady(direction::in, src.get_token(), 10) == IO_TIMEOUT); // write side never readable
+    std::thread stopper([&src] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        src.request_stop();
+    });
+    CHECK(ch.isReady(direction::in, src.get_token()) == IO_CANCELED); // no timeout, woke up by stop
+    stopper.join();
+    CHECK(ch.isReady(direction::out, src.get_token()) == IO_CANCELED);
+    CHECK(ch.stats().snapshot().m_timeouts == 1);
+}
+
+TEST_CASE("isReady interrupted by signal counts as timeout") {
+    struct sigaction sa {}, old {};
+    sa.sa_handler = [](int) {};
+    REQUIRE(::sigaction(SIGURG, &sa, &old) == 0); // not blocked by m_mask
+    PipeChannel ch;
+    std::stop_source src;
+    auto self = ::pthread_self();
+    std::thread kicker([self] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ::pthread_kill(self, SIGURG);
+    });
+    CHECK(ch.isReady(direction::in, src.get_token(), 1000) == IO_TIMEOUT); // EINTR
+    kicker.join();
+    ::sigaction(SIGURG, &old, nullptr);
+    auto s = ch.stats().snapshot();
+    CHECK(s.m_timeouts == 1);
+    CHECK(ch.status().is_set(StatusFlag::timeouted));
+}
@@ -0,0 +1,69 @@
+/**
+ * @file pty.hpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Pseudo terminal pair for IO tests (in process, no socat)
+ *
+ * The master side is wrapped by PtyMaster (ChannelBase),
+ * the slave side is opened by name with Serial::Port like /tmp/vtty1 of scripts/vtty.
+ *
+ * @author s3mat3
+ */
+
+#pragma once
+
+#ifndef TEST_PTY_Hpp
+# define  TEST_PTY_Hpp
+
+# include <fcntl.h>
+# include <stdlib.h>
+
+# include "io/serial/port.hpp"
+
+namespace Sml {
+    namespace IO {
+        namespace Test {
+            /*! Master side of pty (non blocking) .
+             */
+            class PtyMaster : public ChannelBase
+            {
+            public:
+                PtyMaster()
+                {
+                    m_fd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+                    if (is_error_fd(m_fd)) return;
+                    char name[128] = {0};
+                    if (::grantpt(m_fd) < 0 || ::unlockpt(m_fd) < 0 || ::ptsname_r(m_fd, name, sizeof(name)) != 0) {
+                        ::close(m_fd);
+                        m_fd = void_fd();
+                        return;
+                    }
+                    m_slave_name.assign(name);
+                    m_status.set(status_flag::opened);
+                }
+                ~PtyMaster()
+                {
+                    if (! is_error_fd(m_fd)) ::close(m_fd);
+                }
+                auto read(byte_buffer& readed) noexcept -> return_code override
+                {
+                    return static_cast<return_code>(read_some(readed.data(), readed.size()));
+                }
+                auto write(const byte_buffer& forSend) noexcept -> return_code override
+                {
+                    return static_cast<return_code>(write_some(forSend.data(), forSend.size()));
+                }
+                /*! Path of slave device (e.g. /dev/pts/3) .
+                 */
+                auto slave_name() const noexcept -> const std::string& {return m_slave_name;}
+            private:
+                std::string m_slave_name {}; //!< slave device path
+            }; //<-- class PtyMaster ends here.
+        } //<-- namespace Test ends here.
+    } //<-- namespace IO ends here.
+} //<-- namespace Sml ends here.
+
+#endif //<-- macro  TEST_PTY_Hpp ends here.
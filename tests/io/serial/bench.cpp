@@ -0,0 +1,150 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for Serial::Port over in process pty pair (no socat)
+ *
+ * For every Baudrate and frame size
+ * - stream: Port::write frames, master side drains (bytes/s)
+ * - round trip: Port::write -> master echo back -> Port::read (latency percentiles)
+ * and report read/write system calls per frame from ChannelStats (poll is not included).
+ *
+ * @note pty has no line speed, the baudrate only changes termios setup of the slave,
+ *       so the numbers are the software path cost (regression baseline), not the wire time.
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <array>
+#include <poll.h>
+#include "benchmark/benchmark.h"
+
+#include "histogram.hpp"
+#include "../pty.hpp"
+
+using namespace Sml;
+using namespace Sml::IO;
+using namespace Sml::IO::Serial;
+
+static constexpr std::array<std::pair<Baudrate, const char*>, 7> baudrates {{
+    {Baudrate::BPS4800,   "4800"},
+    {Baudrate::BPS9600,   "9600"},
+    {Baudrate::BPS19200,  "19200"},
+    {Baudrate::BPS38400,  "38400"},
+    {Baudrate::BPS57600,  "57600"},
+    {Baudrate::BPS115200, "115200"},
+    {Baudrate::BPS230400, "230400"},
+}};
+
+/// wait readable (not counted as IO system call)
+static auto wait_in(fd_type fd) noexcept -> bool
+{
+    pollfd p {fd, POLLIN, 0};
+    return ::poll(&p, 1, 1000) > 0;
+}
+
+/// read exactly length bytes
+static auto read_frame(ChannelBase& ch, std::string& buf, size_type length) noexcept -> bool
+{
+    size_type got = 0;
+    std::string tmp(length, 0);
+    while (got < length) {
+        if (! wait_in(ch.fd())) return false;
+        tmp.resize(length - got);
+        auto n = ch.read(tmp);
+        if (n > 0) {
+            buf.replace(got, static_cast<size_type>(n), tmp.data(), static_cast<size_type>(n));
+            got += static_cast<size_type>(n);
+        } else if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// write whole frame (pty buffer is bigger than frame, partial is rare)
+static auto write_frame(ChannelBase& ch, const std::string& frame) noexcept -> bool
+{
+    std::string rest = frame;
+    while (! rest.empty()) {
+        auto n = ch.write(rest);
+        if (n > 0) rest.erase(0, static_cast<size_type>(n));
+        else if (n < 0 && errno != EAGAIN && errno != EINTR) return false;
+    }
+    return true;
+}
+
+/// read and write system calls of both side
+static auto syscalls(const ChannelBase& a, const ChannelBase& b) noexcept -> count_type
+{
+    auto x = a.stats().snapshot();
+    auto y = b.stats().snapshot();
+    return x.m_reads + x.m_writes + y.m_reads + y.m_writes;
+}
+
+static void BM_serial_stream(benchmark::State& state) {
+    const auto& [baud, label] = baudrates[static_cast<size_type>(state.range(0))];
+    const auto length = static_cast<size_type>(state.range(1));
+    Test::PtyMaster master;
+    Port port(master.slave_name(), baud);
+    if (port.connect() != OK) {state.SkipWithError("pty open failed"); return;}
+    const std::string frame(length, 'S');
+    std::string sink(length, 0);
+    auto before = syscalls(master, port);
+    for (auto _ : state) {
+        if (! write_frame(port, frame) || ! read_frame(master, sink, length)) {
+            state.SkipWithError("io error");
+            break;
+        }
+    }
+    auto frames = static_cast<double>(state.iterations());
+    state.SetLabel(label);
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+    state.counters["syscalls_per_frame"] = static_cast<double>(syscalls(master, port) - before) / frames;
+}
+
+static void BM_serial_round_trip(benchmark::State& state) {
+    const auto& [baud, label] = baudrates[static_cast<size_type>(state.range(0))];
+    const auto length = static_cast<size_type>(state.range(1));
+    Test::PtyMaster master;
+    Port port(master.slave_name(), baud);
+    if (port.connect() != OK) {state.SkipWithError("pty open failed"); return;}
+    const std::string frame(length, 'R');
+    std::string echo(length, 0);
+    std::string back(length, 0);
+    Histogram<> latency;
+    auto before = syscalls(master, port);
+    for (auto _ : state) {
+        ScopedRecorder r(latency);
+        if (! write_frame(port, frame)
+            || ! read_frame(master, echo, length)
+            || ! write_frame(master, echo)
+            || ! read_frame(port, back, length)) {
+            state.SkipWithError("io error");
+            break;
+        }
+    }
+    auto frames = static_cast<double>(state.iterations());
+    state.SetLabel(label);
+    state.SetBytesProcessed(state.iterations() * state.range(1) * 2);
+    state.counters["syscalls_per_frame"] = static_cast<double>(syscalls(master, port) - before) / frames;
+    state.counters["p50_ns"]  = static_cast<double>(latency.p50());
+    state.counters["p99_ns"]  = static_cast<double>(latency.p99());
+    state.counters["p999_ns"] = static_cast<double>(latency.p999());
+    state.counters["max_ns"]  = static_cast<double>(latency.max());
+}
+
+static void arguments(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"baud", "frame"});
+    for (size_type i = 0; i < baudrates.size(); ++i) {
+        for (auto length : {1, 16, 64, 256, 1024}) b->Args({static_cast<std::int64_t>(i), length});
+    }
+}
+BENCHMARK(BM_serial_stream)->Apply(arguments)->UseRealTime();
+BENCHMARK(BM_serial_round_trip)->Apply(arguments)->UseRealTime();
+
+BENCHMARK_MAIN();
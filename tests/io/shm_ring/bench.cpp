@@ -0,0 +1,138 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for frame hand-off between two processes, ShmRing (zero copy) VS socketpair (copies)
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "benchmark/benchmark.h"
+
+#include "io/shm_ring.hpp"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+static constexpr size_type ring_capacity = 1 << 20;
+
+/// consumer process touches every frame until empty frame
+static void BM_shm_ring_stream(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    ShmRing ring;
+    ring.create("", ring_capacity, ShmRingMode::spsc);
+    auto pid = ::fork();
+    if (pid == 0) {
+        ShmRing::ReadSlot r;
+        std::uint64_t sum = 0;
+        for (;;) {
+            ring.peek(r);
+            sum += static_cast<unsigned char>(r.m_data[r.m_size / 2]);
+            auto done = (r.m_size == 0);
+            ring.consume(r);
+            if (done) ::_exit(static_cast<int>(sum & 1));
+        }
+    }
+    for (auto _ : state) {
+        ShmRing::WriteSlot w;
+        ring.reserve(n, w);
+        std::memset(w.m_data, 0x5a, n); // produce in place
+        ring.commit(w);
+    }
+    ring.write("", 0);
+    ::waitpid(pid, nullptr, 0);
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_shm_ring_stream)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+/// same by SOCK_SEQPACKET (frame boundary kept), copy in and out of kernel
+static void BM_socketpair_stream(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    int fds[2];
+    ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds);
+    int size = static_cast<int>(ring_capacity);
+    ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+    auto pid = ::fork();
+    if (pid == 0) {
+        ::close(fds[0]);
+        std::string frame(n, '\0');
+        std::uint64_t sum = 0;
+        for (;;) {
+            auto ret = ::recv(fds[1], frame.data(), frame.size(), 0);
+            if (ret <= 0) ::_exit(static_cast<int>(sum & 1));
+            sum += static_cast<unsigned char>(frame[static_cast<size_type>(ret) / 2]);
+        }
+    }
+    ::close(fds[1]);
+    std::string frame(n, '\0');
+    for (auto _ : state) {
+        std::memset(frame.data(), 0x5a, n); // produce then copy
+        benchmark::DoNotOptimize(::send(fds[0], frame.data(), n, 0));
+    }
+    ::close(fds[0]);
+    ::waitpid(pid, nullptr, 0);
+    state.SetBytesProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_socketpair_stream)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+/// echo by other process over two rings (futex wake up latency across processes)
+static void BM_shm_ring_round_trip(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    ShmRing ping, pong;
+    ping.create("", ring_capacity, ShmRingMode::spsc);
+    pong.create("", ring_capacity, ShmRingMode::spsc);
+    auto pid = ::fork();
+    if (pid == 0) {
+        ShmRing::ReadSlot r;
+        for (;;) {
+            ping.peek(r);
+            pong.write(r.m_data, r.m_size);
+            auto done = (r.m_size == 0);
+            ping.consume(r);
+            if (done) ::_exit(0);
+        }
+    }
+    std::string frame(n, 0x5a);
+    ShmRing::ReadSlot r;
+    for (auto _ : state) {
+        ping.write(frame.data(), n);
+        pong.peek(r);
+        pong.consume(r);
+    }
+    ping.write("", 0);
+    ::waitpid(pid, nullptr, 0);
+}
+BENCHMARK(BM_shm_ring_round_trip)->Arg(64)->UseRealTime();
+
+static void BM_socketpair_round_trip(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    int fds[2];
+    ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds);
+    auto pid = ::fork();
+    if (pid == 0) {
+        ::close(fds[0]);
+        std::string frame(n, '\0');
+        for (;;) {
+            auto ret = ::recv(fds[1], frame.data(), frame.size(), 0);
+            if (ret <= 0) ::_exit(0);
+            ::send(fds[1], frame.data(), static_cast<size_type>(ret), 0);
+        }
+    }
+    ::close(fds[1]);
+    std::string frame(n, 0x5a);
+    for (auto _ : state) {
+        ::send(fds[0], frame.data(), n, 0);
+        benchmark::DoNotOptimize(::recv(fds[0], frame.data(), n, 0));
+    }
+    ::close(fds[0]);
+    ::waitpid(pid, nullptr, 0);
+}
+BENCHMARK(BM_socketpair_round_trip)->Arg(64)->UseRealTime();
+
+BENCHMARK_MAIN();
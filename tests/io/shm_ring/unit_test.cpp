@@ -0,0 +1,257 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for ShmRing (in process and between two processes)
+ *
+ * @author s3mat3
+ */
+
+#include <sys/wait.h>
+#include "io/shm_ring.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+using namespace Sml::IO;
+
+/// frame content by sequence number (producer id in first byte)
+static auto fill(char* p, size_type n, std::uint32_t seq, char id = 0) -> void
+{
+    for (size_type i = 0; i < n; ++i) p[i] = static_cast<char>((seq + i) & 0xff);
+    if (n >= 5) {
+        p[0] = id;
+        std::memcpy(p + 1, &seq, sizeof(seq));
+    }
+}
+static auto check(const char* p, size_type n, std::uint32_t seq) -> bool
+{
+    std::string expect(n, '\0');
+    fill(expect.data(), n, seq, p[0]);
+    return std::memcmp(expect.data(), p, n) == 0;
+}
+static auto length_of(std::uint32_t seq) -> size_type {return 5 + (seq * 37) % 700;}
+/// run in child process, returns exit status
+template <typename F>
+static auto child(F func) -> pid_t
+{
+    auto pid = ::fork();
+    if (pid == 0) ::_exit(func());
+    return pid;
+}
+static auto exit_code(pid_t pid) -> int
+{
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+TEST_CASE("Reserve, commit, peek and consume in place") {
+    ShmRing ring;
+    REQUIRE(ring.create("", 4096, ShmRingMode::spsc) == IO_OK);
+    CHECK(ring.capacity() == 4096);
+    CHECK(ring.max_frame() == 2048 - 16);
+    ShmRing::ReadSlot r;
+    CHECK(ring.peek(r, 0) == IO_TIMEOUT);
+    ShmRing::WriteSlot w;
+    REQUIRE(ring.reserve(100, w) == IO_OK);
+    fill(w.m_data, w.m_size, 1);
+    CHECK(ring.empty()); // not committed yet
+    CHECK(ring.commit(w) == IO_OK);
+    REQUIRE(ring.peek(r, 0) == IO_OK);
+    CHECK(r.m_data == w.m_data); // zero copy
+    CHECK(r.m_size == 100);
+    CHECK(check(r.m_data, r.m_size, 1));
+    CHECK(ring.consume(r) == IO_OK);
+    CHECK(ring.empty());
+    CHECK(ring.reserve(ring.max_frame() + 1, w) == IO_FAILURE);
+}
+
+TEST_CASE("Wrap around by pad record and full ring") {
+    ShmRing ring;
+    REQUIRE(ring.create("", 4096, ShmRingMode::mpsc) == IO_OK);
+    std::string frame(1000, 'x');
+    ByteBuffer out(16);
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        auto n = length_of(i);
+        fill(frame.data(), n, i);
+        REQUIRE(ring.write(frame.data(), n, 0) == IO_OK);
+        REQUIRE(ring.read(out, 0) == IO_OK);
+        CHECK(out.size() == n);
+        CHECK(check(out.const_ptr(), out.size(), i));
+    }
+    count_type written = 0;
+    while (ring.write(frame.data(), 1000, 0) == IO_OK) ++written;
+    CHECK(written == 3); // 1016 bytes record in 4096 bytes (with pad)
+    CHECK(ring.write(frame.data(), 1000, 10) == IO_TIMEOUT);
+}
+
+TEST_CASE("SPSC between two processes") {
+    static constexpr std::uint32_t frames = 20000;
+    ShmRing ring;
+    REQUIRE(ring.create("", 64 * 1024, ShmRingMode::spsc) == IO_OK);
+    auto pid = child([&ring] {
+        for (std::uint32_t i = 0; i < frames; ++i) {
+            ShmRing::WriteSlot w;
+            if (ring.reserve(length_of(i), w, 5000) != IO_OK) return 1;
+            fill(w.m_data, w.m_size, i);
+            ring.commit(w);
+        }
+        return 0;
+    });
+    std::uint32_t bad = 0, received = 0;
+    for (; received < frames; ++received) {
+        ShmRing::ReadSlot r;
+        if (ring.peek(r, 5000) != IO_OK) break;
+        if (r.m_size != length_of(received) || ! check(r.m_data, r.m_size, received)) ++bad;
+        ring.consume(r);
+    }
+    CHECK(exit_code(pid) == 0);
+    CHECK(received == frames);
+    CHECK(bad == 0);
+}
+
+TEST_CASE("MPSC from three processes") {
+    static constexpr std::uint32_t frames = 5000;
+    static constexpr char producers = 3;
+    ShmRing ring;
+    REQUIRE(ring.create("", 16 * 1024, ShmRingMode::mpsc) == IO_OK);
+    pid_t pids[producers];
+    for (char id = 0; id < producers; ++id) {
+        pids[static_cast<int>(id)] = child([&ring, id] {
+            for (std::uint32_t i = 0; i < frames; ++i) {
+                ShmRing::WriteSlot w;
+                if (ring.reserve(length_of(i), w, 5000) != IO_OK) return 1;
+                fill(w.m_data, w.m_size, i, id);
+                ring.commit(w);
+            }
+            return 0;
+        });
+    }
+    std::uint32_t next[producers] = {0, 0, 0};
+    std::uint32_t bad = 0;
+    for (std::uint32_t n = 0; n < frames * producers; ++n) {
+        ShmRing::ReadSlot r;
+        if (ring.peek(r, 5000) != IO_OK) break;
+        auto id = r.m_data[0];
+        std::uint32_t seq = 0;
+        std::memcpy(&seq, r.m_data + 1, sizeof(seq));
+        if (id < 0 || id >= producers || seq != next[static_cast<int>(id)]
+            || r.m_size != length_of(seq) || ! check(r.m_data, r.m_size, seq)) ++bad;
+        else ++next[static_cast<int>(id)];
+        ring.consume(r);
+    }
+    for (auto pid : pids) CHECK(exit_code(pid) == 0);
+    CHECK(bad == 0);
+    for (auto n : next) CHECK(n == frames);
+}
+
+TEST_CASE("Recover frame reserved by crashed producer") {
+    ShmRing ring;
+    REQUIRE(ring.create("", 4096, ShmRingMode::mpsc) == IO_OK);
+    // crashed between reserve and commit
+    auto crashed = child([&ring] {
+        ShmRing::WriteSlot w;
+        ring.reserve(64, w);
+        return 0;
+    });
+    CHECK(exit_code(crashed) == 0);
+    // next producer commits after the crashed one, commit waits in order and recovers
+    auto pid = child([&ring] {
+        std::string frame(32, '\0');
+        fill(frame.data(), frame.size(), 7);
+        return (ring.write(frame.data(), frame.size(), 1000) == IO_OK) ? 0 : 1;
+    });
+    CHECK(exit_code(pid) == 0);
+    ShmRing::ReadSlot r;
+    REQUIRE(ring.peek(r, 1000) == IO_OK);
+    CHECK(r.m_size == 32);
+    CHECK(check(r.m_data, r.m_size, 7));
+    ring.consume(r);
+    CHECK(ring.empty());
+    // SPSC style, consumer recovers after timeout
+    crashed = child([&ring] {
+        ShmRing::WriteSlot w;
+        ring.reserve(64, w);
+        return 0;
+    });
+    CHECK(exit_code(crashed) == 0);
+    CHECK(ring.peek(r, 10) == IO_TIMEOUT);
+    CHECK(ring.recover() == 1);
+    CHECK(ring.peek(r, 0) == IO_TIMEOUT); // pad only
+    CHECK(ring.write("abc", 3) == IO_OK);
+    REQUIRE(ring.peek(r, 0) == IO_OK);
+    CHECK(std::string(r.m_data, r.m_size) == "abc");
+}
+
+TEST_CASE("Recover stops at reserved record without header") {
+    ShmRing ring;
+    REQUIRE(ring.create("", 4096, ShmRingMode::mpsc) == IO_OK);
+    auto dead = child([] {return 0;});
+    REQUIRE(exit_code(dead) == 0);
+    // stale bytes looking like a header of dead producer at offset 128 (inside payload of old frame)
+    std::string stale(2000, '\0');
+    std::uint64_t stamp = ShmRecord::stamp(ShmRecord::reserved_kind, 128);
+    std::uint32_t length = 16;
+    std::int32_t pid = dead;
+    std::memcpy(stale.data() + 48, &stamp, sizeof(stamp));
+    std::memcpy(stale.data() + 56, &length, sizeof(length));
+    std::memcpy(stale.data() + 60, &pid, sizeof(pid));
+    ByteBuffer out;
+    for (auto n : {size_type {48}, stale.size(), size_type {2000}, size_type {112}}) { // positions 0, 64, 2080, 4096 -> 4224
+        REQUIRE(ring.write((n == stale.size()) ? stale.data() : std::string(n, 'x').data(), n) == IO_OK);
+        REQUIRE(ring.read(out, 0) == IO_OK);
+    }
+    REQUIRE(ring.shared_header()->m_reserve.load() == 4096 + 128);
+    // live producer won the reservation but has not written the header yet
+    const_cast<ShmRingHeader*>(ring.shared_header())->m_reserve.fetch_add(64);
+    CHECK(ring.recover() == 0);
+    CHECK(ring.shared_header()->m_tail.load() == 4096 + 128);
+    CHECK(ring.empty());
+}
+
+TEST_CASE("Accessors of closed ring") {
+    ShmRing ring;
+    CHECK_FALSE(ring.is_open());
+    CHECK(ring.size() == 0);
+    CHECK(ring.empty());
+    CHECK(ring.mode() == ShmRingMode::spsc);
+    CHECK(ring.recover() == 0);
+}
+
+TEST_CASE("Named ring and consumer restart") {
+    const std::string name = "/sml-shm-ring-test-" + std::to_string(::getpid());
+    ShmRing::unlink(name);
+    ShmRing producer;
+    REQUIRE(producer.create(name, 8192, ShmRingMode::spsc) == IO_OK);
+    CHECK(ShmRing().create(name, 8192, ShmRingMode::spsc) == IO_FAILURE); // exclusive
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        std::string frame(length_of(i), '\0');
+        fill(frame.data(), frame.size(), i);
+        REQUIRE(producer.write(frame.data(), frame.size()) == IO_OK);
+    }
+    // consumer process takes two frames and exits before consume of the third
+    auto pid = child([&name] {
+        ShmRing consumer;
+        if (consumer.open(name) != IO_OK) return 1;
+        ShmRing::ReadSlot r;
+        for (std::uint32_t i = 0; i < 2; ++i) {
+            if (consumer.peek(r, 0) != IO_OK || ! check(r.m_data, r.m_size, i)) return 2;
+            consumer.consume(r);
+        }
+        return (consumer.peek(r, 0) == IO_OK) ? 0 : 3;
+    });
+    CHECK(exit_code(pid) == 0);
+    ShmRing restarted;
+    REQUIRE(restarted.open(name) == IO_OK);
+    CHECK(restarted.mode() == ShmRingMode::spsc);
+    ShmRing::ReadSlot r;
+    REQUIRE(restarted.peek(r, 0) == IO_OK);
+    CHECK(check(r.m_data, r.m_size, 2)); // resumed from persisted read position
+    CHECK(ShmRing::unlink(name) == IO_OK);
+    CHECK(ShmRing().open(name) == IO_FAILURE);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for notify() cost, Notification (std::function) VS InplaceNotification VS NotificationRef
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <atomic>
+#include <thread>
+#include "benchmark/benchmark.h"
+
+#include "multi_notification.hpp"
+#include "notification.hpp"
+
+using namespace Sml;
+
+static return_code function_i(return_code i)
+{
+    benchmark::DoNotOptimize(i);
+    return i;
+}
+
+class SomeClass
+{
+public:
+    return_code function_i(return_code i) {m_sum += i; return m_sum;}
+private:
+    return_code m_sum {0};
+};
+
+using inplace_t = InplaceNotification<inplace_function_capacity, return_code>;
+using ref_t     = NotificationRef<return_code>;
+/////////////////
+// free function
+/////////////////
+static void BM_std_function_free(benchmark::State& state) {
+    Notification<return_code> n(function_i, SML_ARGC(1));
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_inplace_free(benchmark::State& state) {
+    inplace_t n(function_i);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_ref_free(benchmark::State& state) {
+    ref_t n(function_i);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+BENCHMARK(BM_std_function_free);
+BENCHMARK(BM_inplace_free);
+BENCHMARK(BM_ref_free);
+/////////////////
+// lambda (capture 3 pointers)
+/////////////////
+static void BM_std_function_lambda(benchmark::State& state) {
+    return_code a = 0, b = 0, c = 0;
+    Notification<return_code> n([&a, &b, &c](return_code i) {a += i; b ^= i; c = a + b; return c;}, SML_ARGC(1));
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_inplace_lambda(benchmark::State& state) {
+    return_code a = 0, b = 0, c = 0;
+    inplace_t n([&a, &b, &c](return_code i) {a += i; b ^= i; c = a + b; return c;});
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_ref_lambda(benchmark::State& state) {
+    return_code a = 0, b = 0, c = 0;
+    auto lambda = [&a, &b, &c](return_code i) {a += i; b ^= i; c = a + b; return c;};
+    ref_t n(lambda);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+BENCHMARK(BM_std_function_lambda);
+BENCHMARK(BM_inplace_lambda);
+BENCHMARK(BM_ref_lambda);
+/////////////////
+// member function
+/////////////////
+static void BM_std_function_member(benchmark::State& state) {
+    SomeClass s;
+    Notification<return_code> n(&SomeClass::function_i, &s, SML_ARGC(1));
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_inplace_member(benchmark::State& state) {
+    SomeClass s;
+    inplace_t n(&SomeClass::function_i, &s);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_inplace_member_static(benchmark::State& state) {
+    SomeClass s;
+    inplace_t n;
+    n.connect<&SomeClass::function_i>(&s);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+static void BM_ref_member(benchmark::State& state) {
+    SomeClass s;
+    ref_t n;
+    n.connect<&SomeClass::function_i>(&s);
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+}
+BENCHMARK(BM_std_function_member);
+BENCHMARK(BM_inplace_member);
+BENCHMARK(BM_inplace_member_static);
+BENCHMARK(BM_ref_member);
+
+/////////////////
+// multi subscriber (1, 8, 64 subscribers)
+/////////////////
+static void BM_multi_notify(benchmark::State& state) {
+    MultiNotification<return_code> n;
+    return_code sum = 0;
+    for (auto j = 0; j < state.range(0); ++j) n.connect([&sum](return_code i) {sum += i; return OK;});
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+    benchmark::DoNotOptimize(sum);
+}
+static void BM_multi_notify_concurrent_connect(benchmark::State& state) {
+    MultiNotification<return_code> n;
+    std::atomic<return_code> sum {0};
+    for (auto j = 0; j < state.range(0); ++j) n.connect([&sum](return_code i) {sum.fetch_add(i, std::memory_order_relaxed); return OK;});
+    std::atomic<bool> run {true};
+    std::thread churn([&] { // connect / disconnect repeatedly
+        while (run.load(std::memory_order_relaxed)) {
+            auto c = n.connect([](return_code) {return OK;});
+            std::this_thread::yield();
+            n.disconnect(c);
+        }
+    });
+    return_code i = 0;
+    for (auto _ : state) benchmark::DoNotOptimize(n.notify(++i));
+    run = false;
+    churn.join();
+}
+BENCHMARK(BM_multi_notify)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_multi_notify_concurrent_connect)->Arg(1)->Arg(8)->Arg(64);
+
+BENCHMARK_MAIN();
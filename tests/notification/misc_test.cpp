@@ -9,6 +9,7 @@
  * \author s3mat3
  */
 
+#include "multi_notification.hpp"
 #include "notification.hpp"
 
 using namespace Sml;
@@ -76,10 +77,83 @@ SML_TEST_BEGIN(fromClass) {
 }
 SML_TEST_END
 
+SML_TEST_BEGIN(inplace) {
+    SomeClass s;
+    InplaceNotification<inplace_function_capacity> v_noti(function_void);
+    SML_ASSERT((v_noti), "free function", true);
+    SML_ASSERT(v_noti() == FAILURE, "-1", true);
+
+    InplaceNotification<inplace_function_capacity, return_code> i_noti(&SomeClass::function_i, &s);
+    SML_ASSERT((i_noti), "member function", true);
+    SML_ASSERT(i_noti(1000) == 1000, "1000", true);
+
+    i_noti.connect<&SomeClass::function_i>(&s);
+    SML_ASSERT(i_noti(2000) == 2000, "2000", true);
+
+    return_code value = FAILURE;
+    i_noti.connect([&value](return_code a) {value = a; return a;});
+    i_noti(-1000);
+    SML_ASSERT(value == -1000, "lambda", true);
+
+    auto moved = std::move(i_noti);
+    SML_ASSERT(!(i_noti), "moved from", true);
+    SML_ASSERT(moved(-2000) == -2000, "moved to", true);
+
+    i_noti.disconnect();
+    SML_ASSERT(i_noti(1) == FAILURE, "no receiver", true);
+}
+SML_TEST_END
+
+SML_TEST_BEGIN(reference) {
+    SomeClass s;
+    NotificationRef<> v_noti(function_void);
+    SML_ASSERT((v_noti), "free function", true);
+    SML_ASSERT(v_noti() == FAILURE, "-1", true);
+
+    NotificationRef<return_code> i_noti;
+    i_noti.connect<&SomeClass::function_i>(&s);
+    SML_ASSERT(i_noti(1000) == 1000, "member function", true);
+
+    return_code value = FAILURE;
+    auto lambda = [&value](return_code a) {value = a; return a;};
+    i_noti.connect(lambda);
+    i_noti(-1000);
+    SML_ASSERT(value == -1000, "lambda", true);
+}
+SML_TEST_END
+
+SML_TEST_BEGIN(multi) {
+    SomeClass s;
+    MultiNotification<return_code> noti;
+    SML_ASSERT(noti(1) == FAILURE, "no subscriber", true);
+    return_code a = 0, b = 0;
+    auto ca = noti.connect([&a](return_code x) {a += x; return OK;});
+    auto cb = noti.connect([&b](return_code x) {b += x; return OK;});
+    auto cm = noti.connect(&SomeClass::function_i, &s);
+    SML_ASSERT(noti.size() == 3, "3 subscribers", true);
+    SML_ASSERT(noti(10) == 10, "first not OK code", true);
+    SML_ASSERT(a == 10 && b == 10, "fan out", true);
+    SML_ASSERT(noti.disconnect(cm) == OK, "disconnect member", true);
+    SML_ASSERT(noti(5) == OK, "all OK", true);
+    SML_ASSERT(noti.disconnect(cm) == NO_DATA, "already disconnected", true);
+    auto snapshot = noti.snapshot();
+    SML_ASSERT(noti.disconnect(ca) == OK, "disconnect a", true);
+    SML_ASSERT(snapshot->size() == 2, "old snapshot is kept", true);
+    noti(1);
+    SML_ASSERT(a == 15 && b == 16, "only b", true);
+    SML_ASSERT(ca != cb, "unique handle", true);
+    noti.disconnect_all();
+    SML_ASSERT(!(noti), "empty", true);
+}
+SML_TEST_END
+
 int main()
 {
     freeFunc();
     fromClass();
+    inplace();
+    reference();
+    multi();
     return OK;
 }
 
@@ -0,0 +1,63 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for profiler zone overhead
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include "benchmark/benchmark.h"
+
+#include "profiler.hpp"
+
+using namespace Sml;
+
+static void BM_tsc_now(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::now());
+    }
+}
+BENCHMARK(BM_tsc_now);
+
+static void BM_steady_clock_now(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MeasureTime::system_clock::now());
+    }
+}
+BENCHMARK(BM_steady_clock_now);
+
+static void BM_zone_disabled(benchmark::State& state) {
+    Profiler::disable();
+    for (auto _ : state) {
+        SML_PROFILE_ZONE("disabled");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_zone_disabled);
+
+static void BM_zone_enabled(benchmark::State& state) {
+    Profiler::enable();
+    count_type n = 0;
+    for (auto _ : state) {
+        {
+            SML_PROFILE_ZONE("enabled");
+            benchmark::ClobberMemory();
+        }
+        if (++n == Profiler::default_capacity) { // keep buffer hot, not measure drop path
+            state.PauseTiming();
+            Profiler::clear();
+            n = 0;
+            state.ResumeTiming();
+        }
+    }
+    Profiler::disable();
+    state.counters["dropped"] = static_cast<double>(Profiler::dropped());
+    Profiler::clear();
+}
+BENCHMARK(BM_zone_enabled);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for Profiler (scoped zone, thread buffer, Chrome trace)
+ *
+ * @author s3mat3
+ */
+
+#include <sstream>
+#include <thread>
+#include "profiler.hpp"
+#include "fsm.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+static auto busy(int n) -> int
+{
+    SML_PROFILE_ZONE("busy");
+    volatile int x = 0;
+    for (int i = 0; i < n; ++i) x = x + i;
+    return x;
+}
+
+TEST_CASE("Zone is not recorded while disabled") {
+    Profiler::disable();
+    Profiler::clear();
+    busy(10);
+    CHECK(Profiler::size() == 0);
+}
+
+TEST_CASE("Zone recorded and calibrated") {
+    Profiler::clear();
+    Profiler::enable();
+    CHECK(Profiler::ns_per_tick() > 0.0);
+    busy(1000);
+    busy(1000);
+    Profiler::disable();
+    CHECK(Profiler::size() == 2);
+    CHECK(Profiler::dropped() == 0);
+}
+
+TEST_CASE("Per thread buffers and Chrome trace output") {
+    Profiler::clear();
+    Profiler::enable();
+    std::thread th([] {
+        Profiler::thread_name("worker \"1\"");
+        busy(100);
+    });
+    th.join();
+    busy(100);
+    Profiler::disable();
+    CHECK(Profiler::size() == 2);
+    std::ostringstream os;
+    Profiler::write_chrome_trace(os);
+    auto json = os.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"busy\"") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("worker \\\"1\\\"") != std::string::npos);
+}
+
+TEST_CASE("Fsm::dispatch is profiled") {
+    struct Ctx {};
+    class S : public State<Ctx>
+    {
+    public:
+        S() : State<Ctx>(1, "S") {}
+    };
+    auto s = std::make_shared<S>();
+    Fsm<Ctx> fsm(s);
+    Profiler::clear();
+    Profiler::enable();
+    fsm.dispatch(0);
+    Profiler::disable();
+    std::ostringstream os;
+    Profiler::write_chrome_trace(os);
+    CHECK(os.str().find("Fsm::dispatch") != std::string::npos);
+}
+
+TEST_CASE("Events over capacity are dropped") {
+    Profiler::capacity(4);
+    Profiler::enable();
+    std::thread th([] {for (int i = 0; i < 10; ++i) busy(1);});
+    th.join();
+    Profiler::disable();
+    CHECK(Profiler::dropped() == 6);
+    Profiler::capacity(Profiler::default_capacity);
+}
+
+TEST_CASE("Buffers of exited threads are released by clear") {
+    Profiler::clear();
+    Profiler::enable();
+    busy(1);                                    // buffer of main thread
+    auto base = Profiler::buffers();
+    for (int i = 0; i < 8; ++i) {
+        std::thread th([] {busy(1);});
+        th.join();
+    }
+    Profiler::disable();
+    CHECK(Profiler::buffers() == base + 8);     // kept for output
+    CHECK(Profiler::size() == 9);
+    Profiler::clear();
+    CHECK(Profiler::buffers() == base);         // main thread is alive
+    CHECK(Profiler::size() == 0);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for returning 1MiB ByteBuffer through Sml::Result
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <optional>
+#include "benchmark/benchmark.h"
+
+#include "byte_buffer.hpp"
+#include "result.hpp"
+
+using namespace Sml;
+/**  .
+ *
+ * 1048576 rooms (1M)
+ */
+const size_type TEST_ROOMS = request_volume(rooms::V1K) * request_volume(rooms::V1K);
+
+static auto make_buffer() -> ByteBuffer
+{
+    ByteBuffer b(TEST_ROOMS, 'c');
+    return b;
+}
+static auto make_result() -> Result<ByteBuffer>
+{
+    ByteBuffer b(TEST_ROOMS, 'c');
+    return b; // implicit move into Result
+}
+static auto make_optional() -> std::optional<ByteBuffer>
+{
+    std::optional<ByteBuffer> b(std::in_place, TEST_ROOMS, 'c');
+    return b;
+}
+
+static void BM_buffer_return(benchmark::State& state) {
+    for (auto _ : state) {
+        auto b = make_buffer();
+        benchmark::DoNotOptimize(b.ptr());
+    }
+}
+static void BM_optional_return(benchmark::State& state) {
+    for (auto _ : state) {
+        auto b = make_optional();
+        benchmark::DoNotOptimize(b->ptr());
+    }
+}
+static void BM_result_return(benchmark::State& state) {
+    for (auto _ : state) {
+        auto r = make_result();
+        benchmark::DoNotOptimize(r.value().ptr());
+    }
+}
+static void BM_result_value_move(benchmark::State& state) {
+    for (auto _ : state) {
+        ByteBuffer b(make_result().value_or(ByteBuffer(ZERO)));
+        benchmark::DoNotOptimize(b.ptr());
+    }
+}
+static void BM_result_value_copy(benchmark::State& state) {
+    for (auto _ : state) {
+        auto r = make_result();
+        ByteBuffer b(r.value()); // old behavior: value() copied every time
+        benchmark::DoNotOptimize(b.ptr());
+    }
+}
+BENCHMARK(BM_buffer_return);
+BENCHMARK(BM_optional_return);
+BENCHMARK(BM_result_return);
+BENCHMARK(BM_result_value_move);
+BENCHMARK(BM_result_value_copy);
+
+static void BM_result_extract(benchmark::State& state) {
+    ByteBuffer src(TEST_ROOMS, 'c');
+    for (auto _ : state) {
+        auto r = src.extract(0, TEST_ROOMS / 2);
+        benchmark::DoNotOptimize(r.value().ptr());
+    }
+}
+BENCHMARK(BM_result_extract);
+
+BENCHMARK_MAIN();
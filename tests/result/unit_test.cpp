@@ -4,6 +4,7 @@
  *
  */
 
+#include <memory>
 #include "result.hpp"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -101,3 +102,75 @@ TEST_CASE("class result")
         CHECK(x.value().str() == "a + b = 330");
     }
 };
+
+TEST_CASE("move only result")
+{
+    using result = Result<std::unique_ptr<int>>;
+    auto x = result(std::make_unique<int>(10));
+    REQUIRE((x));
+    CHECK(*x.value() == 10);
+    auto p = std::move(x).value();
+    REQUIRE(p);
+    CHECK(*p == 10);
+    auto y = result(error_type(FAIL_ARG));
+    auto z = std::move(y);
+    CHECK(z.has_value() == false);
+    CHECK(z.error() == FAIL_ARG);
+}
+
+TEST_CASE("value reference access")
+{
+    auto x = Result<std::string>("Hello");
+    x.value().append(" world");
+    CHECK(x.value() == "Hello world");
+    const auto& cx = x;
+    CHECK(&cx.value() == &x.value());
+    auto s = std::move(x).value();
+    CHECK(s == "Hello world");
+}
+
+TEST_CASE("value_or")
+{
+    auto x = Result<std::string>("value");
+    auto e = Result<std::string>(error_type(FAILURE));
+    CHECK(x.value_or("default") == "value");
+    CHECK(e.value_or("default") == "default");
+    CHECK(Result<int>(error_type(FAILURE)).value_or(3) == 3);
+}
+
+TEST_CASE("monadic")
+{
+    auto half = [](int v) -> Result<int> {
+        if (v % 2) return Result<int>(error_type(FAIL_ARG));
+        return Result<int>(v / 2);
+    };
+    SUBCASE("and_then") {
+        auto x = Result<int>(8).and_then(half).and_then(half);
+        REQUIRE((x));
+        CHECK(x.value() == 2);
+        auto y = Result<int>(6).and_then(half).and_then(half);
+        CHECK(y.has_value() == false);
+        CHECK(y.error() == FAIL_ARG);
+    }
+    SUBCASE("transform") {
+        auto x = Result<int>(8).transform([](int v) {return std::to_string(v);});
+        REQUIRE((x));
+        CHECK(x.value() == "8");
+        auto y = Result<int>(error_type(FAIL_CMD)).transform([](int v) {return std::to_string(v);});
+        CHECK(y.has_value() == false);
+        CHECK(y.error() == FAIL_CMD);
+    }
+    SUBCASE("or_else") {
+        auto x = Result<int>(error_type(FAIL_CMD)).or_else([](const error_type& e) {return Result<int>(static_cast<int>(e.code()));});
+        REQUIRE((x));
+        CHECK(x.value() == FAIL_CMD);
+        auto y = Result<int>(1).or_else([](const error_type&) {return Result<int>(0);});
+        CHECK(y.value() == 1);
+    }
+    SUBCASE("move only chain") {
+        auto x = Result<std::unique_ptr<int>>(std::make_unique<int>(5))
+            .transform([](std::unique_ptr<int>&& p) {*p += 1; return std::move(p);});
+        REQUIRE((x));
+        CHECK(*x.value() == 6);
+    }
+}
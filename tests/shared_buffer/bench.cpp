@@ -0,0 +1,63 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for fan-out of one frame to 4 consumers, SharedBuffer VS ByteBuffer copy
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <array>
+#include <string>
+#include "benchmark/benchmark.h"
+
+#include "shared_buffer.hpp"
+
+using namespace Sml;
+
+static constexpr size_type CONSUMERS = 4;
+
+/// each consumer gets own copy (StorageBase copy constructor)
+static void BM_fan_out_copy(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto frame = from_string(std::string(n, 'f'));
+    for (auto _ : state) {
+        auto received = ByteBuffer(frame);
+        std::array<ByteBuffer, CONSUMERS> consumers = {ByteBuffer(received), ByteBuffer(received), ByteBuffer(received), ByteBuffer(received)};
+        for (auto& c : consumers) benchmark::DoNotOptimize(c.const_ptr()[n / 2]);
+    }
+    state.SetBytesProcessed(state.iterations() * n * CONSUMERS);
+}
+BENCHMARK(BM_fan_out_copy)->Arg(64)->Arg(1024)->Arg(16384);
+
+/// each consumer gets shared view (reference count)
+static void BM_fan_out_shared(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto frame = from_string(std::string(n, 'f'));
+    for (auto _ : state) {
+        SharedBuffer received {ByteBuffer(frame)}; // copy of receive, same as above
+        std::array<SharedBuffer, CONSUMERS> consumers = {received, received, received, received};
+        for (auto& c : consumers) benchmark::DoNotOptimize(c[n / 2]);
+    }
+    state.SetBytesProcessed(state.iterations() * n * CONSUMERS);
+}
+BENCHMARK(BM_fan_out_shared)->Arg(64)->Arg(1024)->Arg(16384);
+
+/// consumers take body (slice) and one of them modifies
+static void BM_fan_out_slice_mutate(benchmark::State& state) {
+    auto n = static_cast<size_type>(state.range(0));
+    auto frame = from_string(std::string(n, 'f'));
+    for (auto _ : state) {
+        SharedBuffer received {ByteBuffer(frame)};
+        std::array<SharedBuffer, CONSUMERS> consumers = {received.slice(2, n - 4), received.slice(2, n - 4), received, received};
+        consumers[0].mutate()[0] = 'M'; // copy on write
+        for (auto& c : consumers) benchmark::DoNotOptimize(c[0]);
+    }
+    state.SetBytesProcessed(state.iterations() * n * CONSUMERS);
+}
+BENCHMARK(BM_fan_out_slice_mutate)->Arg(64)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
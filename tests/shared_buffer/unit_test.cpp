@@ -0,0 +1,107 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for SharedBuffer
+ *
+ * @author s3mat3
+ */
+
+#include <thread>
+#include <vector>
+#include "chain_buffer.hpp"
+#include "shared_buffer.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+TEST_CASE("Created by move and shared by copy") {
+    auto b = from_string("\x02" "frame body\x03");
+    auto p = b.const_ptr();
+    SharedBuffer s(std::move(b));
+    CHECK(s.data() == p); // no copy
+    CHECK(s.size() == 12);
+    CHECK(s.use_count() == 1);
+    auto logger = s;
+    auto decoder = s;
+    CHECK(s.use_count() == 3);
+    CHECK(decoder.data() == p);
+    CHECK(decoder == "\x02" "frame body\x03");
+    CHECK(logger == decoder);
+    logger.reset();
+    CHECK(s.use_count() == 2);
+    CHECK(logger.empty());
+    CHECK(SharedBuffer().data() == nullptr);
+}
+
+TEST_CASE("Slice shares the block") {
+    auto s = SharedBuffer::copy_of("HEADpayloadCRC");
+    auto body = s.slice(4, 7);
+    CHECK(body == "payload");
+    CHECK(body.data() == s.data() + 4);
+    CHECK(body.offset() == 4);
+    CHECK(body.slice(3) == "load");
+    CHECK(body.slice(5, 100) == "ad"); // clamped
+    CHECK(body.slice(100, 1).empty());
+    CHECK(s.use_count() == 2);
+    ChainBuffer chain;
+    chain.append(body.block(), body.offset(), body.size());
+    CHECK(to_string(chain.coalesce()) == "payload");
+}
+
+TEST_CASE("mutate copies only when shared") {
+    auto s = SharedBuffer::copy_of("abcdef");
+    auto p = s.data();
+    auto w = s.mutate(); // unique, in place
+    CHECK(w.data() == p);
+    w[0] = 'A';
+    CHECK(s == "Abcdef");
+    auto other = s.slice(1, 3);
+    w = s.mutate(); // shared, copied
+    CHECK(w.data() != p);
+    w[1] = 'B';
+    CHECK(s == "ABcdef");
+    CHECK(other == "bcd");
+    CHECK(s.unique());
+    auto part = other.mutate(); // sole owner of sub view, in place
+    CHECK(part.size() == 3);
+    CHECK(part.data() == p + 1);
+}
+
+TEST_CASE("release moves out when unique") {
+    auto b = from_string("release");
+    auto p = b.const_ptr();
+    SharedBuffer s(std::move(b));
+    auto r = s.release();
+    CHECK(r.const_ptr() == p);
+    CHECK(r == "release"s);
+    CHECK(s.empty());
+    SharedBuffer t(from_string("shared"));
+    auto keep = t;
+    auto c = t.release();
+    CHECK(c == "shared"s);
+    CHECK(c.const_ptr() != keep.data());
+    CHECK(keep == "shared");
+}
+
+TEST_CASE("Fan out to threads") {
+    SharedBuffer s(from_string(std::string(4096, 'x')));
+    std::vector<std::thread> consumers;
+    std::atomic<size_type> total {0};
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back([copy = s, &total] {
+            for (int k = 0; k < 1000; ++k) {
+                auto v = copy.slice(static_cast<size_type>(k), 16);
+                total += v.size();
+            }
+        });
+    }
+    for (auto& t : consumers) t.join();
+    CHECK(total == 4 * 1000 * 16);
+    CHECK(s.unique());
+}
@@ -0,0 +1,73 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for Signal update to wakeup latency (by wait strategy)
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <atomic>
+#include <thread>
+#include "benchmark/benchmark.h"
+
+#include "signal.hpp"
+
+using namespace Sml;
+
+/// ping-pong between two threads by wait strategy, one way latency = round trip / 2
+static void BM_signal_round_trip(benchmark::State& state) {
+    WaitPolicy policy {static_cast<WaitStrategy>(state.range(0))};
+    Signal ping(policy), pong(policy);
+    std::thread echo([&] {
+        try {
+            for (;;) pong.update(ping.wait_update());
+        } catch (const canceled_wait_event&) {}
+    });
+    return_code i = 0;
+    for (auto _ : state) {
+        ping.update(++i);
+        benchmark::DoNotOptimize(pong.wait_update());
+    }
+    ping.cancel();
+    echo.join();
+    state.SetItemsProcessed(state.iterations() * 2); // wakeups
+    // which phase satisfied the waits of both sides (ratio of all waits)
+    double waits = static_cast<double>(state.iterations() * 2 + 1);
+    for (auto [name, ph] : {std::pair{"block", WaitPhase::block}, std::pair{"spin", WaitPhase::spin}
+                          , std::pair{"yield", WaitPhase::yield}, std::pair{"park", WaitPhase::park}}) {
+        state.counters[name] = static_cast<double>(ping.phase_count(ph) + pong.phase_count(ph)) / waits;
+    }
+}
+BENCHMARK(BM_signal_round_trip)
+->ArgName("strategy") // 0: block, 1: spin, 2: hybrid
+->Arg(static_cast<int>(WaitStrategy::block))
+->Arg(static_cast<int>(WaitStrategy::spin))
+->Arg(static_cast<int>(WaitStrategy::hybrid))
+->UseRealTime();
+
+/// update only (no waiter blocking)
+static void BM_signal_update(benchmark::State& state) {
+    Signal s;
+    return_code i = 0;
+    for (auto _ : state) {
+        s.update(++i);
+    }
+}
+BENCHMARK(BM_signal_update);
+
+/// update then wait on same thread (no context switch, lock cost only)
+static void BM_signal_update_wait_same_thread(benchmark::State& state) {
+    Signal s;
+    return_code i = 0;
+    for (auto _ : state) {
+        s.update(++i);
+        benchmark::DoNotOptimize(s.wait_update());
+    }
+}
+BENCHMARK(BM_signal_update_wait_same_thread);
+
+BENCHMARK_MAIN();
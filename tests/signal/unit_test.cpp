@@ -0,0 +1,95 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for Signal wait strategies
+ *
+ * @author s3mat3
+ */
+
+#include <thread>
+#include "signal.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+static constexpr WaitStrategy strategies[] = {WaitStrategy::block, WaitStrategy::spin, WaitStrategy::hybrid};
+
+TEST_CASE("Update before wait is taken by first phase") {
+    for (auto st : strategies) {
+        Signal s(WaitPolicy{st});
+        s.update(3);
+        CHECK(s.wait_update() == 3);
+        CHECK(s.last_phase() == ((st == WaitStrategy::block) ? WaitPhase::block : WaitPhase::spin));
+        CHECK(s.wait_for(5) == Sml::TIMEOUT); // consumed
+        CHECK(s.last_phase() == WaitPhase::timeout);
+        CHECK(s.phase_count(WaitPhase::timeout) == 1);
+    }
+}
+
+TEST_CASE("Update from other thread") {
+    for (auto st : strategies) {
+        Signal s(WaitPolicy{st});
+        std::thread writer([&s] {
+            for (return_code i = 1; i <= 100; ++i) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                s.update(i);
+            }
+        });
+        return_code last = 0;
+        while (last != 100) {
+            auto r = s.wait_for(1000);
+            REQUIRE(r != Sml::TIMEOUT);
+            CHECK(r > last);
+            last = r;
+        }
+        writer.join();
+        count_type total = 0;
+        for (auto ph : {WaitPhase::block, WaitPhase::spin, WaitPhase::yield, WaitPhase::park}) total += s.phase_count(ph);
+        CHECK(total > 0);
+        CHECK(s.phase_count(WaitPhase::timeout) == 0);
+    }
+}
+
+TEST_CASE("Hybrid parks after bounded spin and yield") {
+    Signal s(WaitPolicy{WaitStrategy::hybrid, 10, 2});
+    std::thread writer([&s] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        s.update(9);
+    });
+    CHECK(s.wait_update() == 9);
+    CHECK(s.last_phase() == WaitPhase::park);
+    writer.join();
+    CHECK(s.wait_for(10) == Sml::TIMEOUT);
+    CHECK(s.phase_count(WaitPhase::timeout) == 1);
+}
+
+TEST_CASE("Cancel wakes up every strategy") {
+    for (auto st : strategies) {
+        Signal s(WaitPolicy{st, 10, 2});
+        std::thread canceler([&s] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            s.cancel();
+        });
+        CHECK_THROWS_AS(s.wait_update(), canceled_wait_event);
+        canceler.join();
+        CHECK(s.wait_for(1) == Sml::TIMEOUT); // cancel consumed
+    }
+}
+
+TEST_CASE("Policy change and reset") {
+    Signal s;
+    CHECK(s.policy().m_strategy == WaitStrategy::block);
+    s.policy(WaitPolicy{WaitStrategy::spin});
+    s.update(1);
+    CHECK(s.wait_for(1) == 1);
+    CHECK(s.phase_count(WaitPhase::spin) == 1);
+    s.reset_phase_count();
+    CHECK(s.phase_count(WaitPhase::spin) == 0);
+    CHECK(s.last_phase() == WaitPhase::none);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench.cpp
+ *
+ * @copylight © 2025 s3mat3
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief bench mark for Thread start / join
+ *
+ * @warning using google benchmark
+ *
+ * @author s3mat3
+ */
+#include <atomic>
+#include "benchmark/benchmark.h"
+
+#include "thread.hpp"
+
+using namespace Sml;
+
+class Nop
+{
+public:
+    void run(void_ptr) {m_count.fetch_add(1, std::memory_order_relaxed);}
+    return_code stop() {return OK;}
+    auto count() const noexcept {return m_count.load(std::memory_order_relaxed);}
+private:
+    std::atomic<count_type> m_count {0};
+};
+
+/// Thread object create, start and join every iteration
+static void BM_thread_start_join(benchmark::State& state) {
+    auto nop = std::make_shared<Nop>();
+    auto runnable = std::make_shared<RunnableAdapter<Nop>>(nop, &Nop::run);
+    for (auto _ : state) {
+        Thread th(runnable, "bench");
+        th.start(nullptr);
+        th.join();
+    }
+    benchmark::DoNotOptimize(nop->count());
+}
+BENCHMARK(BM_thread_start_join)->UseRealTime();
+
+/// reused Thread object (start / join only)
+static void BM_thread_restart(benchmark::State& state) {
+    auto nop = std::make_shared<Nop>();
+    Thread th(std::make_shared<RunnableAdapter<Nop>>(nop, &Nop::run), "bench");
+    for (auto _ : state) {
+        th.start(nullptr);
+        th.join();
+    }
+    benchmark::DoNotOptimize(nop->count());
+}
+BENCHMARK(BM_thread_restart)->UseRealTime();
+
+/// reference: raw std::thread
+static void BM_std_thread(benchmark::State& state) {
+    Nop nop;
+    for (auto _ : state) {
+        std::thread th([&nop] {nop.run(nullptr);});
+        th.join();
+    }
+    benchmark::DoNotOptimize(nop.count());
+}
+BENCHMARK(BM_std_thread)->UseRealTime();
+
+BENCHMARK_MAIN();
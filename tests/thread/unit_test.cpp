@@ -0,0 +1,210 @@
+/**
+ * @file unit_test.cpp
+ *
+ * @copyright © 2025 s3mat3
+ *
+ * This code is licensed under the MIT License, see the LICENSE.txt file for details
+ *
+ * @brief Unit test for Thread attributes and stop request
+ *
+ * @author s3mat3
+ */
+
+#include <atomic>
+#include <thread>
+#include "signal.hpp"
+#include "thread.hpp"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+using namespace Sml;
+
+/// records attributes seen from inside run()
+class Probe
+{
+public:
+    void run(void_ptr vp)
+    {
+        m_arg = vp;
+        char buf[16] = {0};
+        ::pthread_getname_np(::pthread_self(), buf, sizeof(buf));
+        m_name = buf;
+        m_cpu = ::sched_getcpu();
+    }
+    return_code stop() {return OK;}
+    void_ptr    m_arg  {nullptr};
+    std::string m_name {};
+    int         m_cpu  {-1};
+};
+
+using adapter = RunnableAdapter<Probe>;
+
+TEST_CASE("Thread name from Base::name before run") {
+    auto probe = std::make_shared<Probe>();
+    Thread th(std::make_shared<adapter>(probe, &Probe::run), "serial-reader-long-name");
+    int arg = 0;
+    CHECK(th.start(&arg) == OK);
+    CHECK(th.applied().m_name == "serial-reader-l"); // truncated to 15
+    CHECK(th.join() == OK);
+    CHECK(probe->m_name == "serial-reader-l");
+    CHECK(probe->m_arg == &arg);
+    CHECK(th.join() == FAILURE);
+}
+
+TEST_CASE("Affinity and stack size") {
+    auto probe = std::make_shared<Probe>();
+    Thread th(std::make_shared<adapter>(probe, &Probe::run), "pinned");
+    ThreadAttributes a;
+    a.m_cpus = {0};
+    a.m_stack_size = 1024 * 1024;
+    a.m_name = "io0";
+    th.attributes(a);
+    CHECK(th.attributes().m_cpus.size() == 1);
+    REQUIRE(th.start(nullptr) == OK);
+    CHECK(th.applied().m_cpus == ThreadAttributes::cpu_list{0});
+    CHECK(th.applied().m_stack_size >= a.m_stack_size);
+    CHECK(th.applied().m_name == "io0");
+    CHECK(th.applied().m_policy == SchedPolicy::other);
+    CHECK(th.join() == OK);
+    CHECK(probe->m_cpu == 0);
+}
+
+TEST_CASE("Invalid CPU fails to start") {
+    auto probe = std::make_shared<Probe>();
+    Thread th(std::make_shared<adapter>(probe, &Probe::run), "bad");
+    ThreadAttributes a;
+    a.m_cpus = {-1};
+    th.attributes(a);
+    CHECK(th.start(nullptr) == FAIL_LUNCH);
+    CHECK_FALSE(th.started());
+}
+
+TEST_CASE("Real time policy (needs privilege)") {
+    auto probe = std::make_shared<Probe>();
+    Thread th(std::make_shared<adapter>(probe, &Probe::run), "rt");
+    ThreadAttributes a;
+    a.m_policy = SchedPolicy::fifo;
+    a.m_priority = 10;
+    th.attributes(a);
+    auto ret = th.start(nullptr);
+    if (ret == OK) {
+        CHECK(th.applied().m_policy == SchedPolicy::fifo);
+        CHECK(th.applied().m_priority == 10);
+        CHECK(th.join() == OK);
+    } else {
+        CHECK(ret == FAIL_LUNCH); // EPERM without CAP_SYS_NICE
+    }
+}
+
+TEST_CASE("NUMA preference") {
+    auto probe = std::make_shared<Probe>();
+    Thread th(std::make_shared<adapter>(probe, &Probe::run), "numa");
+    ThreadAttributes a;
+    a.m_numa_node = 0;
+    th.attributes(a);
+    REQUIRE(th.start(nullptr) == OK);
+    if (th.apply_error() == 0) {
+        CHECK(th.applied().m_numa_node == 0);
+    } else {
+        CHECK(th.applied().m_numa_node == -1); // kernel without NUMA or not permitted
+    }
+    CHECK(th.join() == OK);
+}
+
+TEST_CASE("No runnable") {
+    Thread th;
+    CHECK(th.start(nullptr) == NO_RESOURCE);
+}
+
+/// waits Signal (or sleeps) until stop requested
+class Waiter
+{
+public:
+    void wait_signal(void_ptr, std::stop_token st)
+    {
+        try {
+            m_received = m_signal.wait_update(st);
+        } catch (const canceled_wait_event&) {
+            m_canceled = true;
+        }
+    }
+    void nap(void_ptr, std::stop_token st)
+    {
+        while (Thread::sleep(1000, st)) ++m_naps;
+        m_canceled = true;
+    }
+    void legacy(void_ptr)
+    {
+        while (! m_stopped.load()) Thread::sleep(1);
+    }
+    return_code stop() {m_stopped = true; return OK;}
+    Signal            m_signal   {};
+    return_code       m_received {0};
+    std::atomic<bool> m_canceled {false};
+    std::atomic<bool> m_stopped  {false};
+    int               m_naps     {0};
+};
+
+using waiter_adapter = RunnableAdapter<Waiter>;
+
+TEST_CASE("request_stop wakes up Signal wait") {
+    auto w = std::make_shared<Waiter>();
+    Thread th(std::make_shared<waiter_adapter>(w, &Waiter::wait_signal), "sig");
+    REQUIRE(th.start(nullptr) == OK);
+    CHECK(th.join_for(20) == TIMEOUT);
+    CHECK(th.request_stop());
+    CHECK_FALSE(th.request_stop()); // already requested
+    CHECK(th.join_for(1000) == OK);
+    CHECK(w->m_canceled);
+    CHECK(w->m_stopped); // legacy stop() called too
+    CHECK(th.join_for(10) == FAILURE);
+}
+
+TEST_CASE("join_for with negative timeout waits like join") {
+    auto w = std::make_shared<Waiter>();
+    Thread th(std::make_shared<waiter_adapter>(w, &Waiter::wait_signal), "sig");
+    REQUIRE(th.start(nullptr) == OK);
+    std::thread stopper([&th] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        th.request_stop();
+    });
+    CHECK(th.join_for(-1) == OK);
+    stopper.join();
+    CHECK(w->m_canceled);
+    CHECK_FALSE(th.started());
+    CHECK(th.join_for(-1) == FAILURE);
+}
+
+TEST_CASE("Signal update has priority over stop") {
+    auto w = std::make_shared<Waiter>();
+    w->m_signal.update(7);
+    Thread th(std::make_shared<waiter_adapter>(w, &Waiter::wait_signal), "sig");
+    REQUIRE(th.start(nullptr) == OK);
+    CHECK(th.join() == OK);
+    CHECK(w->m_received == 7);
+    CHECK_FALSE(w->m_canceled);
+}
+
+TEST_CASE("Stoppable sleep and restart with new stop state") {
+    auto w = std::make_shared<Waiter>();
+    Thread th(std::make_shared<waiter_adapter>(w, &Waiter::nap), "nap");
+    for (int i = 0; i < 2; ++i) {
+        w->m_canceled = false;
+        REQUIRE(th.start(nullptr) == OK);
+        CHECK_FALSE(th.stop_requested());
+        th.request_stop();
+        CHECK(th.join_for(500) == OK); // not waiting whole 1000[ms] nap
+        CHECK(w->m_canceled);
+    }
+    CHECK(w->m_naps == 0);
+}
+
+TEST_CASE("Destructor requests stop (jthread semantics)") {
+    auto w = std::make_shared<Waiter>();
+    {
+        Thread th(std::make_shared<waiter_adapter>(w, &Waiter::legacy), "legacy");
+        REQUIRE(th.start(nullptr) == OK);
+    }
+    CHECK(w->m_stopped);
+}